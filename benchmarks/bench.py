@@ -0,0 +1,380 @@
+#!/usr/bin/env python
+#-------------------------------------------------------------------------------
+# Copyright 2018 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#-------------------------------------------------------------------------------
+"""
+Benchmarks of sorting, grouping, joining, set functions and csv reading /
+writing, on synthetic data.
+
+Usage:
+
+    python benchmarks/bench.py --nrows 10**6 --output results.json
+    python benchmarks/bench.py --set sort.nthreads=1 --filter "core/sort"
+    python benchmarks/bench.py --compare results.json
+
+Each benchmark is identified as "<suite>/<name>[<stype>]". The suite "core"
+times the C++ algorithms directly (see "c/zbench.cc"), while the other suites
+time the corresponding python-level operations. The "core" suite is only
+available when datatable was built with the environment variable DTBENCH=1,
+otherwise it is skipped. Every benchmark is run
+`--nreps` times, and the minimum and median of the timings are reported.
+
+The results, together with the description of the environment and the values
+of all `sort.*` options, are written as JSON into the `--output` file. Use
+`--set` to tune the options, and `--compare` to check the results against an
+earlier run: the script exits with code 1 if any benchmark became slower by
+more than `--threshold` times.
+
+By default the option `sort.cache_size` is set to 0, so that the repeated
+runs do not hit the frame's cache of sort results.
+"""
+import argparse
+import ast
+import json
+import os
+import platform
+import random
+import re
+import statistics
+import sys
+import tempfile
+import time
+import datatable as dt
+from datatable import f, by, join, sort
+from datatable.lib import core
+
+STYPES = ["bool", "int8", "int16", "int32", "int64", "float32", "float64",
+          "str32", "str64"]
+INT_STYPES = ["int32", "int64"]
+
+
+
+#-------------------------------------------------------------------------------
+# Synthetic data
+#-------------------------------------------------------------------------------
+
+def random_values(stype, nrows, ncard, seed):
+    """
+    List of `nrows` random values for a column of type `stype`, drawn from
+    `ncard` distinct values, with approximately 1% of NAs. This is the same
+    distribution as the data used by the "core" suite.
+    """
+    rnd = random.Random(seed)
+    if stype == "bool":
+        ncard = 2
+    elif stype == "int8":
+        ncard = min(ncard, 127)
+    elif stype == "int16":
+        ncard = min(ncard, 32767)
+    if stype in ("float32", "float64"):
+        make = lambda x: x / ncard
+    elif stype in ("str32", "str64"):
+        make = lambda x: "id-%d" % x
+    elif stype == "bool":
+        make = bool
+    else:
+        make = int
+    return [make(rnd.randrange(ncard)) if rnd.randrange(100) else None
+            for _ in range(nrows)]
+
+
+def make_frame(nrows, ncard, seed, **stypes):
+    """
+    Frame with columns of the given types (passed as `name=stype`).
+    """
+    return dt.Frame([random_values(st, nrows, ncard, seed + i)
+                     for i, st in enumerate(stypes.values())],
+                    names=list(stypes.keys()),
+                    stypes=list(stypes.values()))
+
+
+
+#-------------------------------------------------------------------------------
+# Suites
+#-------------------------------------------------------------------------------
+# Each suite is a generator function `(nrows, ncard, seed)` that yields tuples
+# `(name, stype, measure)`, where `measure(nreps)` returns the list of timings
+# of `nreps` runs of the benchmark. Most benchmarks are created with
+# `timed(prepare)`, where `prepare()` creates the data (not timed) and returns
+# the function to be timed.
+
+def timed(prepare):
+    def measure(nreps):
+        try:
+            fn = prepare()
+            times = []
+            for _ in range(nreps):
+                t0 = time.perf_counter()
+                fn()
+                times.append(time.perf_counter() - t0)
+            return times
+        finally:
+            while _tempfiles:
+                os.remove(_tempfiles.pop())
+    return measure
+
+
+def suite_core(nrows, ncard, seed):
+    if not hasattr(core, "benchmark_internal"):
+        return
+    for name, _ in core.benchmark_internal():
+        stypes = INT_STYPES if name == "join" else STYPES
+        for st in stypes:
+            def measure(nreps, name=name, st=st):
+                return core.benchmark_internal(name, st, nrows, ncard,
+                                               nreps, seed)
+            yield (name, st, measure)
+
+
+def suite_sort(nrows, ncard, seed):
+    for st in STYPES:
+        def prepare(st=st):
+            DT = make_frame(nrows, ncard, seed, A=st)
+            return lambda: DT[:, :, sort(f.A)].materialize()
+        yield ("sort", st, timed(prepare))
+
+    def prepare2():
+        DT = make_frame(nrows, ncard, seed, A="int32", B="str32")
+        return lambda: DT[:, :, sort(f.A, f.B)].materialize()
+    yield ("sort2", "int32,str32", timed(prepare2))
+
+
+def suite_groupby(nrows, ncard, seed):
+    for st in STYPES:
+        def prepare(st=st):
+            DT = make_frame(nrows, ncard, seed, G=st, V="float64")
+            return lambda: DT[:, [dt.count(), dt.sum(f.V), dt.mean(f.V),
+                                  dt.sd(f.V), dt.min(f.V), dt.max(f.V)],
+                              by(f.G)]
+        yield ("reducers", st, timed(prepare))
+
+
+def suite_join(nrows, ncard, seed):
+    for st in INT_STYPES + ["str32"]:
+        def prepare(st=st):
+            X = make_frame(nrows, ncard, seed, A=st)
+            rnd = random.Random(seed)
+            keys = list(range(ncard))
+            rnd.shuffle(keys)
+            if st == "str32":
+                keys = ["id-%d" % k for k in keys]
+            J = dt.Frame(A=keys, B=list(range(ncard)), stypes=[st, "int32"])
+            J.key = "A"
+            def run():
+                # The join index is cached in the frame, so each run must use
+                # a fresh copy of J.
+                return X[:, :, join(J.copy())]
+            return run
+        yield ("natural_join", st, timed(prepare))
+
+
+def suite_set(nrows, ncard, seed):
+    for st in STYPES:
+        def prepare_unique(st=st):
+            DT = make_frame(nrows, ncard, seed, A=st)
+            return lambda: dt.unique(DT)
+        yield ("unique", st, timed(prepare_unique))
+
+        for fn in (dt.union, dt.intersect, dt.setdiff):
+            def prepare(st=st, fn=fn):
+                DT1 = make_frame(nrows, ncard, seed, A=st)
+                DT2 = make_frame(nrows, ncard, seed + 100, A=st)
+                return lambda: fn(DT1, DT2)
+            yield (fn.__name__, st, timed(prepare))
+
+
+def suite_io(nrows, ncard, seed):
+    for st in STYPES:
+        def prepare_write(st=st):
+            DT = make_frame(nrows, ncard, seed, A=st, B="float64")
+            path = _tempfile()
+            return lambda: DT.to_csv(path)
+        yield ("to_csv", st, timed(prepare_write))
+
+        def prepare_read(st=st):
+            DT = make_frame(nrows, ncard, seed, A=st, B="float64")
+            path = _tempfile()
+            DT.to_csv(path)
+            return lambda: dt.fread(path)
+        yield ("fread", st, timed(prepare_read))
+
+
+_tempfiles = []
+
+def _tempfile():
+    fd, path = tempfile.mkstemp(suffix=".csv")
+    os.close(fd)
+    _tempfiles.append(path)
+    return path
+
+
+SUITES = {
+    "core": suite_core,
+    "sort": suite_sort,
+    "groupby": suite_groupby,
+    "join": suite_join,
+    "set": suite_set,
+    "io": suite_io,
+}
+
+
+
+#-------------------------------------------------------------------------------
+# Driver
+#-------------------------------------------------------------------------------
+
+def run_benchmarks(nrows_list, ncard=None, nreps=3, seed=0, pattern=None,
+                   suites=None, verbose=True):
+    """
+    Run all benchmarks whose full name matches the regular expression
+    `pattern`, and return the list of result records.
+    """
+    rx = re.compile(pattern or "")
+    records = []
+    for suite in (suites or SUITES):
+        fn = SUITES[suite]
+        for nrows in nrows_list:
+            card = ncard or nrows
+            for name, stype, measure in fn(nrows, card, seed):
+                fullname = "%s/%s[%s]" % (suite, name, stype)
+                if not rx.search(fullname):
+                    continue
+                times = measure(nreps)
+                rec = {"suite": suite, "name": name, "stype": stype,
+                       "nrows": nrows, "ncard": card, "times": times,
+                       "min": min(times),
+                       "median": statistics.median(times)}
+                records.append(rec)
+                if verbose:
+                    print("%-32s nrows=%-9d %10.6f s" % (fullname, nrows,
+                                                        rec["min"]))
+    return records
+
+
+def environment():
+    return {
+        "datatable": dt.__version__,
+        "git_revision": dt.__git_revision__,
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "cpu_count": os.cpu_count(),
+        "time": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+    }
+
+
+def all_options():
+    opts = dt.options.sort.get()
+    opts.update(dt.options.groupby.get())
+    return opts
+
+
+def compare(records, base_records, threshold):
+    """
+    Compare the results with the earlier ones, and return the list of
+    benchmarks that became slower by more than `threshold` times.
+    """
+    key = lambda r: (r["suite"], r["name"], r["stype"], r["nrows"], r["ncard"])
+    base = {key(r): r for r in base_records}
+    regressions = []
+    for rec in records:
+        old = base.get(key(rec))
+        if old is None or old["min"] <= 0:
+            continue
+        ratio = rec["min"] / old["min"]
+        if ratio > threshold:
+            regressions.append((rec, old, ratio))
+    return regressions
+
+
+def _set_option(s):
+    name, _, value = s.partition("=")
+    try:
+        value = ast.literal_eval(value)
+    except (ValueError, SyntaxError):
+        pass
+    group, _, name = name.strip().rpartition(".")
+    setattr(dt.options.get(group), name, value)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Benchmarks of sorting, grouping and joining in datatable")
+    parser.add_argument("--nrows", nargs="+", default=["10**5", "10**6"],
+                        help="Number of rows in the synthetic data (may be "
+                             "given several times, python expressions "
+                             "such as 10**6 are allowed)")
+    parser.add_argument("--ncard", default=None,
+                        help="Number of distinct values in the data "
+                             "(default: same as nrows)")
+    parser.add_argument("--nreps", type=int, default=3,
+                        help="Number of times each benchmark is run")
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--suite", nargs="+", choices=sorted(SUITES),
+                        help="Run only the given suites")
+    parser.add_argument("--filter", default=None,
+                        help="Run only the benchmarks whose full name "
+                             "matches this regular expression")
+    parser.add_argument("--set", action="append", default=[],
+                        metavar="OPTION=VALUE",
+                        help="Set datatable option before running the "
+                             "benchmarks, for example sort.nthreads=4")
+    parser.add_argument("--output", help="Write the results into this file")
+    parser.add_argument("--compare", metavar="BASE",
+                        help="Compare the results with those in the file BASE")
+    parser.add_argument("--threshold", type=float, default=1.1,
+                        help="Slowdown ratio that is reported as a "
+                             "regression (default 1.1)")
+    parser.add_argument("--quiet", action="store_true")
+    args = parser.parse_args(argv)
+
+    nrows_list = [int(eval(n, {})) for n in args.nrows]
+    ncard = int(eval(args.ncard, {})) if args.ncard else None
+    dt.options.sort.cache_size = 0
+    for opt in args.set:
+        _set_option(opt)
+
+    records = run_benchmarks(nrows_list, ncard=ncard, nreps=args.nreps,
+                             seed=args.seed, pattern=args.filter,
+                             suites=args.suite, verbose=not args.quiet)
+    result = {"environment": environment(),
+              "options": all_options(),
+              "benchmarks": records}
+    if args.output:
+        with open(args.output, "w") as out:
+            json.dump(result, out, indent=2)
+
+    if args.compare:
+        with open(args.compare) as inp:
+            base = json.load(inp)
+        regressions = compare(records, base["benchmarks"], args.threshold)
+        for rec, old, ratio in regressions:
+            print("REGRESSION %s/%s[%s] nrows=%d: %.6f s -> %.6f s (x%.2f)"
+                  % (rec["suite"], rec["name"], rec["stype"], rec["nrows"],
+                     old["min"], rec["min"], ratio))
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -179,6 +179,7 @@ RowIndex Column::remove_rowindex() {
 void Column::replace_rowindex(const RowIndex& newri) {
   ri = newri;
   nrows = ri.size();
+  if (stats) stats->reset();
 }
 
 
@@ -161,6 +161,15 @@ public:
 
   RowIndex sort(Groupby* out_groups) const;
 
+  /**
+   * Check whether the values in the column are already sorted, and return
+   * the corresponding `SORTED_*` flags (see "stats.h"). This is a single
+   * parallel pass over the data, which stops as soon as the column is found
+   * to be unsorted. Use `get_stats()->sortedness(col)` to get the cached
+   * value instead.
+   */
+  uint8_t compute_sortedness() const;
+
   /**
    * Resize the column up to `nrows` elements, and fill all new elements with
    * NA values, except when the Column initially had just one row, in which case
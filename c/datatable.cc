@@ -21,7 +21,7 @@
 //------------------------------------------------------------------------------
 
 DataTable::DataTable()
-  : nrows(0), ncols(0), nkeys(0)
+  : nrows(0), ncols(0), join_nlookups(0), nkeys(0)
 {
   TRACK(this, sizeof(*this), "DataTable");
 }
@@ -90,6 +90,8 @@ DataTable* DataTable::copy() const {
   }
   DataTable* res = new DataTable(std::move(newcols), this);
   res->nkeys = nkeys;
+  res->join_index = join_index;
+  res->sort_cache = sort_cache;
   return res;
 }
 
@@ -97,6 +99,7 @@ DataTable* DataTable::copy() const {
 
 void DataTable::delete_columns(std::vector<size_t>& cols_to_remove) {
   if (cols_to_remove.empty()) return;
+  reset_indices();
   std::sort(cols_to_remove.begin(), cols_to_remove.end());
 
   size_t next_col_to_remove = cols_to_remove[0];
@@ -127,6 +130,7 @@ void DataTable::delete_columns(std::vector<size_t>& cols_to_remove) {
 
 
 void DataTable::delete_all() {
+  reset_indices();
   for (size_t i = 0; i < ncols; ++i) {
     delete columns[i];
   }
@@ -164,6 +168,7 @@ std::vector<RowColIndex> DataTable::split_columns_by_rowindices() const {
 
 void DataTable::resize_rows(size_t new_nrows) {
   if (new_nrows == nrows) return;
+  reset_indices();
 
   // Split all columns into groups, by their `RowIndex`es
   std::vector<RowIndex> rowindices;
@@ -196,6 +201,7 @@ void DataTable::resize_rows(size_t new_nrows) {
 
 
 void DataTable::replace_rowindex(const RowIndex& newri) {
+  reset_indices();
   nrows = newri.size();
   for (size_t i = 0; i < ncols; ++i) {
     columns[i]->replace_rowindex(newri);
@@ -226,6 +232,7 @@ void DataTable::apply_rowindex(const RowIndex& ri) {
   // If RowIndex is empty, no need to do anything. Also, the expression
   // `ri.size()` cannot be computed.
   if (!ri) return;
+  reset_indices();
 
   auto rc = split_columns_by_rowindices();
   for (auto& rcitem : rc) {
@@ -238,9 +245,20 @@ void DataTable::apply_rowindex(const RowIndex& ri) {
 }
 
 
+/**
+ * Discard the cached join index and sort results. This must be called
+ * whenever the data in the frame is modified.
+ */
+void DataTable::reset_indices() {
+  join_index = nullptr;
+  join_nlookups = 0;
+  sort_cache = nullptr;
+}
+
+
 void DataTable::replace_groupby(const Groupby& newgb) {
-  int32_t last_offset = newgb.offsets_r()[newgb.ngroups()];
-  if (static_cast<size_t>(last_offset) != nrows) {
+  size_t last_offset = newgb.last_offset();
+  if (last_offset != nrows) {
     throw ValueError() << "Cannot apply Groupby of " << last_offset << " rows "
       "to a Frame with " << nrows << " rows";
   }
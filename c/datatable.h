@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #ifndef dt_DATATABLE_h
 #define dt_DATATABLE_h
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
 #include "python/_all.h"
@@ -34,6 +36,49 @@ struct sort_spec {
     : col_index(i), descending(desc), na_last(nalast), sort_only(sort) {}
 };
 
+/**
+ * Index over the join columns `cols` of a frame, which can be cached within
+ * the DataTable so that it is reused by subsequent joins into the same frame
+ * and by the lookups `Frame.lookup()`. The cached index is discarded
+ * whenever the frame is modified (see `DataTable::reset_indices()`).
+ * Concrete index classes are implemented in "frame/join.cc".
+ */
+class JoinIndex {
+  public:
+    std::vector<size_t> cols;
+
+    virtual ~JoinIndex();
+    virtual size_t memory_footprint() const = 0;
+};
+
+/**
+ * Results of `DataTable::group()` for the recently used sort specs, cached
+ * within the DataTable so that repeated sorts and groupbys by the same
+ * columns are not recomputed. The total size of the cached RowIndices and
+ * Groupbys is limited by the option `sort.cache_size`, and the least recently
+ * used entries are evicted first. Same as the join index, the cache is
+ * discarded whenever the frame is modified. Implemented in "sort.cc".
+ */
+class SortCache {
+  private:
+    struct entry {
+      std::vector<sort_spec> spec;
+      RowIndex rowindex;
+      Groupby groupby;
+      size_t size;
+    };
+    std::vector<entry> entries;  // the most recently used entry is the last
+    size_t total_size;
+
+  public:
+    SortCache();
+    bool find(const std::vector<sort_spec>& spec,
+              std::pair<RowIndex, Groupby>* out);
+    void add(const std::vector<sort_spec>& spec,
+             const std::pair<RowIndex, Groupby>& res);
+    size_t memory_footprint() const;
+};
+
 struct RowColIndex {
   RowIndex rowindex;
   std::vector<size_t> colindices;
@@ -76,6 +121,15 @@ using colptr  = std::unique_ptr<Column>;
  * columns
  *     The array of columns within the datatable. This array contains `ncols`
  *     elements, and each column has the same number of rows: `nrows`.
+ *
+ * join_index
+ *     Index over the join columns of this frame, built by a join into this
+ *     frame and reused by subsequent joins.
+ *
+ * sort_cache
+ *     Results of the recent sorts/groupbys of this frame. Any method that
+ *     modifies the data in the frame must call `reset_indices()`, which
+ *     discards both this cache and the join index.
  */
 class DataTable {
   public:
@@ -84,6 +138,12 @@ class DataTable {
     Groupby  groupby;
     colvec   columns;
 
+    // Join index cached by `natural_join()`, and the number of lookups that
+    // were made into this frame without such index.
+    mutable std::shared_ptr<JoinIndex> join_index;
+    mutable size_t join_nlookups;
+    mutable std::shared_ptr<SortCache> sort_cache;
+
   private:
     size_t   nkeys;
     strvec   names;
@@ -104,6 +164,7 @@ class DataTable {
     void replace_rowindex(const RowIndex& newri);
     void apply_rowindex(const RowIndex&);
     void replace_groupby(const Groupby& newgb);
+    void reset_indices();
     void reify();
     void rbind(const std::vector<DataTable*>&, const std::vector<intvec>&);
     void cbind(const std::vector<DataTable*>&);
@@ -117,6 +178,22 @@ class DataTable {
     std::pair<RowIndex, Groupby>
     group(const std::vector<sort_spec>& spec, bool as_view = false) const;
 
+    /**
+     * Same as `group()`, but uses a hash table to find the groups, and sorts
+     * only the first row of each group. This is faster when the number of
+     * groups is small. Not supported with `as_view` or `sort_only`.
+     */
+    std::pair<RowIndex, Groupby>
+    group_hashed(const std::vector<sort_spec>& spec) const;
+
+    /**
+     * Return the RowIndex of the first `k` rows of the DataTable sorted by
+     * the columns `spec`. This is the same as the first `k` elements of the
+     * RowIndex returned by `group()`, but only the rows that may end up among
+     * the first `k` are actually sorted.
+     */
+    RowIndex sort_topk(const std::vector<sort_spec>& spec, size_t k) const;
+
     // Names
     const strvec& get_names() const;
     py::otuple get_pynames() const;
@@ -185,7 +262,59 @@ DataTable* open_jay_from_mbuf(const MemoryRange&);
 
 DataTable* apply_rowindex(const DataTable*, const RowIndex& ri);
 
-RowIndex natural_join(const DataTable* xdt, const DataTable* jdt);
+enum class JoinType : uint8_t {
+  LEFT,   // all rows of X, with matching rows of J (or NAs)
+  INNER,  // only the rows of X that have a match in J
+  RIGHT,  // all rows of J, with matching rows of X (or NAs)
+  OUTER   // all rows of both X and J
+};
+
+enum class AsofType : uint8_t {
+  NONE,      // regular join: only exact matches
+  BACKWARD,  // match the last row of J whose key is not greater than X's
+  FORWARD,   // match the first row of J whose key is not less than X's
+  NEAREST    // match whichever of the above is closer to the X's key
+};
+
+/**
+ * Join frame `jdt` to `xdt`, returning the pair of rowindices (xri, jri) for
+ * the X and J frames respectively. The row `i` of the result is composed of
+ * the row `xri[i]` of X and the row `jri[i]` of J, either of which may be NA.
+ * If `mult_all` is true, then each row in X is paired with all matching rows
+ * in J; otherwise only with the first one. In a left join that takes only
+ * the first match, the rows of X are unchanged and `xri` is empty.
+ *
+ * If `asof` is given, then the last key column of `jdt` is matched to X
+ * inexactly, in the direction specified, and only if the distance between
+ * the keys does not exceed `tolerance`.
+ */
+std::pair<RowIndex, RowIndex>
+natural_join(const DataTable* xdt, const DataTable* jdt,
+             JoinType how = JoinType::LEFT, bool mult_all = false,
+             AsofType asof = AsofType::NONE,
+             double tolerance = std::numeric_limits<double>::infinity());
+
+/**
+ * Find the row in the keyed frame `dt` whose key is equal to the values in
+ * the single-row frame `keydt`, or return `RowIndex::NA` if there is no such
+ * row. This uses (and caches) the hash index over the key columns of `dt`.
+ */
+size_t lookup_row(const DataTable* keydt, const DataTable* dt);
+
+/**
+ * For each row of `dt` find the first row that has the same values in the
+ * columns `cols`, using a parallel hash table. Thus, `heads[i] <= i` for all
+ * rows, and `heads[i] == i` only for the first row of each distinct value.
+ * The frame must have no more than INT32_MAX rows.
+ */
+arr32_t hash_row_heads(const DataTable* dt, const intvec& cols);
+
+/**
+ * Find the columns on which `jdt` is joined to `xdt` (the indices of these
+ * columns in each frame are appended to `xcols` and `jcols`).
+ */
+void find_join_columns(const DataTable* xdt, const DataTable* jdt,
+                       intvec& xcols, intvec& jcols);
 
 
 //==============================================================================
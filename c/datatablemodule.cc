@@ -259,6 +259,9 @@ void py::DatatableModule::init_methods() {
   init_methods_repeat();
   init_methods_sets();
   init_methods_str();
+  #ifdef DTBENCH
+    init_benchmarks();
+  #endif
   #ifdef DTTEST
     init_tests();
   #endif
@@ -44,6 +44,9 @@ class DatatableModule : public ExtModule<DatatableModule> {
     void init_methods_sets();      // set_funcs.cc
     void init_methods_str();       // str/py_str.cc
 
+    #ifdef DTBENCH
+      void init_benchmarks();      // zbench.cc
+    #endif
     #ifdef DTTEST
       void init_tests();
     #endif
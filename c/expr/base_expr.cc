@@ -19,11 +19,14 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <cstring>            // std::memcmp
 #include <memory>             // std::unique_ptr
 #include <stdlib.h>
 #include "datatable.h"
 #include "datatablemodule.h"
 #include "expr/base_expr.h"
+#include "expr/cse.h"
+#include "expr/fused.h"
 #include "expr/py_expr.h"
 #include "expr/workframe.h"
 
@@ -53,6 +56,19 @@ pexpr base_expr::get_negated_expr() { return pexpr(); }
 
 size_t base_expr::get_col_index(const workframe&) { return size_t(-1); }
 
+Column* base_expr::evaluate(workframe& wf) {
+  cse_table* cse = wf.get_cse();
+  return cse? cse->evaluate(this) : evaluate_eager(wf);
+}
+
+size_t base_expr::compile_fused(fused_program&, workframe&) {
+  return fused_program::NONE;
+}
+
+size_t base_expr::compile_filter(filter_program& prog, workframe& wf) {
+  return prog.add_leaf(this, wf);
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -121,6 +137,10 @@ Column* expr_column::evaluate_eager(workframe& wf) {
   const RowIndex& col_ri = rcol->rowindex();
 
   if (dt_ri) {
+    if (frame_id == 0) {
+      Column* res = wf.coalesce_join_column(col_id);
+      if (res) return res;
+    }
     return rcol->shallowcopy(wf._product(dt_ri, col_ri));
   }
   else {
@@ -129,6 +149,18 @@ Column* expr_column::evaluate_eager(workframe& wf) {
 }
 
 
+size_t expr_column::hash(cse_table&, const workframe& wf) {
+  size_t h = hash_combine(exprCode::COL, frame_id);
+  return hash_combine(h, get_col_index(wf));
+}
+
+
+bool expr_column::equals(const base_expr& other, const cse_table&) const {
+  auto o = dynamic_cast<const expr_column*>(&other);
+  return o && o->frame_id == frame_id && o->col_id == col_id;
+}
+
+
 
 //------------------------------------------------------------------------------
 // expr_binaryop
@@ -228,6 +260,10 @@ class expr_binaryop : public base_expr {
     SType resolve(const workframe& wf) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe& wf) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
+    size_t compile_fused(fused_program&, workframe&) override;
+    size_t compile_filter(filter_program&, workframe&) override;
 };
 
 
@@ -256,12 +292,62 @@ GroupbyMode expr_binaryop::get_groupby_mode(const workframe& wf) const {
 
 
 Column* expr_binaryop::evaluate_eager(workframe& wf) {
-  Column* lhs_res = lhs->evaluate_eager(wf);
-  Column* rhs_res = rhs->evaluate_eager(wf);
+  Column* res = evaluate_fused(this, wf);
+  if (res) return res;
+  Column* lhs_res = lhs->evaluate(wf);
+  Column* rhs_res = rhs->evaluate(wf);
   return expr::binaryop(binop_code, lhs_res, rhs_res);
 }
 
 
+size_t expr_binaryop::hash(cse_table& cse, const workframe&) {
+  size_t h = hash_combine(exprCode::BINOP, binop_code);
+  h = hash_combine(h, cse.add(lhs));
+  return hash_combine(h, cse.add(rhs));
+}
+
+
+bool expr_binaryop::equals(const base_expr& other,
+                           const cse_table& cse) const
+{
+  auto o = dynamic_cast<const expr_binaryop*>(&other);
+  return o && o->binop_code == binop_code &&
+         cse.same(lhs, o->lhs) && cse.same(rhs, o->rhs);
+}
+
+
+size_t expr_binaryop::compile_fused(fused_program& prog, workframe& wf) {
+  // Check the stypes first, so that the operands are not evaluated when the
+  // operator cannot be fused anyways.
+  if (!fused_program::supports(lhs->resolve(wf)) ||
+      !fused_program::supports(rhs->resolve(wf))) {
+    return fused_program::NONE;
+  }
+  size_t lhs_reg = prog.compile(lhs, wf);
+  size_t rhs_reg = prog.compile(rhs, wf);
+  return prog.add_binaryop(binop_code, lhs_reg, rhs_reg);
+}
+
+
+size_t expr_binaryop::compile_filter(filter_program& prog, workframe& wf) {
+  auto op = static_cast<biop>(binop_code);
+  if ((op != biop::LOGICAL_AND && op != biop::LOGICAL_OR) ||
+      lhs->resolve(wf) != SType::BOOL || rhs->resolve(wf) != SType::BOOL) {
+    return prog.add_leaf(this, wf);
+  }
+  if (op == biop::LOGICAL_AND) {
+    size_t lhs_node = lhs->compile_filter(prog, wf);
+    if (lhs_node == filter_program::NONE) return filter_program::NONE;
+    return prog.add_and(lhs_node, rhs->compile_filter(prog, wf));
+  } else {
+    // The operands of `|` are evaluated as a whole
+    size_t lhs_node = prog.add_leaf(lhs, wf);
+    if (lhs_node == filter_program::NONE) return filter_program::NONE;
+    return prog.add_or(lhs_node, prog.add_leaf(rhs, wf));
+  }
+}
+
+
 
 //------------------------------------------------------------------------------
 // expr_literal
@@ -270,6 +356,7 @@ Column* expr_binaryop::evaluate_eager(workframe& wf) {
 class expr_literal : public base_expr {
   private:
     Column* col;
+    py::oobj value;
 
   public:
     explicit expr_literal(const py::robj&);
@@ -277,10 +364,12 @@ class expr_literal : public base_expr {
     SType resolve(const workframe&) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe&) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
 };
 
 
-expr_literal::expr_literal(const py::robj& v) {
+expr_literal::expr_literal(const py::robj& v) : value(v) {
   py::olist lst(1);
   lst.set(0, v);
   col = Column::from_pylist(lst, 0);
@@ -306,6 +395,29 @@ Column* expr_literal::evaluate_eager(workframe&) {
 }
 
 
+// Numeric literals are compared by their bytes, so that `0.0` and `-0.0`
+// are different literals, but NaN is equal to itself.
+size_t expr_literal::hash(cse_table&, const workframe&) {
+  size_t h = hash_combine(exprCode::LITERAL,
+                          static_cast<size_t>(col->stype()));
+  if (value.is_string()) {
+    std::string s = value.to_string();
+    return hash_combine(h, hash_murmur2(s.data(), s.size(), 0));
+  }
+  return hash_combine(h, hash_murmur2(col->data(), col->elemsize(), 0));
+}
+
+
+bool expr_literal::equals(const base_expr& other, const cse_table&) const {
+  auto o = dynamic_cast<const expr_literal*>(&other);
+  if (!o || o->col->stype() != col->stype()) return false;
+  if (value.is_string()) {
+    return o->value.to_string() == value.to_string();
+  }
+  return std::memcmp(o->col->data(), col->data(), col->elemsize()) == 0;
+}
+
+
 
 //------------------------------------------------------------------------------
 // expr_unaryop
@@ -386,6 +498,9 @@ class expr_unaryop : public base_expr {
     SType resolve(const workframe& wf) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe& wf) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
+    size_t compile_fused(fused_program&, workframe&) override;
 };
 
 
@@ -424,11 +539,35 @@ GroupbyMode expr_unaryop::get_groupby_mode(const workframe& wf) const {
 
 
 Column* expr_unaryop::evaluate_eager(workframe& wf) {
-  Column* arg_res = arg->evaluate_eager(wf);
+  Column* res = evaluate_fused(this, wf);
+  if (res) return res;
+  Column* arg_res = arg->evaluate(wf);
   return expr::unaryop(unop_code, arg_res);
 }
 
 
+size_t expr_unaryop::hash(cse_table& cse, const workframe&) {
+  size_t h = hash_combine(exprCode::UNOP, static_cast<size_t>(unop_code));
+  return hash_combine(h, cse.add(arg.get()));
+}
+
+
+bool expr_unaryop::equals(const base_expr& other, const cse_table& cse) const {
+  auto o = dynamic_cast<const expr_unaryop*>(&other);
+  return o && o->unop_code == unop_code && cse.same(arg.get(), o->arg.get());
+}
+
+
+size_t expr_unaryop::compile_fused(fused_program& prog, workframe& wf) {
+  if (!fused_program::supports(arg->resolve(wf))) {
+    return fused_program::NONE;
+  }
+  size_t arg_reg = prog.compile(arg.get(), wf);
+  if (unop_code == unop::PLUS) return arg_reg;
+  return prog.add_unaryop(unop_code, arg_reg);
+}
+
+
 
 
 //------------------------------------------------------------------------------
@@ -446,6 +585,9 @@ class expr_cast : public base_expr {
     SType resolve(const workframe& wf) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe& wf) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
+    size_t compile_fused(fused_program&, workframe&) override;
 };
 
 
@@ -465,12 +607,36 @@ GroupbyMode expr_cast::get_groupby_mode(const workframe& wf) const {
 
 
 Column* expr_cast::evaluate_eager(workframe& wf) {
-  Column* arg_col = arg->evaluate_eager(wf);
+  Column* res = evaluate_fused(this, wf);
+  if (res) return res;
+  Column* arg_col = arg->evaluate(wf);
   arg_col->reify();
   return arg_col->cast(stype);
 }
 
 
+size_t expr_cast::hash(cse_table& cse, const workframe&) {
+  size_t h = hash_combine(exprCode::CAST, static_cast<size_t>(stype));
+  return hash_combine(h, cse.add(arg));
+}
+
+
+bool expr_cast::equals(const base_expr& other, const cse_table& cse) const {
+  auto o = dynamic_cast<const expr_cast*>(&other);
+  return o && o->stype == stype && cse.same(arg, o->arg);
+}
+
+
+size_t expr_cast::compile_fused(fused_program& prog, workframe& wf) {
+  if (!fused_program::supports(arg->resolve(wf)) ||
+      !fused_program::supports(stype)) {
+    return fused_program::NONE;
+  }
+  size_t arg_reg = prog.compile(arg, wf);
+  return prog.add_cast(stype, arg_reg);
+}
+
+
 
 //------------------------------------------------------------------------------
 // expr_reduce
@@ -483,9 +649,13 @@ class expr_reduce : public base_expr {
 
   public:
     expr_reduce(base_expr* a, size_t op);
+    friend std::vector<Column*> evaluate_fused_reducers(std::vector<pexpr>&,
+                                                        workframe&);
     SType resolve(const workframe& wf) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe& wf) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
 };
 
 
@@ -505,14 +675,99 @@ GroupbyMode expr_reduce::get_groupby_mode(const workframe&) const {
 
 
 Column* expr_reduce::evaluate_eager(workframe& wf) {
-  Column* arg_col = arg->evaluate_eager(wf);
+  // The reduction of an entire column can be found in the `reduce_cache`
+  const Column* src = nullptr;
+  auto colexpr = dynamic_cast<expr_column*>(arg);
+  if (colexpr && colexpr->get_frame_id() == 0 && !wf.has_groupby() &&
+      !wf.get_rowindex(0))
+  {
+    src = wf.get_datatable(0)->columns[colexpr->get_col_index(wf)];
+    if (src->rowindex()) src = nullptr;
+  }
+  if (src) {
+    Column* res = reduce_cache::lookup(opcode, src);
+    if (res) return res;
+  }
+
+  Column* arg_col = arg->evaluate(wf);
   int op = static_cast<int>(opcode);
+  Column* res = nullptr;
   if (wf.has_groupby()) {
     const Groupby& grby = wf.get_groupby();
-    return expr::reduceop(op, arg_col, grby);
+    res = expr::reduceop(op, arg_col, grby);
   } else {
-    return expr::reduceop(op, arg_col, Groupby::single_group(wf.nrows()));
+    res = expr::reduceop(op, arg_col, Groupby::single_group(wf.nrows()));
   }
+  if (src) reduce_cache::store(opcode, src, res);
+  return res;
+}
+
+
+size_t expr_reduce::hash(cse_table& cse, const workframe&) {
+  size_t h = hash_combine(exprCode::UNREDUCE, opcode);
+  return hash_combine(h, cse.add(arg));
+}
+
+
+bool expr_reduce::equals(const base_expr& other, const cse_table& cse) const {
+  auto o = dynamic_cast<const expr_reduce*>(&other);
+  return o && o->opcode == opcode && cse.same(arg, o->arg);
+}
+
+
+
+/**
+ * Find all reducers in `exprs` that are applied directly to a column, and
+ * for every column with more than one such reducer compute all of them
+ * together, in a single pass over the data. The results are returned in the
+ * vector of the same size as `exprs`, and the elements corresponding to the
+ * expressions that were not evaluated here are nullptr.
+ */
+std::vector<Column*> evaluate_fused_reducers(std::vector<pexpr>& exprs,
+                                             workframe& wf)
+{
+  size_t n = exprs.size();
+  std::vector<Column*> res(n, nullptr);
+  std::vector<bool> done(n, false);
+  for (size_t i = 0; i < n; ++i) {
+    if (done[i]) continue;
+    auto ri = dynamic_cast<expr_reduce*>(exprs[i].get());
+    if (!ri) continue;
+    auto ci = dynamic_cast<expr_column*>(ri->arg);
+    if (!ci) continue;
+    size_t frame = ci->get_frame_id();
+    size_t col = ci->get_col_index(wf);
+    SType stype = wf.get_datatable(frame)->columns[col]->stype();
+    int op = static_cast<int>(ri->opcode);
+    if (!expr::can_reduce_together(op, stype)) continue;
+
+    std::vector<size_t> indices {i};
+    std::vector<int> opcodes {op};
+    for (size_t j = i + 1; j < n; ++j) {
+      auto rj = dynamic_cast<expr_reduce*>(exprs[j].get());
+      if (!rj) continue;
+      auto cj = dynamic_cast<expr_column*>(rj->arg);
+      if (!cj || cj->get_frame_id() != frame || cj->get_col_index(wf) != col) {
+        continue;
+      }
+      int opj = static_cast<int>(rj->opcode);
+      if (!expr::can_reduce_together(opj, stype)) continue;
+      indices.push_back(j);
+      opcodes.push_back(opj);
+    }
+    if (indices.size() == 1) continue;
+
+    colptr arg_col(ci->evaluate_eager(wf));
+    std::vector<Column*> cols = expr::reduceops(
+        opcodes, arg_col.get(),
+        wf.has_groupby()? wf.get_groupby()
+                        : Groupby::single_group(wf.nrows()));
+    for (size_t k = 0; k < indices.size(); ++k) {
+      res[indices[k]] = cols[k];
+      done[indices[k]] = true;
+    }
+  }
+  return res;
 }
 
 
@@ -530,6 +785,8 @@ class expr_reduce_nullary : public base_expr {
     SType resolve(const workframe& wf) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe& wf) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
 };
 
 
@@ -552,11 +809,20 @@ Column* expr_reduce_nullary::evaluate_eager(workframe& wf) {
     if (wf.has_groupby()) {
       const Groupby& grpby = wf.get_groupby();
       size_t ng = grpby.ngroups();
-      const int32_t* offsets = grpby.offsets_r();
-      res = Column::new_data_column(SType::INT32, ng);
-      auto d_res = static_cast<int32_t*>(res->data_w());
-      for (size_t i = 0; i < ng; ++i) {
-        d_res[i] = offsets[i + 1] - offsets[i];
+      if (grpby.is64()) {
+        const int64_t* offsets = grpby.offsets64_r();
+        res = Column::new_data_column(SType::INT64, ng);
+        auto d_res = static_cast<int64_t*>(res->data_w());
+        for (size_t i = 0; i < ng; ++i) {
+          d_res[i] = offsets[i + 1] - offsets[i];
+        }
+      } else {
+        const int32_t* offsets = grpby.offsets_r();
+        res = Column::new_data_column(SType::INT32, ng);
+        auto d_res = static_cast<int32_t*>(res->data_w());
+        for (size_t i = 0; i < ng; ++i) {
+          d_res[i] = offsets[i + 1] - offsets[i];
+        }
       }
     } else {
       res = Column::new_data_column(SType::INT64, 1);
@@ -568,6 +834,19 @@ Column* expr_reduce_nullary::evaluate_eager(workframe& wf) {
 }
 
 
+size_t expr_reduce_nullary::hash(cse_table&, const workframe&) {
+  return hash_combine(exprCode::NUREDUCE, opcode);
+}
+
+
+bool expr_reduce_nullary::equals(const base_expr& other,
+                                 const cse_table&) const
+{
+  auto o = dynamic_cast<const expr_reduce_nullary*>(&other);
+  return o && o->opcode == opcode;
+}
+
+
 
 };
 //------------------------------------------------------------------------------
@@ -76,6 +76,9 @@ enum class strop : size_t {
 };
 
 class base_expr;
+class cse_table;
+class fused_program;
+class filter_program;
 using pexpr = std::unique_ptr<base_expr>;
 
 
@@ -91,6 +94,30 @@ class base_expr {
     virtual GroupbyMode get_groupby_mode(const workframe&) const = 0;
     virtual Column* evaluate_eager(workframe&) = 0;
 
+    // Structural hash of the expression, and its comparison with another
+    // expression, used for finding the common subexpressions (see
+    // "expr/cse.h"). The method `hash()` adds the operands into the table
+    // via `cse_table::add()`, and combines their hashes; `equals()` may then
+    // compare the operands with `cse_table::same()`.
+    virtual size_t hash(cse_table&, const workframe&) = 0;
+    virtual bool equals(const base_expr&, const cse_table&) const = 0;
+
+    // Evaluate the expression. If it occurs more than once in the list of
+    // expressions being evaluated, its result is computed only once.
+    Column* evaluate(workframe&);
+
+    // Add this expression into the program for the chunked evaluation (see
+    // "expr/fused.h"), and return the index of its register. The default
+    // implementation returns `fused_program::NONE`, meaning that the
+    // expression is evaluated eagerly, and its result becomes an input of
+    // the program.
+    virtual size_t compile_fused(fused_program&, workframe&);
+
+    // Add this boolean expression into the program for evaluating a filter
+    // (see "expr/fused.h"), and return the index of its node. By default
+    // the entire expression becomes a leaf of the filter.
+    virtual size_t compile_filter(filter_program&, workframe&);
+
     virtual bool is_column_expr() const;
     virtual bool is_negated_expr() const;
     virtual pexpr get_negated_expr();
@@ -113,10 +140,14 @@ class expr_column : public base_expr {
     SType resolve(const workframe&) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe&) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
 };
 
 
 base_expr* expr_string_fn(size_t op, base_expr* arg, py::oobj params);
+std::vector<Column*> evaluate_fused_reducers(std::vector<pexpr>& exprs,
+                                             workframe& wf);
 
 
 
@@ -42,6 +42,7 @@
 #include <type_traits>         // std::is_integral
 #include "types.h"
 #include "utils/exceptions.h"
+#include "utils/simd.h"
 
 
 namespace expr
@@ -78,46 +79,112 @@ enum OpMode {
 
 
 //------------------------------------------------------------------------------
-// Final mapper functions
+// Elementwise loops
 //------------------------------------------------------------------------------
 
+// The loops below apply operator `OP` to contiguous arrays of values. The
+// operators are written without branches (NA checks are selects), so that
+// these loops can be vectorized. Each loop is compiled twice: for the baseline
+// instruction set, and for AVX2 (see "utils/simd.h"). The mapper functions
+// take a template parameter `AVX2` telling which of the two to call, and
+// the right mapper is chosen by `resolve2()` / `resolve_block2()`.
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+static DT_KERNEL void loop_n_to_n(size_t n, const LT* x, const RT* y, VT* out)
+{
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = OP(x[i], y[i]);
+  }
+}
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+static DT_KERNEL void loop_n_to_1(size_t n, const LT* x, const RT* y, VT* out)
+{
+  RT yvalue = y[0];
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = OP(x[i], yvalue);
+  }
+}
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+static DT_KERNEL void loop_1_to_n(size_t n, const LT* x, const RT* y, VT* out)
+{
+  LT xvalue = x[0];
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = OP(xvalue, y[i]);
+  }
+}
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+DT_TARGET_AVX2 static void loop_n_to_n_avx2(size_t n, const LT* x,
+                                            const RT* y, VT* out) {
+  loop_n_to_n<LT, RT, VT, OP>(n, x, y, out);
+}
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+DT_TARGET_AVX2 static void loop_n_to_1_avx2(size_t n, const LT* x,
+                                            const RT* y, VT* out) {
+  loop_n_to_1<LT, RT, VT, OP>(n, x, y, out);
+}
+
 template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+DT_TARGET_AVX2 static void loop_1_to_n_avx2(size_t n, const LT* x,
+                                            const RT* y, VT* out) {
+  loop_1_to_n<LT, RT, VT, OP>(n, x, y, out);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Final mapper functions
+//------------------------------------------------------------------------------
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT), bool AVX2>
 static void map_n_to_n(int64_t row0, int64_t row1, void** params) {
   Column* col0 = static_cast<Column*>(params[0]);
   Column* col1 = static_cast<Column*>(params[1]);
   Column* col2 = static_cast<Column*>(params[2]);
-  const LT* lhs_data = static_cast<const LT*>(col0->data());
-  const RT* rhs_data = static_cast<const RT*>(col1->data());
-  VT* res_data = static_cast<VT*>(col2->data_w());
-  for (int64_t i = row0; i < row1; ++i) {
-    res_data[i] = OP(lhs_data[i], rhs_data[i]);
-  }
+  const LT* lhs_data = static_cast<const LT*>(col0->data()) + row0;
+  const RT* rhs_data = static_cast<const RT*>(col1->data()) + row0;
+  VT* res_data = static_cast<VT*>(col2->data_w()) + row0;
+  size_t n = static_cast<size_t>(row1 - row0);
+  if (AVX2) loop_n_to_n_avx2<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
+  else      loop_n_to_n<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
 }
 
-template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT), bool AVX2>
 static void map_n_to_1(int64_t row0, int64_t row1, void** params) {
   Column* col0 = static_cast<Column*>(params[0]);
   Column* col1 = static_cast<Column*>(params[1]);
   Column* col2 = static_cast<Column*>(params[2]);
-  const LT* lhs_data = static_cast<const LT*>(col0->data());
-  RT rhs_value = static_cast<const RT*>(col1->data())[0];
-  VT* res_data = static_cast<VT*>(col2->data_w());
-  for (int64_t i = row0; i < row1; ++i) {
-    res_data[i] = OP(lhs_data[i], rhs_value);
-  }
+  const LT* lhs_data = static_cast<const LT*>(col0->data()) + row0;
+  const RT* rhs_data = static_cast<const RT*>(col1->data());
+  VT* res_data = static_cast<VT*>(col2->data_w()) + row0;
+  size_t n = static_cast<size_t>(row1 - row0);
+  if (AVX2) loop_n_to_1_avx2<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
+  else      loop_n_to_1<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
 }
 
-template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT), bool AVX2>
 static void map_1_to_n(int64_t row0, int64_t row1, void** params) {
   Column* col0 = static_cast<Column*>(params[0]);
   Column* col1 = static_cast<Column*>(params[1]);
   Column* col2 = static_cast<Column*>(params[2]);
-  LT lhs_value = static_cast<const LT*>(col0->data())[0];
-  const RT* rhs_data = static_cast<const RT*>(col1->data());
-  VT* res_data = static_cast<VT*>(col2->data_w());
-  for (int64_t i = row0; i < row1; ++i) {
-    res_data[i] = OP(lhs_value, rhs_data[i]);
-  }
+  const LT* lhs_data = static_cast<const LT*>(col0->data());
+  const RT* rhs_data = static_cast<const RT*>(col1->data()) + row0;
+  VT* res_data = static_cast<VT*>(col2->data_w()) + row0;
+  size_t n = static_cast<size_t>(row1 - row0);
+  if (AVX2) loop_1_to_n_avx2<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
+  else      loop_1_to_n<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
+}
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT), bool AVX2>
+static void block_n_to_n(size_t n, const void* x, const void* y, void* out) {
+  const LT* lhs_data = static_cast<const LT*>(x);
+  const RT* rhs_data = static_cast<const RT*>(y);
+  VT* res_data = static_cast<VT*>(out);
+  if (AVX2) loop_n_to_n_avx2<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
+  else      loop_n_to_n<LT, RT, VT, OP>(n, lhs_data, rhs_data, res_data);
 }
 
 
@@ -174,28 +241,42 @@ static void strmap_n_to_1(int64_t row0, int64_t row1, void** params) {
 // Arithmetic operators
 //------------------------------------------------------------------------------
 
+// The result is computed for all values, including NAs, and then replaced
+// with NA where needed. Computing both and selecting one (instead of
+// branching on the NA check) is what allows the loops to be vectorized.
+
 template<typename LT, typename RT, typename VT>
 inline static VT op_add(LT x, RT y) {
-  return IsIntNA<LT>(x) || IsIntNA<RT>(y)? GETNA<VT>() : static_cast<VT>(x) + static_cast<VT>(y);
+  VT res = static_cast<VT>(x) + static_cast<VT>(y);
+  return (IsIntNA<LT>(x) | IsIntNA<RT>(y))? GETNA<VT>() : res;
 }
 
 template<typename LT, typename RT, typename VT>
 inline static VT op_sub(LT x, RT y) {
-  return IsIntNA<LT>(x) || IsIntNA<RT>(y)? GETNA<VT>() : static_cast<VT>(x) - static_cast<VT>(y);
+  VT res = static_cast<VT>(x) - static_cast<VT>(y);
+  return (IsIntNA<LT>(x) | IsIntNA<RT>(y))? GETNA<VT>() : res;
 }
 
 template<typename LT, typename RT, typename VT>
 inline static VT op_mul(LT x, RT y) {
-  return IsIntNA<LT>(x) || IsIntNA<RT>(y)? GETNA<VT>() : static_cast<VT>(x) * static_cast<VT>(y);
+  VT res = static_cast<VT>(x) * static_cast<VT>(y);
+  return (IsIntNA<LT>(x) | IsIntNA<RT>(y))? GETNA<VT>() : res;
 }
 
+// Integer division cannot be computed for `y == 0`, and is not vectorizable
+// anyways, so only the floating-point division is branchless.
 template<typename LT, typename RT, typename VT>
 inline static VT op_div(LT x, RT y) {
-  if (IsIntNA<LT>(x) || IsIntNA<RT>(y) || y == 0) return GETNA<VT>();
   VT vx = static_cast<VT>(x);
   VT vy = static_cast<VT>(y);
+  bool isna = IsIntNA<LT>(x) | IsIntNA<RT>(y) | (y == 0);
+  if (!std::is_integral<VT>::value) {
+    VT res = vx / vy;
+    return isna? GETNA<VT>() : res;
+  }
+  if (isna) return GETNA<VT>();
   VT res = vx / vy;
-  if (std::is_integral<VT>::value && (vx < 0) != (vy < 0) && vx != res * vy) {
+  if ((vx < 0) != (vy < 0) && vx != res * vy) {
     --res;
   }
   return res;
@@ -236,46 +317,46 @@ template<typename LT, typename RT, typename VT>
 inline static int8_t op_eq(LT x, RT y) {  // x == y
   bool x_isna = ISNA<LT>(x);
   bool y_isna = ISNA<RT>(y);
-  return (!x_isna && !y_isna && static_cast<VT>(x) == static_cast<VT>(y)) ||
-         (x_isna && y_isna);
+  return (!x_isna & !y_isna & (static_cast<VT>(x) == static_cast<VT>(y))) |
+         (x_isna & y_isna);
 }
 
 template<typename LT, typename RT, typename VT>
 inline static int8_t op_ne(LT x, RT y) {  // x != y
   bool x_isna = ISNA<LT>(x);
   bool y_isna = ISNA<RT>(y);
-  return (x_isna || y_isna || static_cast<VT>(x) != static_cast<VT>(y)) &&
-         !(x_isna && y_isna);
+  return (x_isna | y_isna | (static_cast<VT>(x) != static_cast<VT>(y))) &
+         !(x_isna & y_isna);
 }
 
 template<typename LT, typename RT, typename VT>
 inline static int8_t op_gt(LT x, RT y) {  // x > y
   bool x_isna = ISNA<LT>(x);
   bool y_isna = ISNA<RT>(y);
-  return (!x_isna && !y_isna && static_cast<VT>(x) > static_cast<VT>(y));
+  return !x_isna & !y_isna & (static_cast<VT>(x) > static_cast<VT>(y));
 }
 
 template<typename LT, typename RT, typename VT>
 inline static int8_t op_lt(LT x, RT y) {  // x < y
   bool x_isna = ISNA<LT>(x);
   bool y_isna = ISNA<RT>(y);
-  return (!x_isna && !y_isna && static_cast<VT>(x) < static_cast<VT>(y));
+  return !x_isna & !y_isna & (static_cast<VT>(x) < static_cast<VT>(y));
 }
 
 template<typename LT, typename RT, typename VT>
 inline static int8_t op_ge(LT x, RT y) {  // x >= y
   bool x_isna = ISNA<LT>(x);
   bool y_isna = ISNA<RT>(y);
-  return (!x_isna && !y_isna && static_cast<VT>(x) >= static_cast<VT>(y)) ||
-         (x_isna && y_isna);
+  return (!x_isna & !y_isna & (static_cast<VT>(x) >= static_cast<VT>(y))) |
+         (x_isna & y_isna);
 }
 
 template<typename LT, typename RT, typename VT>
 inline static int8_t op_le(LT x, RT y) {  // x <= y
   bool x_isna = ISNA<LT>(x);
   bool y_isna = ISNA<RT>(y);
-  return (!x_isna && !y_isna && static_cast<VT>(x) <= static_cast<VT>(y)) ||
-         (x_isna && y_isna);
+  return (!x_isna & !y_isna & (static_cast<VT>(x) <= static_cast<VT>(y))) |
+         (x_isna & y_isna);
 }
 
 template<typename T1, typename T2>
@@ -327,13 +408,13 @@ inline static int8_t strop_ne(T1 start1, T1 end1, const char* strdata1,
 inline static int8_t op_and(int8_t x, int8_t y) {
   bool x_isna = ISNA<int8_t>(x);
   bool y_isna = ISNA<int8_t>(y);
-  return (x_isna || y_isna) ? GETNA<int8_t>() : (x && y);
+  return (x_isna | y_isna) ? GETNA<int8_t>() : (x & y);
 }
 
 inline static int8_t op_or(int8_t x, int8_t y) {
   bool x_isna = ISNA<int8_t>(x);
   bool y_isna = ISNA<int8_t>(y);
-  return (x_isna || y_isna) ? GETNA<int8_t>() : (x || y);
+  return (x_isna | y_isna) ? GETNA<int8_t>() : (x | y);
 }
 
 
@@ -344,10 +425,18 @@ inline static int8_t op_or(int8_t x, int8_t y) {
 
 template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
 static mapperfn resolve2(OpMode mode) {
+  if (cpu_has_avx2()) {
+    switch (mode) {
+      case N_to_N:   return map_n_to_n<LT, RT, VT, OP, true>;
+      case N_to_One: return map_n_to_1<LT, RT, VT, OP, true>;
+      case One_to_N: return map_1_to_n<LT, RT, VT, OP, true>;
+      default:       return nullptr;
+    }
+  }
   switch (mode) {
-    case N_to_N:   return map_n_to_n<LT, RT, VT, OP>;
-    case N_to_One: return map_n_to_1<LT, RT, VT, OP>;
-    case One_to_N: return map_1_to_n<LT, RT, VT, OP>;
+    case N_to_N:   return map_n_to_n<LT, RT, VT, OP, false>;
+    case N_to_One: return map_n_to_1<LT, RT, VT, OP, false>;
+    case One_to_N: return map_1_to_n<LT, RT, VT, OP, false>;
     default:       return nullptr;
   }
 }
@@ -527,6 +616,103 @@ static mapperfn resolve0(SType lhs_type, SType rhs_type, size_t opcode, void** p
 }
 
 
+//------------------------------------------------------------------------------
+// Kernels for the chunked evaluation
+//------------------------------------------------------------------------------
+
+// Type in which the operation on values of types LT and RT is computed: the
+// larger of the two types, except that floating-point types take precedence
+// over the integer ones. This is the same as in `resolve0()` above.
+template<typename LT, typename RT>
+using common_t = typename std::conditional<
+    std::is_floating_point<LT>::value == std::is_floating_point<RT>::value
+      ? sizeof(LT) >= sizeof(RT)
+      : std::is_floating_point<LT>::value,
+    LT, RT>::type;
+
+template<typename T> static SType stype_of();
+template<> SType stype_of<int8_t>()  { return SType::INT8; }
+template<> SType stype_of<int16_t>() { return SType::INT16; }
+template<> SType stype_of<int32_t>() { return SType::INT32; }
+template<> SType stype_of<int64_t>() { return SType::INT64; }
+template<> SType stype_of<float>()   { return SType::FLOAT32; }
+template<> SType stype_of<double>()  { return SType::FLOAT64; }
+
+
+template<typename LT, typename RT, typename VT, VT (*OP)(LT, RT)>
+static blockfn resolve_block2() {
+  return cpu_has_avx2()? block_n_to_n<LT, RT, VT, OP, true>
+                       : block_n_to_n<LT, RT, VT, OP, false>;
+}
+
+
+template<typename LT, typename RT>
+static blockfn resolve_block1(size_t opcode, SType* res_type) {
+  using VT = common_t<LT, RT>;
+  *res_type = opcode >= OpCode::Equal? SType::BOOL : stype_of<VT>();
+  switch (opcode) {
+    case OpCode::Plus:      return resolve_block2<LT, RT, VT, op_add<LT, RT, VT>>();
+    case OpCode::Minus:     return resolve_block2<LT, RT, VT, op_sub<LT, RT, VT>>();
+    case OpCode::Multiply:  return resolve_block2<LT, RT, VT, op_mul<LT, RT, VT>>();
+    case OpCode::IntDivide: return resolve_block2<LT, RT, VT, op_div<LT, RT, VT>>();
+    case OpCode::Modulo:    return resolve_block2<LT, RT, VT, Mod<LT, RT, VT>::impl>();
+    case OpCode::Divide:
+      if (std::is_integral<VT>::value) {
+        *res_type = SType::FLOAT64;
+        return resolve_block2<LT, RT, double, op_div<LT, RT, double>>();
+      }
+      return resolve_block2<LT, RT, VT, op_div<LT, RT, VT>>();
+
+    case OpCode::Equal:          return resolve_block2<LT, RT, int8_t, op_eq<LT, RT, VT>>();
+    case OpCode::NotEqual:       return resolve_block2<LT, RT, int8_t, op_ne<LT, RT, VT>>();
+    case OpCode::Greater:        return resolve_block2<LT, RT, int8_t, op_gt<LT, RT, VT>>();
+    case OpCode::Less:           return resolve_block2<LT, RT, int8_t, op_lt<LT, RT, VT>>();
+    case OpCode::GreaterOrEqual: return resolve_block2<LT, RT, int8_t, op_ge<LT, RT, VT>>();
+    case OpCode::LessOrEqual:    return resolve_block2<LT, RT, int8_t, op_le<LT, RT, VT>>();
+  }
+  return nullptr;
+}
+
+
+template<typename LT>
+static blockfn resolve_block0(size_t opcode, SType rhs_type, SType* res_type) {
+  switch (rhs_type) {
+    case SType::BOOL:
+    case SType::INT8:    return resolve_block1<LT, int8_t>(opcode, res_type);
+    case SType::INT16:   return resolve_block1<LT, int16_t>(opcode, res_type);
+    case SType::INT32:   return resolve_block1<LT, int32_t>(opcode, res_type);
+    case SType::INT64:   return resolve_block1<LT, int64_t>(opcode, res_type);
+    case SType::FLOAT32: return resolve_block1<LT, float>(opcode, res_type);
+    case SType::FLOAT64: return resolve_block1<LT, double>(opcode, res_type);
+    default:             return nullptr;
+  }
+}
+
+
+blockfn binaryop_block(size_t opcode, SType lhs_type, SType rhs_type,
+                       SType* res_type)
+{
+  switch (lhs_type) {
+    case SType::BOOL:
+      if (rhs_type == SType::BOOL && (opcode == OpCode::LogicalAnd ||
+                                      opcode == OpCode::LogicalOr)) {
+        *res_type = SType::BOOL;
+        if (opcode == OpCode::LogicalAnd) return resolve_block2<int8_t, int8_t, int8_t, op_and>();
+        if (opcode == OpCode::LogicalOr)  return resolve_block2<int8_t, int8_t, int8_t, op_or>();
+      }
+      [[clang::fallthrough]];
+    case SType::INT8:    return resolve_block0<int8_t>(opcode, rhs_type, res_type);
+    case SType::INT16:   return resolve_block0<int16_t>(opcode, rhs_type, res_type);
+    case SType::INT32:   return resolve_block0<int32_t>(opcode, rhs_type, res_type);
+    case SType::INT64:   return resolve_block0<int64_t>(opcode, rhs_type, res_type);
+    case SType::FLOAT32: return resolve_block0<float>(opcode, rhs_type, res_type);
+    case SType::FLOAT64: return resolve_block0<double>(opcode, rhs_type, res_type);
+    default:             return nullptr;
+  }
+}
+
+
+
 //------------------------------------------------------------------------------
 // Exported binaryop function
 //------------------------------------------------------------------------------
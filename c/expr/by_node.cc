@@ -24,6 +24,7 @@
 #include "expr/collist.h"
 #include "expr/py_expr.h"
 #include "expr/workframe.h"
+#include "options.h"
 #include "python/arg.h"
 #include "python/tuple.h"
 #include "utils/exceptions.h"
@@ -136,7 +137,7 @@ void by_node::create_columns(workframe& wf) {
   DataTable* dt0 = wf.get_datatable(0);
   RowIndex ri0 = wf.get_rowindex(0);
   if (wf.get_groupby_mode() == GroupbyMode::GtoONE) {
-    ri0 = RowIndex(arr32_t(wf.gb.ngroups(), wf.gb.offsets_r()), true) * ri0;
+    ri0 = wf.gb.first_rows_rowindex() * ri0;
   }
 
   auto dt0_names = dt0->get_names();
@@ -151,6 +152,66 @@ void by_node::create_columns(workframe& wf) {
 }
 
 
+/**
+ * Estimate whether the number of groups is small compared to the number of
+ * rows, so that it is cheaper to find the groups via a hash table and then
+ * sort only one row from each group, than to sort all rows.
+ *
+ * If the `nunique` stats of all group columns are already computed, their
+ * product is an upper bound on the number of groups. Otherwise, the groups
+ * are counted in a small evenly-spaced sample of rows.
+ */
+static bool _few_groups(const DataTable* dt, const intvec& cols) {
+  constexpr size_t SAMPLE_SIZE = 8192;
+  size_t nrows = dt->nrows;
+  double ngroups = 1.0;
+  for (size_t i : cols) {
+    const Column* col = dt->columns[i];
+    Stats* stats = col->get_stats_if_exist();
+    if (col->stype() == SType::BOOL) ngroups *= 3;
+    else if (stats && stats->is_computed(Stat::NUnique)) {
+      ngroups *= static_cast<double>(stats->nunique(col) + 1);
+    }
+    else { ngroups = -1; break; }
+  }
+  if (ngroups >= 0) return ngroups * 4 <= static_cast<double>(nrows);
+  if (nrows < SAMPLE_SIZE * 8) return false;
+
+  dtptr sample(dt->copy());
+  sample->apply_rowindex(RowIndex(0, SAMPLE_SIZE, nrows / SAMPLE_SIZE));
+  arr32_t heads = hash_row_heads(sample.get(), cols);
+  size_t nsample_groups = 0;
+  for (size_t i = 0; i < SAMPLE_SIZE; ++i) {
+    nsample_groups += (static_cast<size_t>(heads[i]) == i);
+  }
+  return nsample_groups * 4 <= SAMPLE_SIZE;
+}
+
+
+/**
+ * Choose the grouping algorithm according to the option `groupby.method`.
+ * The hash grouping cannot be used when there are sort-only columns, or
+ * columns of type `obj`.
+ */
+static bool _use_hash_grouping(const DataTable* dt,
+                               const std::vector<sort_spec>& spec)
+{
+  if (config::groupby_method == "sort") return false;
+  intvec cols;
+  for (auto& s : spec) {
+    if (s.sort_only) return false;
+    if (dt->columns[s.col_index]->stype() == SType::OBJ) return false;
+    cols.push_back(s.col_index);
+  }
+  if (config::groupby_method == "hash") return true;
+  return _few_groups(dt, cols);
+}
+
+
+// The partial sort is used when the number of rows needed is at most
+// `1/TOPK_RATIO` of the total.
+static constexpr size_t TOPK_RATIO = 16;
+
 void by_node::execute(workframe& wf) const {
   if (cols.empty()) return;
   const DataTable* dt0 = wf.get_datatable(0);
@@ -172,8 +233,18 @@ void by_node::execute(workframe& wf) const {
       spec.emplace_back(col.index, col.descending, false, true);
     }
   }
+  // When the frame is only sorted, and the i filter selects among the first
+  // few rows only, then it is sufficient to find these first rows.
+  if (n_group_columns == 0) {
+    size_t limit = wf.iexpr->rows_limit();
+    if (limit <= dt0->nrows / TOPK_RATIO) {
+      wf.apply_rowindex(dt0->sort_topk(spec, limit));
+      return;
+    }
+  }
   // if (n_group_columns) {
-    auto res = dt0->group(spec);
+    auto res = _use_hash_grouping(dt0, spec)? dt0->group_hashed(spec)
+                                             : dt0->group(spec);
     wf.gb = std::move(res.second);
     wf.apply_rowindex(res.first);
   // } else {
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <list>
+#include "expr/cse.h"
+#include "expr/workframe.h"
+#include "options.h"
+namespace dt {
+
+
+
+//------------------------------------------------------------------------------
+// cse_table
+//------------------------------------------------------------------------------
+
+constexpr size_t cse_table::NONE;
+
+
+cse_table::cse_table(std::vector<pexpr>& exprs, workframe& wf_) : wf(wf_) {
+  for (auto& expr : exprs) {
+    add(expr.get());
+  }
+  xassert(!wf.cse);
+  wf.cse = this;
+}
+
+cse_table::~cse_table() {
+  wf.cse = nullptr;
+}
+
+
+size_t cse_table::add(base_expr* expr) {
+  auto it = ids.find(expr);
+  if (it != ids.end()) return entries[it->second].hash;
+
+  size_t hash = expr->hash(*this, wf);
+  size_t id = NONE;
+  auto range = index.equal_range(hash);
+  for (auto jt = range.first; jt != range.second; ++jt) {
+    if (expr->equals(*entries[jt->second].expr, *this)) {
+      id = jt->second;
+      break;
+    }
+  }
+  if (id == NONE) {
+    id = entries.size();
+    entries.push_back(entry {hash, 0, expr, colptr()});
+    index.emplace(hash, id);
+  }
+  entries[id].count++;
+  ids[expr] = id;
+  return hash;
+}
+
+
+size_t cse_table::get_id(const base_expr* expr) const {
+  auto it = ids.find(expr);
+  return it == ids.end()? NONE : it->second;
+}
+
+
+bool cse_table::same(const base_expr* a, const base_expr* b) const {
+  size_t id = get_id(a);
+  return id != NONE && id == get_id(b);
+}
+
+
+bool cse_table::is_shared(const base_expr* expr) const {
+  size_t id = get_id(expr);
+  return id != NONE && entries[id].count > 1;
+}
+
+
+bool cse_table::has_result(const base_expr* expr) const {
+  size_t id = get_id(expr);
+  return id != NONE && entries[id].result;
+}
+
+
+Column* cse_table::evaluate(base_expr* expr) {
+  // Columns are cheap to evaluate, so there is no need to keep them
+  if (!is_shared(expr) || expr->is_column_expr()) {
+    return expr->evaluate_eager(wf);
+  }
+  entry& e = entries[get_id(expr)];
+  if (!e.result) {
+    e.result = colptr(expr->evaluate_eager(wf));
+  }
+  return e.result->shallowcopy();
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// reduce_cache
+//------------------------------------------------------------------------------
+
+namespace reduce_cache {
+
+struct item {
+  size_t opcode;
+  const void* data;
+  size_t nrows;
+  SType stype;
+  size_t : 56;
+  colptr column;  // holds a reference to the `data` buffer
+  colptr result;
+};
+
+// The most recently used items are at the front. The list is never
+// destroyed, so that the columns are not deleted during the interpreter
+// shutdown.
+static std::list<item>& items() {
+  static auto list = new std::list<item>;
+  return *list;
+}
+
+
+Column* lookup(size_t opcode, const Column* col) {
+  if (!config::expr_cache_size) return nullptr;
+  std::list<item>& lst = items();
+  for (auto it = lst.begin(); it != lst.end(); ++it) {
+    if (it->opcode == opcode && it->data == col->data() &&
+        it->nrows == col->nrows && it->stype == col->stype()) {
+      lst.splice(lst.begin(), lst, it);
+      return it->result->shallowcopy();
+    }
+  }
+  return nullptr;
+}
+
+
+void store(size_t opcode, const Column* col, const Column* res) {
+  if (!config::expr_cache_size) return;
+  items().push_front(item {opcode, col->data(), col->nrows, col->stype(),
+                           colptr(col->shallowcopy()),
+                           colptr(res->shallowcopy())});
+  trim();
+}
+
+
+void trim() {
+  std::list<item>& lst = items();
+  while (lst.size() > config::expr_cache_size) {
+    lst.pop_back();
+  }
+}
+
+}  // namespace reduce_cache
+
+
+
+}  // namespace dt
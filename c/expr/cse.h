@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_EXPR_CSE_h
+#define dt_EXPR_CSE_h
+#include <unordered_map>
+#include <vector>
+#include "expr/base_expr.h"
+#include "models/murmurhash.h"  // hash_murmur2
+namespace dt {
+
+
+// Mix `value` into the hash `seed`, using the finalization step of the
+// Murmur3 hash
+inline size_t hash_combine(size_t seed, size_t value) {
+  uint64_t k = seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) +
+                       (seed >> 2));
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+
+
+/**
+ * Table of the common subexpressions in a list of expressions that are
+ * evaluated together, such as the items of `j` in `DT[i, j, by]`.
+ *
+ * Every subtree of the expressions is hashed structurally, and the subtrees
+ * that are equal receive the same entry in the table. The subtrees are added
+ * bottom-up, so that `base_expr::equals()` only needs to compare the node
+ * itself, and check that the operands have the same entries (`same()`).
+ *
+ * When an expression that occurs more than once is evaluated with
+ * `base_expr::evaluate()`, its result is computed the first time only and
+ * kept in the table; other occurrences receive a shallow copy of it. Fused
+ * programs use the entries in order to compile each distinct subtree only
+ * once, and `evaluate_fused_columns()` evaluates identical items of the
+ * list only once.
+ *
+ * While the table exists, it is attached to the workframe, see
+ * `workframe::get_cse()`.
+ */
+class cse_table {
+  private:
+    struct entry {
+      size_t hash;
+      size_t count;
+      base_expr* expr;  // the first occurrence
+      colptr result;
+    };
+    workframe& wf;
+    std::vector<entry> entries;
+    std::unordered_multimap<size_t, size_t> index;   // hash -> entry
+    std::unordered_map<const base_expr*, size_t> ids;  // node -> entry
+
+  public:
+    static constexpr size_t NONE = size_t(-1);
+
+    cse_table(std::vector<pexpr>& exprs, workframe& wf);
+    cse_table(const cse_table&) = delete;
+    ~cse_table();
+
+    /**
+     * Add `expr` and all its subexpressions into the table, and return the
+     * structural hash of `expr`.
+     */
+    size_t add(base_expr* expr);
+
+    /**
+     * Index of the entry of `expr`, or NONE if the expression is not in the
+     * table.
+     */
+    size_t get_id(const base_expr* expr) const;
+
+    bool same(const base_expr* a, const base_expr* b) const;
+    bool is_shared(const base_expr* expr) const;
+    bool has_result(const base_expr* expr) const;
+
+    /**
+     * Evaluate `expr`, or return a copy of its result computed earlier.
+     */
+    Column* evaluate(base_expr* expr);
+};
+
+
+
+/**
+ * Bounded cache of the results of reducers applied directly to a column,
+ * such as `mean(f.A)`, which is kept across the `DT[i, j, by]` calls. The
+ * number of results kept is given by option `expr.cache_size`, with the
+ * least recently used results evicted first.
+ *
+ * A result is keyed on the reducer, and on the identity of the buffer with
+ * the column's data. The cache holds a reference to this buffer, so that the
+ * buffer can only be modified via copy-on-write: any modification of the
+ * column moves its data into a new buffer, and thus invalidates the key.
+ * Only the reductions over all rows of a column without a RowIndex, and
+ * without a groupby, are cached.
+ */
+namespace reduce_cache {
+  Column* lookup(size_t opcode, const Column* col);
+  void store(size_t opcode, const Column* col, const Column* res);
+  void trim();
+}
+
+
+
+}  // namespace dt
+#endif
@@ -0,0 +1,669 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>          // std::min
+#include <cstring>            // std::memcpy
+#include <memory>             // std::unique_ptr
+#include "expr/cse.h"
+#include "expr/fused.h"
+#include "expr/workframe.h"
+#include "options.h"
+#include "utils/parallel.h"
+namespace dt {
+
+// Buffers of the registers are aligned at this boundary, so that they do not
+// share cache lines.
+static constexpr size_t ALIGN = 64;
+
+constexpr size_t fused_program::NONE;
+
+
+
+//------------------------------------------------------------------------------
+// Compile
+//------------------------------------------------------------------------------
+
+fused_program::fused_program()
+  : bcast0(nullptr), out(NONE), nrows(0), chunk(0) {}
+
+
+bool fused_program::supports(SType stype) {
+  switch (stype) {
+    case SType::BOOL:
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:
+    case SType::FLOAT32:
+    case SType::FLOAT64: return true;
+    default:             return false;
+  }
+}
+
+
+size_t fused_program::compile(base_expr* expr, workframe& wf) {
+  const cse_table* cse = wf.get_cse();
+  size_t id = cse? cse->get_id(expr) : NONE;
+  if (id != NONE) {
+    auto it = cse_regs.find(id);
+    if (it != cse_regs.end()) return it->second;
+  }
+  // A common subexpression that was already evaluated becomes an input
+  size_t nregs = regs.size();
+  size_t i = (cse && cse->has_result(expr))? NONE
+                                            : expr->compile_fused(*this, wf);
+  if (i == NONE) {
+    // Discard the registers added by the failed attempt
+    regs.resize(nregs);
+    if (inputs.size() > nregs) inputs.resize(nregs);
+    for (auto it = cse_regs.begin(); it != cse_regs.end(); ) {
+      if (it->second >= nregs) it = cse_regs.erase(it);
+      else ++it;
+    }
+    i = add_input(expr->evaluate(wf));
+  }
+  if (id != NONE && i != NONE) cse_regs[id] = i;
+  return i;
+}
+
+
+size_t fused_program::add_input(Column* col) {
+  size_t i = _add_reg(nullptr, col->stype(), col->nrows, NONE, NONE);
+  inputs.resize(regs.size());
+  inputs[i] = colptr(col);
+  return supports(col->stype())? i : NONE;
+}
+
+
+size_t fused_program::add_unaryop(unop opcode, size_t arg) {
+  if (arg == NONE) return NONE;
+  SType res_stype;
+  expr::blockfn fn = expr::unaryop_block(opcode, regs[arg].stype, &res_stype);
+  if (!fn) return NONE;
+  return _add_reg(fn, res_stype, regs[arg].nrows, arg, NONE);
+}
+
+
+size_t fused_program::add_cast(SType stype, size_t arg) {
+  if (arg == NONE) return NONE;
+  expr::blockfn fn = expr::cast_block(regs[arg].stype, stype);
+  if (!fn) return NONE;
+  return _add_reg(fn, stype, regs[arg].nrows, arg, NONE);
+}
+
+
+size_t fused_program::add_binaryop(size_t opcode, size_t lhs, size_t rhs) {
+  if (lhs == NONE || rhs == NONE) return NONE;
+  SType res_stype;
+  expr::blockfn fn = expr::binaryop_block(opcode, regs[lhs].stype,
+                                          regs[rhs].stype, &res_stype);
+  if (!fn) return NONE;
+  // Same rules as in `expr::binaryop()`: either both operands have the same
+  // number of rows, or one of them has a single row.
+  size_t lnrows = regs[lhs].nrows;
+  size_t rnrows = regs[rhs].nrows;
+  size_t nrows = (lnrows == 0 || rnrows == 0)? 0 :
+                 (lnrows == rnrows || rnrows == 1)? lnrows :
+                 (lnrows == 1)? rnrows : NONE;
+  if (nrows == NONE) return NONE;
+  return _add_reg(fn, res_stype, nrows, lhs, rhs);
+}
+
+
+size_t fused_program::get_nrows(size_t i) const {
+  return regs[i].nrows;
+}
+
+
+SType fused_program::get_stype(size_t i) const {
+  return regs[i].stype;
+}
+
+
+bool fused_program::is_input(size_t i) const {
+  return !regs[i].fn;
+}
+
+
+size_t fused_program::get_nops(size_t out) const {
+  size_t nops = 0;
+  for (size_t i = 0; i <= out; ++i) {
+    nops += regs[i].fn || inputs[i]->rowindex();
+  }
+  return std::max(nops, size_t(1));
+}
+
+
+size_t fused_program::_add_reg(expr::blockfn fn, SType stype, size_t nrows,
+                               size_t arg1, size_t arg2)
+{
+  size_t elemsize = info(stype).elemsize();
+  regs.push_back(reg {fn, arg1, arg2, nrows, elemsize, stype});
+  return regs.size() - 1;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Execute
+//------------------------------------------------------------------------------
+
+template <typename T>
+static void _gather(const Column* col, size_t row0, size_t n, void* buf) {
+  const T* data = static_cast<const T*>(col->data());
+  T* out = static_cast<T*>(buf) - row0;
+  col->rowindex().iterate(row0, row0 + n, 1,
+    [&](size_t i, size_t j) {
+      out[i] = (j == RowIndex::NA)? GETNA<T>() : data[j];
+    });
+}
+
+template <typename T>
+static void _gather(const Column* col, const size_t* rows, size_t n,
+                    void* buf)
+{
+  const T* data = static_cast<const T*>(col->data());
+  T* out = static_cast<T*>(buf);
+  const RowIndex& ri = col->rowindex();
+  if (ri) {
+    for (size_t i = 0; i < n; ++i) {
+      size_t j = ri[rows[i]];
+      out[i] = (j == RowIndex::NA)? GETNA<T>() : data[j];
+    }
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = data[rows[i]];
+    }
+  }
+}
+
+
+/**
+ * Load values of the input register `i` for rows `[row0; row0 + n)` into
+ * buffer `buf`. This is only needed for the columns with a RowIndex, other
+ * columns are read directly.
+ */
+void fused_program::_load(size_t i, size_t row0, size_t n, void* buf) const {
+  const Column* col = inputs[i].get();
+  switch (regs[i].elemsize) {
+    case 1: _gather<int8_t>(col, row0, n, buf); break;
+    case 2: _gather<int16_t>(col, row0, n, buf); break;
+    case 4: regs[i].stype == SType::FLOAT32
+              ? _gather<float>(col, row0, n, buf)
+              : _gather<int32_t>(col, row0, n, buf); break;
+    case 8: regs[i].stype == SType::FLOAT64
+              ? _gather<double>(col, row0, n, buf)
+              : _gather<int64_t>(col, row0, n, buf); break;
+  }
+}
+
+/**
+ * Load values of the input register `i` for rows `rows[0..n)` into buffer
+ * `buf`.
+ */
+void fused_program::_load(size_t i, const size_t* rows, size_t n,
+                          void* buf) const
+{
+  const Column* col = inputs[i].get();
+  switch (regs[i].elemsize) {
+    case 1: _gather<int8_t>(col, rows, n, buf); break;
+    case 2: _gather<int16_t>(col, rows, n, buf); break;
+    case 4: regs[i].stype == SType::FLOAT32
+              ? _gather<float>(col, rows, n, buf)
+              : _gather<int32_t>(col, rows, n, buf); break;
+    case 8: regs[i].stype == SType::FLOAT64
+              ? _gather<double>(col, rows, n, buf)
+              : _gather<int64_t>(col, rows, n, buf); break;
+  }
+}
+
+
+static char* _align(char* ptr) {
+  return ptr + (ALIGN - reinterpret_cast<size_t>(ptr) % ALIGN);
+}
+
+static size_t _aligned_size(size_t size) {
+  return (size + ALIGN - 1) / ALIGN * ALIGN;
+}
+
+
+size_t fused_program::prepare(size_t out_, size_t nrows_, size_t chunk_) {
+  out = out_;
+  nrows = nrows_;
+  chunk = chunk_;
+  size_t nregs = regs.size();
+
+  // Registers with a single row are computed here, once, and broadcast into
+  // buffers of `chunk` elements. The other registers get a buffer in the
+  // scratch space of each thread. The scratch space begins with the array
+  // of pointers to the current values of each register.
+  offsets.assign(nregs, NONE);
+  size_t scratch_size = _aligned_size(nregs * sizeof(void*));
+  size_t bcast_size = 0;
+  for (size_t i = 0; i <= out; ++i) {
+    const reg& r = regs[i];
+    size_t bufsize = _aligned_size(chunk * r.elemsize);
+    if (r.nrows == 1 && nrows > 1) {
+      offsets[i] = bcast_size;
+      bcast_size += bufsize;
+    } else {
+      offsets[i] = scratch_size;
+      scratch_size += bufsize;
+    }
+  }
+  bcast.resize(bcast_size + ALIGN);
+  bcast0 = _align(bcast.data());
+  for (size_t i = 0; i <= out; ++i) {
+    const reg& r = regs[i];
+    if (r.nrows != 1 || nrows == 1) continue;
+    char* buf = bcast0 + offsets[i];
+    if (r.fn) {
+      r.fn(chunk, bcast0 + offsets[r.arg1],
+           r.arg2 == NONE? nullptr : bcast0 + offsets[r.arg2], buf);
+    } else {
+      _load(i, size_t(0), 1, buf);
+      for (size_t j = 1; j < chunk; ++j) {
+        std::memcpy(buf + j * r.elemsize, buf, r.elemsize);
+      }
+    }
+  }
+  return scratch_size;
+}
+
+
+const void* fused_program::run(char* scratch, size_t row0, size_t n,
+                               const size_t* rows, void* dest) const
+{
+  xassert(n <= chunk);
+  auto ptrs = reinterpret_cast<const void**>(scratch);
+  for (size_t i = 0; i <= out; ++i) {
+    const reg& r = regs[i];
+    if (r.nrows == 1 && nrows > 1) {
+      ptrs[i] = bcast0 + offsets[i];
+    } else if (r.fn) {
+      void* res = (i == out && dest)? dest : scratch + offsets[i];
+      r.fn(n, ptrs[r.arg1], r.arg2 == NONE? nullptr : ptrs[r.arg2], res);
+      ptrs[i] = res;
+    } else if (rows) {
+      _load(i, rows, n, scratch + offsets[i]);
+      ptrs[i] = scratch + offsets[i];
+    } else if (inputs[i]->rowindex()) {
+      _load(i, row0, n, scratch + offsets[i]);
+      ptrs[i] = scratch + offsets[i];
+    } else {
+      ptrs[i] = static_cast<const char*>(inputs[i]->data()) +
+                row0 * r.elemsize;
+    }
+  }
+  return ptrs[out];
+}
+
+
+Column* fused_program::execute(size_t out_) {
+  const reg& res = regs[out_];
+  if (!res.fn) return inputs[out_]->shallowcopy();
+  Column* rescol = Column::new_data_column(res.stype, res.nrows);
+  if (res.nrows == 0) return rescol;
+  char* resdata = static_cast<char*>(rescol->data_w());
+  size_t nchunks = (res.nrows + config::expr_chunk_size - 1) /
+                   config::expr_chunk_size;
+  size_t scratch_size = prepare(out_, res.nrows,
+                                std::min(config::expr_chunk_size, res.nrows));
+
+  size_t nth = std::min(nchunks, static_cast<size_t>(config::nthreads));
+  std::vector<char> scratch(nth * scratch_size + ALIGN);
+  char* scratch0 = _align(scratch.data());
+
+  #pragma omp parallel num_threads(nth)
+  {
+    size_t ith = static_cast<size_t>(omp_get_thread_num());
+    char* tbuf = scratch0 + ith * scratch_size;
+
+    #pragma omp for schedule(static)
+    for (size_t ic = 0; ic < nchunks; ++ic) {
+      size_t row0 = ic * chunk;
+      size_t n = std::min(chunk, nrows - row0);
+      run(tbuf, row0, n, nullptr, resdata + row0 * res.elemsize);
+    }
+  }
+  return rescol;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Filter
+//------------------------------------------------------------------------------
+
+size_t filter_program::add_leaf(base_expr* expr, workframe& wf) {
+  fused_program prog;
+  size_t i = prog.compile(expr, wf);
+  if (i == NONE || prog.get_stype(i) != SType::BOOL) return NONE;
+  size_t nrows = prog.get_nrows(i);
+  leaves.resize(nodes.size());
+  leaves.push_back(std::move(prog));
+  return _add_node(kind::LEAF, i, NONE, nrows);
+}
+
+
+size_t filter_program::add_and(size_t lhs, size_t rhs) {
+  if (lhs == NONE || rhs == NONE) return NONE;
+  return _add_node(kind::AND, lhs, rhs, 0);
+}
+
+
+size_t filter_program::add_or(size_t lhs, size_t rhs) {
+  if (lhs == NONE || rhs == NONE) return NONE;
+  xassert(nodes[lhs].type == kind::LEAF && nodes[rhs].type == kind::LEAF);
+  return _add_node(kind::OR, lhs, rhs, 0);
+}
+
+
+size_t filter_program::get_nrows(size_t i) const {
+  return nodes[i].nrows;
+}
+
+
+size_t filter_program::_add_node(kind type, size_t arg1, size_t arg2,
+                                 size_t nrows)
+{
+  if (type != kind::LEAF) {
+    // Same rules as in `expr::binaryop()`
+    size_t lnrows = nodes[arg1].nrows;
+    size_t rnrows = nodes[arg2].nrows;
+    nrows = (lnrows == 0 || rnrows == 0)? 0 :
+            (lnrows == rnrows || rnrows == 1)? lnrows :
+            (lnrows == 1)? rnrows : NONE;
+    if (nrows == NONE) return NONE;
+  }
+  nodes.push_back(node {type, arg1, arg2, nrows});
+  return nodes.size() - 1;
+}
+
+
+// Per-thread buffers used by `filter_program::_filter()`: the scratch space
+// for running the leaves, and for each node a buffer of row indices and a
+// buffer of boolean values, `chunk` elements each.
+struct filter_program::workspace {
+  std::vector<char> scratch;
+  std::vector<size_t> rows;
+  std::vector<int8_t> values;
+  char* scratch0;
+  size_t chunk;
+};
+
+
+/**
+ * Evaluate node `i` on `n` rows: either `[row0; row0 + n)`, or `rows[0..n)`
+ * if `rows` is not nullptr. Write the indices of the rows where the node is
+ * true into `out`, and return their count.
+ */
+template <typename T>
+size_t filter_program::_filter(size_t i, workspace& ws, size_t row0, size_t n,
+                               const size_t* rows, T* out) const
+{
+  const node& nd = nodes[i];
+  size_t k = 0;
+  switch (nd.type) {
+    case kind::LEAF: {
+      auto vals = static_cast<const int8_t*>(
+          leaves[i].run(ws.scratch0, row0, n, rows, nullptr));
+      if (rows) {
+        for (size_t j = 0; j < n; ++j) {
+          if (vals[j] == 1) out[k++] = static_cast<T>(rows[j]);
+        }
+      } else {
+        for (size_t j = 0; j < n; ++j) {
+          if (vals[j] == 1) out[k++] = static_cast<T>(row0 + j);
+        }
+      }
+      return k;
+    }
+    case kind::AND: {
+      size_t* tmp = ws.rows.data() + i * ws.chunk;
+      size_t m = _filter<size_t>(nd.arg1, ws, row0, n, rows, tmp);
+      if (m == 0) return 0;
+      // If the left operand selected all rows, the right one can still read
+      // its inputs sequentially.
+      bool all = (m == n && !rows);
+      return _filter<T>(nd.arg2, ws, row0, m, all? nullptr : tmp, out);
+    }
+    case kind::OR: {
+      size_t* tmp = ws.rows.data() + i * ws.chunk;
+      int8_t* lvals = ws.values.data() + i * ws.chunk;
+      auto vals = static_cast<const int8_t*>(
+          leaves[nd.arg1].run(ws.scratch0, row0, n, rows, nullptr));
+      size_t m = 0;
+      for (size_t j = 0; j < n; ++j) {
+        if (ISNA<int8_t>(vals[j])) continue;
+        tmp[m] = rows? rows[j] : row0 + j;
+        lvals[m] = vals[j];
+        m++;
+      }
+      if (m == 0) return 0;
+      bool all = (m == n && !rows);
+      vals = static_cast<const int8_t*>(
+          leaves[nd.arg2].run(ws.scratch0, row0, m, all? nullptr : tmp,
+                              nullptr));
+      for (size_t j = 0; j < m; ++j) {
+        if (!ISNA<int8_t>(vals[j]) && (lvals[j] || vals[j])) {
+          out[k++] = static_cast<T>(tmp[j]);
+        }
+      }
+      return k;
+    }
+  }
+  return 0;
+}
+
+
+RowIndex filter_program::execute(size_t root, size_t nrows) {
+  size_t chunk = std::min(config::expr_chunk_size, nrows);
+  size_t scratch_size = 0;
+  for (size_t i = 0; i < leaves.size(); ++i) {
+    if (nodes[i].type != kind::LEAF) continue;
+    size_t ss = leaves[i].prepare(nodes[i].arg1, nrows, chunk);
+    scratch_size = std::max(scratch_size, ss);
+  }
+  // Workspaces are created by each thread when it is first used
+  size_t nth = static_cast<size_t>(omp_get_max_threads());
+  std::vector<std::unique_ptr<workspace>> workspaces(nth);
+  auto get_workspace = [&]() -> workspace& {
+    size_t ith = static_cast<size_t>(omp_get_thread_num());
+    if (!workspaces[ith]) {
+      workspace* ws = new workspace;
+      ws->scratch.resize(scratch_size + ALIGN);
+      ws->scratch0 = _align(ws->scratch.data());
+      ws->rows.resize(nodes.size() * chunk);
+      ws->values.resize(nodes.size() * chunk);
+      ws->chunk = chunk;
+      workspaces[ith].reset(ws);
+    }
+    return *workspaces[ith];
+  };
+
+  if (nrows <= INT32_MAX) {
+    return RowIndex(
+      [&](size_t row0, size_t row1, int32_t* ind, size_t* nouts) -> int {
+        workspace& ws = get_workspace();
+        size_t k = 0;
+        for (size_t r0 = row0; r0 < row1; r0 += chunk) {
+          size_t n = std::min(chunk, row1 - r0);
+          k += _filter<int32_t>(root, ws, r0, n, nullptr, ind + k);
+        }
+        *nouts = k;
+        return 0;
+      },
+      nrows, /* sorted = */ true);
+  } else {
+    return RowIndex(
+      [&](size_t row0, size_t row1, int64_t* ind, size_t* nouts) -> int {
+        workspace& ws = get_workspace();
+        size_t k = 0;
+        for (size_t r0 = row0; r0 < row1; r0 += chunk) {
+          size_t n = std::min(chunk, row1 - r0);
+          k += _filter<int64_t>(root, ws, r0, n, nullptr, ind + k);
+        }
+        *nouts = k;
+        return 0;
+      },
+      nrows, /* sorted = */ true);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+// Evaluate
+//------------------------------------------------------------------------------
+
+Column* evaluate_fused(base_expr* expr, workframe& wf) {
+  if (!config::expr_chunk_size) return nullptr;
+  fused_program prog;
+  size_t out = expr->compile_fused(prog, wf);
+  if (out == fused_program::NONE) return nullptr;
+  return prog.execute(out);
+}
+
+
+void evaluate_fused_columns(std::vector<pexpr>& exprs, workframe& wf,
+                            std::vector<Column*>& cols)
+{
+  if (!config::expr_chunk_size) return;
+  struct job {
+    fused_program prog;
+    char* resdata;
+    size_t out;
+    size_t nrows;
+    size_t nops;
+    size_t chunk;
+    size_t elemsize;
+  };
+  struct task {
+    size_t ijob;
+    size_t row0;
+    size_t row1;
+    size_t cost;
+  };
+
+  // Compile the programs, and allocate their result columns. An item equal
+  // to one of the previous items is not compiled, but copied from it.
+  const cse_table* cse = wf.get_cse();
+  std::unordered_map<size_t, size_t> first_item;  // cse entry -> item
+  std::vector<std::pair<size_t, size_t>> copies;
+  std::vector<job> jobs;
+  size_t total_cost = 0;
+  for (size_t i = 0; i < exprs.size(); ++i) {
+    if (cols[i]) continue;
+    size_t id = cse? cse->get_id(exprs[i].get()) : cse_table::NONE;
+    if (id != cse_table::NONE) {
+      auto it = first_item.find(id);
+      if (it != first_item.end()) {
+        copies.push_back({i, it->second});
+        continue;
+      }
+    }
+    fused_program prog;
+    size_t out = exprs[i]->compile_fused(prog, wf);
+    if (out == fused_program::NONE) continue;
+    if (id != cse_table::NONE) first_item[id] = i;
+    size_t nrows = prog.get_nrows(out);
+    if (nrows == 0 || prog.is_input(out)) {
+      cols[i] = prog.execute(out);
+      continue;
+    }
+    SType stype = prog.get_stype(out);
+    cols[i] = Column::new_data_column(stype, nrows);
+    size_t nops = prog.get_nops(out);
+    total_cost += nrows * nops;
+    jobs.push_back(job {std::move(prog),
+                        static_cast<char*>(cols[i]->data_w()), out, nrows,
+                        nops, std::min(config::expr_chunk_size, nrows),
+                        info(stype).elemsize()});
+  }
+  auto fill_copies = [&] {
+    for (auto& c : copies) {
+      if (cols[c.second]) cols[c.first] = cols[c.second]->shallowcopy();
+    }
+  };
+  if (jobs.empty()) {
+    fill_copies();
+    return;
+  }
+
+  // Split the programs into tasks. Each task covers a whole number of
+  // chunks, and costs about as much as 1/4 of the work of one thread.
+  size_t nth = static_cast<size_t>(config::nthreads);
+  size_t task_cost = std::max(total_cost / (4 * nth), size_t(1));
+  size_t scratch_size = 0;
+  std::vector<task> tasks;
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    job& jb = jobs[j];
+    size_t ss = jb.prog.prepare(jb.out, jb.nrows, jb.chunk);
+    scratch_size = std::max(scratch_size, ss);
+    size_t nchunks = std::max(task_cost / (jb.nops * jb.chunk), size_t(1));
+    size_t rows_per_task = nchunks * jb.chunk;
+    for (size_t row0 = 0; row0 < jb.nrows; row0 += rows_per_task) {
+      size_t row1 = std::min(row0 + rows_per_task, jb.nrows);
+      tasks.push_back(task {j, row0, row1, (row1 - row0) * jb.nops});
+    }
+  }
+  std::stable_sort(tasks.begin(), tasks.end(),
+                   [](const task& a, const task& b) { return a.cost > b.cost; });
+
+  nth = std::min(nth, tasks.size());
+  std::vector<char> scratch(nth * scratch_size + ALIGN);
+  char* scratch0 = _align(scratch.data());
+
+  #pragma omp parallel num_threads(nth)
+  {
+    size_t ith = static_cast<size_t>(omp_get_thread_num());
+    char* tbuf = scratch0 + ith * scratch_size;
+
+    #pragma omp for schedule(dynamic, 1)
+    for (size_t it = 0; it < tasks.size(); ++it) {
+      const task& tk = tasks[it];
+      const job& jb = jobs[tk.ijob];
+      for (size_t row0 = tk.row0; row0 < tk.row1; row0 += jb.chunk) {
+        size_t n = std::min(jb.chunk, tk.row1 - row0);
+        jb.prog.run(tbuf, row0, n, nullptr,
+                    jb.resdata + row0 * jb.elemsize);
+      }
+    }
+  }
+  fill_copies();
+}
+
+
+RowIndex evaluate_filter(base_expr* expr, workframe& wf) {
+  size_t nrows = wf.nrows();
+  if (!config::expr_chunk_size || nrows == 0) return RowIndex();
+  filter_program prog;
+  size_t root = expr->compile_filter(prog, wf);
+  if (root == filter_program::NONE || prog.get_nrows(root) != nrows) {
+    return RowIndex();
+  }
+  return prog.execute(root, nrows);
+}
+
+
+
+}  // namespace dt
@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_EXPR_FUSED_h
+#define dt_EXPR_FUSED_h
+#include <unordered_map>
+#include <vector>
+#include "expr/base_expr.h"
+#include "expr/py_expr.h"    // expr::blockfn
+namespace dt {
+
+
+/**
+ * Program for the chunked ("fused") evaluation of an expression tree.
+ *
+ * When evaluated eagerly, every node of the tree produces a full column, so
+ * that `(f.A * 2 + f.B) / f.C` allocates and fills a new column for each of
+ * the operators, even though only the last one is needed. Instead, the fused
+ * program evaluates the entire tree over chunks of `expr.chunk_size` rows:
+ * the values of each node for the current chunk are kept in a small
+ * per-thread buffer (which stays in the cache), and only the values of the
+ * root node are written into the output column. The chunks are processed in
+ * parallel.
+ *
+ * The program is a list of "registers", each holding the values of one node
+ * of the tree. An input register refers to a column: either a column of the
+ * frame, or the result of a subexpression that cannot be evaluated in
+ * chunks (such as a reducer), which is then evaluated eagerly. The values of
+ * an input are read directly from the column's data, or gathered through
+ * its RowIndex. The other registers are computed by an `expr::blockfn`
+ * kernel from one or two preceding registers. Registers with a single row
+ * (for example a literal) are computed only once, and broadcast to all rows.
+ *
+ * The expressions add themselves into the program via their method
+ * `base_expr::compile_fused()`.
+ */
+class fused_program {
+  private:
+    struct reg {
+      expr::blockfn fn;  // nullptr for the input registers
+      size_t arg1;
+      size_t arg2;
+      size_t nrows;
+      size_t elemsize;
+      SType stype;
+      size_t : 56;
+    };
+    std::vector<reg> regs;
+    std::vector<colptr> inputs;  // input columns, indexed by register
+    std::unordered_map<size_t, size_t> cse_regs;  // cse entry -> register
+
+    // Filled by `prepare()`
+    std::vector<size_t> offsets;
+    std::vector<char> bcast;
+    char* bcast0;
+    size_t out;
+    size_t nrows;
+    size_t chunk;
+
+  public:
+    static constexpr size_t NONE = size_t(-1);
+    static bool supports(SType stype);
+
+    fused_program();
+    fused_program(fused_program&&) = default;
+
+    /**
+     * Add expression `expr` into the program, and return the index of the
+     * register that holds its values, or NONE if the expression cannot be
+     * evaluated by this program. Within a list of expressions with common
+     * subexpressions (see "expr/cse.h"), each distinct subexpression is
+     * compiled only once.
+     */
+    size_t compile(base_expr* expr, workframe& wf);
+
+    size_t add_input(Column* col);
+    size_t add_unaryop(unop opcode, size_t arg);
+    size_t add_cast(SType stype, size_t arg);
+    size_t add_binaryop(size_t opcode, size_t lhs, size_t rhs);
+    size_t get_nrows(size_t i) const;
+    SType get_stype(size_t i) const;
+    bool is_input(size_t i) const;
+
+    /**
+     * Number of operations needed to compute register `out` for each row:
+     * the kernels to run, and the inputs to gather through a RowIndex.
+     */
+    size_t get_nops(size_t out) const;
+
+    /**
+     * Run the program, and return the values of register `out` as a new
+     * column.
+     */
+    Column* execute(size_t out);
+
+    /**
+     * Prepare the program for computing the values of register `out` at most
+     * `chunk` rows at a time, by calling `run()`. Registers with a single row
+     * are broadcast to `nrows` rows. Returns the size of the scratch space
+     * that `run()` needs.
+     */
+    size_t prepare(size_t out, size_t nrows, size_t chunk);
+
+    /**
+     * Compute the values of the register `out` for `n` rows: either rows
+     * `[row0; row0 + n)`, or if `rows` is not nullptr, the rows `rows[0..n)`.
+     * The values are written into `dest` if it is given, and the pointer to
+     * the values is returned. This method is thread-safe, provided that each
+     * thread uses its own `scratch`, aligned at 64 bytes.
+     */
+    const void* run(char* scratch, size_t row0, size_t n, const size_t* rows,
+                    void* dest) const;
+
+  private:
+    size_t _add_reg(expr::blockfn fn, SType stype, size_t nrows,
+                    size_t arg1, size_t arg2);
+    void _load(size_t i, size_t row0, size_t n, void* buf) const;
+    void _load(size_t i, const size_t* rows, size_t n, void* buf) const;
+};
+
+
+
+/**
+ * Program for evaluating a boolean filter expression straight into a
+ * RowIndex, without creating the boolean column first.
+ *
+ * The expression is split at the `&` and `|` operators into a tree, whose
+ * leaves are fused programs. The rows are processed in chunks: a leaf
+ * evaluates its program for the given rows of the chunk, and emits the
+ * indices of the rows where the value is true. The `&` operator evaluates
+ * its right operand only on the rows selected by the left one. Because the
+ * `|` operator produces an NA if either of its operands is NA, it can only
+ * skip the rows where its left operand is NA. The indices selected from all
+ * chunks are then concatenated into the final RowIndex in parallel.
+ *
+ * The expressions add themselves into the program via their method
+ * `base_expr::compile_filter()`.
+ */
+class filter_program {
+  private:
+    enum class kind : size_t { LEAF, AND, OR };
+    struct node {
+      kind type;
+      size_t arg1;  // register of the leaf, or the left child
+      size_t arg2;  // right child
+      size_t nrows;
+    };
+    struct workspace;
+    std::vector<node> nodes;
+    std::vector<fused_program> leaves;  // indexed by node
+
+  public:
+    static constexpr size_t NONE = fused_program::NONE;
+
+    size_t add_leaf(base_expr* expr, workframe& wf);
+    size_t add_and(size_t lhs, size_t rhs);
+    size_t add_or(size_t lhs, size_t rhs);
+    size_t get_nrows(size_t i) const;
+
+    /**
+     * Compute the RowIndex of rows selected by `root`, out of `nrows`.
+     */
+    RowIndex execute(size_t root, size_t nrows);
+
+  private:
+    size_t _add_node(kind type, size_t arg1, size_t arg2, size_t nrows);
+    template <typename T>
+    size_t _filter(size_t i, workspace& ws, size_t row0, size_t n,
+                   const size_t* rows, T* out) const;
+};
+
+
+/**
+ * Evaluate `expr` with a fused program, if this is possible and allowed by
+ * the option `expr.chunk_size`. Otherwise return nullptr.
+ */
+Column* evaluate_fused(base_expr* expr, workframe& wf);
+
+/**
+ * Evaluate the expressions `exprs` of a `j` list together. Each expression
+ * whose entry in `cols` is nullptr, and which can be compiled into a fused
+ * program, is evaluated and its result is stored into `cols`. Other entries
+ * are left as nullptr.
+ *
+ * The programs are compiled one after another, and then all of them are run
+ * in a single parallel region. The rows of each program are split into tasks
+ * of about equal estimated cost (number of rows times the number of
+ * operations), which the threads pick up starting from the most expensive.
+ * Thus many short columns are computed concurrently, while a long column is
+ * still split between the threads by rows.
+ */
+void evaluate_fused_columns(std::vector<pexpr>& exprs, workframe& wf,
+                            std::vector<Column*>& cols);
+
+/**
+ * Evaluate boolean expression `expr` with a filter program, and return
+ * the RowIndex of the rows where it is true. If this is not possible, or
+ * not allowed by the option `expr.chunk_size`, return an empty RowIndex.
+ */
+RowIndex evaluate_filter(base_expr* expr, workframe& wf);
+
+
+
+}  // namespace dt
+#endif
@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
 #include "expr/base_expr.h"
+#include "expr/fused.h"     // dt::evaluate_filter
 #include "expr/i_node.h"
 #include "expr/workframe.h"   // dt::workframe
 #include "frame/py_frame.h"
@@ -113,6 +114,11 @@ class slice_in : public i_node {
     slice_in(int64_t, int64_t, int64_t, bool);
     void execute(workframe&) override;
     void execute_grouped(workframe&) override;
+    size_t rows_limit() const override;
+
+  private:
+    template <typename V>
+    void _execute_grouped(workframe&, const V* group_offsets);
 };
 
 
@@ -155,33 +161,63 @@ void slice_in::execute(workframe& wf) {
 }
 
 
+// A slice with positive step selects only the rows before `stop`, and a
+// slice with negative step only the rows up to `start`, provided that these
+// are given and non-negative.
+//
+size_t slice_in::rows_limit() const {
+  if (istep > 0) {
+    if (istart != py::oslice::NA && istart < 0) return size_t(-1);
+    if (istop == py::oslice::NA || istop < 0) return size_t(-1);
+    return static_cast<size_t>(istop);
+  }
+  if (istep < 0) {
+    if (istart == py::oslice::NA || istart < 0) return size_t(-1);
+    return static_cast<size_t>(istart) + 1;
+  }
+  return size_t(-1);
+}
+
+
 // Apply slice to each group, and then update the RowIndexes of all
 // subframes in `wf`, as well as the groupby offsets `gb`.
 //
 void slice_in::execute_grouped(workframe& wf) {
   const Groupby& gb = wf.get_groupby();
-  size_t ng = gb.ngroups();
-  const int32_t* group_offsets = gb.offsets_r() + 1;
+  if (gb.is64()) {
+    _execute_grouped(wf, gb.offsets64_r() + 1);
+  } else {
+    _execute_grouped(wf, gb.offsets_r() + 1);
+  }
+}
+
+
+// The type `V` of the group offsets (`int32_t` or `int64_t`) is also used
+// for the row indices and the group offsets produced.
+//
+template <typename V>
+void slice_in::_execute_grouped(workframe& wf, const V* group_offsets) {
+  size_t ng = wf.get_groupby().ngroups();
 
   size_t ri_size = istep == 0? ng * static_cast<size_t>(istop) : wf.nrows();
-  arr32_t out_ri_array(ri_size);
-  MemoryRange out_groups = MemoryRange::mem((ng + 1) * sizeof(int32_t));
-  int32_t* out_rowindices = out_ri_array.data();
-  int32_t* out_offsets = static_cast<int32_t*>(out_groups.xptr()) + 1;
+  dt::array<V> out_ri_array(ri_size);
+  MemoryRange out_groups = MemoryRange::mem((ng + 1) * sizeof(V));
+  V* out_rowindices = out_ri_array.data();
+  V* out_offsets = static_cast<V*>(out_groups.xptr()) + 1;
   out_offsets[-1] = 0;
   size_t j = 0;  // Counter for the row indices
   size_t k = 0;  // Counter for the number of groups written
 
-  int32_t step = static_cast<int32_t>(istep);
+  V step = static_cast<V>(istep);
   if (step > 0) {
     if (istart == py::oslice::NA) istart = 0;
     if (istop == py::oslice::NA) istop = static_cast<int64_t>(wf.nrows());
     for (size_t g = 0; g < ng; ++g) {
-      int32_t off0 = group_offsets[g - 1];
-      int32_t off1 = group_offsets[g];
-      int32_t n = off1 - off0;
-      int32_t start = static_cast<int32_t>(istart);
-      int32_t stop  = static_cast<int32_t>(istop);
+      V off0 = group_offsets[g - 1];
+      V off1 = group_offsets[g];
+      V n = off1 - off0;
+      V start = static_cast<V>(istart);
+      V stop  = static_cast<V>(istop);
       if (start < 0) start += n;
       if (start < 0) start = 0;
       start += off0;
@@ -189,36 +225,36 @@ void slice_in::execute_grouped(workframe& wf) {
       stop += off0;
       if (stop > off1) stop = off1;
       if (start < stop) {
-        for (int32_t i = start; i < stop; i += step) {
+        for (V i = start; i < stop; i += step) {
           out_rowindices[j++] = i;
         }
-        out_offsets[k++] = static_cast<int32_t>(j);
+        out_offsets[k++] = static_cast<V>(j);
       }
     }
   }
   else if (step < 0) {
     for (size_t g = 0; g < ng; ++g) {
-      int32_t off0 = group_offsets[g - 1];
-      int32_t off1 = group_offsets[g];
-      int32_t n = off1 - off0;
-      int32_t start, stop;
+      V off0 = group_offsets[g - 1];
+      V off1 = group_offsets[g];
+      V n = off1 - off0;
+      V start, stop;
       start = istart == py::oslice::NA || istart >= n
-              ? n - 1 : static_cast<int32_t>(istart);
+              ? n - 1 : static_cast<V>(istart);
       if (start < 0) start += n;
       start += off0;
       if (istop == py::oslice::NA) {
         stop = off0 - 1;
       } else {
-        stop = static_cast<int32_t>(istop);
+        stop = static_cast<V>(istop);
         if (stop < 0) stop += n;
         if (stop < 0) stop = -1;
         stop += off0;
       }
       if (start > stop) {
-        for (int32_t i = start; i > stop; i += step) {
+        for (V i = start; i > stop; i += step) {
           out_rowindices[j++] = i;
         }
-        out_offsets[k++] = static_cast<int32_t>(j);
+        out_offsets[k++] = static_cast<V>(j);
       }
     }
   }
@@ -227,25 +263,25 @@ void slice_in::execute_grouped(workframe& wf) {
     xassert(istart != py::oslice::NA);
     xassert(istop != py::oslice::NA && istop > 0);
     for (size_t g = 0; g < ng; ++g) {
-      int32_t off0 = group_offsets[g - 1];
-      int32_t off1 = group_offsets[g];
-      int32_t n = off1 - off0;
-      int32_t start = static_cast<int32_t>(istart);
+      V off0 = group_offsets[g - 1];
+      V off1 = group_offsets[g];
+      V n = off1 - off0;
+      V start = static_cast<V>(istart);
       if (start < 0) start += n;
       if (start < 0 || start >= n) continue;
       start += off0;
       for (int t = 0; t < istop; ++t) {
         out_rowindices[j++] = start;
       }
-      out_offsets[k++] = static_cast<int32_t>(j);
+      out_offsets[k++] = static_cast<V>(j);
     }
   }
 
   xassert(j <= ri_size);
   out_ri_array.resize(j);
-  out_groups.resize((k + 1) * sizeof(int32_t));
+  out_groups.resize((k + 1) * sizeof(V));
   RowIndex newri(std::move(out_ri_array), /* sorted = */ (step >= 0));
-  Groupby newgb(k, std::move(out_groups));
+  Groupby newgb(k, std::move(out_groups), sizeof(V) == 8);
   wf.apply_rowindex(newri);
   wf.apply_groupby(newgb);
 }
@@ -289,8 +325,13 @@ void expr_in::execute(workframe& wf) {
     throw TypeError() << "Filter expression must be boolean, instead it "
         "was of type " << st;
   }
+  RowIndex res = dt::evaluate_filter(expr, wf);
+  if (res) {
+    wf.apply_rowindex(res);
+    return;
+  }
   Column* col = expr->evaluate_eager(wf);
-  RowIndex res(col);
+  res = RowIndex(col);
   wf.apply_rowindex(res);
   delete col;
 }
@@ -606,6 +647,10 @@ i_node::~i_node() {
 
 void i_node::post_init_check(workframe&) {}
 
+size_t i_node::rows_limit() const {
+  return size_t(-1);
+}
+
 
 static i_node* _make(py::robj src) {
   // The most common case is `:`, a trivial slice
@@ -46,6 +46,10 @@ class i_node {
     virtual void post_init_check(workframe&);
     virtual void execute(workframe&) = 0;
     virtual void execute_grouped(workframe&) = 0;
+
+    // Return the number `n` such that this filter selects only among the
+    // first `n` rows of the frame, or `size_t(-1)` if it may select any row.
+    virtual size_t rows_limit() const;
 };
 
 
@@ -22,6 +22,8 @@
 #include <numeric>            // std::iota
 #include "expr/base_expr.h"
 #include "expr/collist.h"
+#include "expr/cse.h"         // dt::cse_table
+#include "expr/fused.h"       // dt::evaluate_fused_columns
 #include "expr/j_node.h"
 #include "expr/repl_node.h"
 #include "expr/workframe.h"   // dt::workframe
@@ -47,7 +49,9 @@ namespace dt {
  *
  *   However, when 2 or more Frames are joined, this selector will select all
  *   columns from all joined Frames. The exception to this are natural joins,
- *   where the key columns of joined Frames will be excluded from the result.
+ *   where the join columns of joined Frames will be excluded from the result.
+ *   For a keyed Frame these are its key columns; for a Frame without a key
+ *   these are the columns whose names are also present in the source Frame.
  *
  * delete()
  *   Even if several frames are joined, the delete() operator applies only to
@@ -75,16 +79,27 @@ GroupbyMode allcols_jn::get_groupby_mode(workframe&) {
 
 
 void allcols_jn::select(workframe& wf) {
+  const DataTable* dt0 = wf.get_datatable(0);
   for (size_t i = 0; i < wf.nframes(); ++i) {
     const DataTable* dti = wf.get_datatable(i);
     const RowIndex& rii = wf.get_rowindex(i);
     const strvec& dti_names = dti->get_names();
 
-    size_t j0 = wf.is_naturally_joined(i)? dti->get_nkeys() : 0;
+    bool natural = wf.is_naturally_joined(i);
+    bool unkeyed = natural && dti->get_nkeys() == 0;
+    size_t j0 = natural? dti->get_nkeys() : 0;
     wf.reserve(dti->ncols - j0);
     const by_node& by = wf.get_by_node();
     for (size_t j = j0; j < dti->ncols; ++j) {
       if (by.has_group_column(j)) continue;
+      if (unkeyed && dt0->colindex(dti->get_pynames()[j]) != -1) continue;
+      if (i == 0) {
+        std::unique_ptr<Column> col(wf.coalesce_join_column(j));
+        if (col) {
+          wf.add_column(col.get(), RowIndex(), std::string(dti_names[j]));
+          continue;
+        }
+      }
       wf.add_column(dti->columns[j], rii, std::string(dti_names[j]));
     }
   }
@@ -183,6 +198,11 @@ void collist_jn::select(workframe& wf) {
   wf.reserve(n);
   for (size_t i = 0; i < n; ++i) {
     size_t j = indices[i];
+    std::unique_ptr<Column> col(wf.coalesce_join_column(j));
+    if (col) {
+      wf.add_column(col.get(), RowIndex(), std::move(names[i]));
+      continue;
+    }
     wf.add_column(dt0->columns[j], ri0, std::move(names[i]));
   }
 }
@@ -293,8 +313,12 @@ void exprlist_jn::select(workframe& wf) {
 
   wf.reserve(n);
   RowIndex ri0;  // empty rowindex
+  cse_table cse(exprs, wf);
+  std::vector<Column*> cols = evaluate_fused_reducers(exprs, wf);
+  evaluate_fused_columns(exprs, wf, cols);
   for (size_t i = 0; i < n; ++i) {
-    wf.add_column(exprs[i]->evaluate_eager(wf), ri0, std::move(names[i]));
+    Column* col = cols[i]? cols[i] : exprs[i]->evaluate(wf);
+    wf.add_column(col, ri0, std::move(names[i]));
   }
 }
 
@@ -19,9 +19,12 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <cmath>             // std::isinf
 #include "expr/join_node.h"
 #include "datatable.h"
 #include "python/arg.h"
+#include "python/float.h"
+#include "python/string.h"
 namespace py {
 
 
@@ -30,14 +33,29 @@ namespace py {
 //------------------------------------------------------------------------------
 
 PKArgs ojoin::pyobj::Type::args___init__(
-    1, 0, 0, false, false, {"frame"}, "__init__", nullptr);
+    1, 0, 4, false, false, {"frame", "how", "mult", "asof", "tolerance"},
+    "__init__", nullptr);
 
 const char* ojoin::pyobj::Type::classname() {
   return "datatable.join";
 }
 
 const char* ojoin::pyobj::Type::classdoc() {
-  return "join() clause for use in DT[i, j, ...]";
+  return
+    "join(frame, how=\"left\", mult=\"first\", asof=None, tolerance=None)\n\n"
+    "join() clause for use in DT[i, j, ...]\n\n"
+    "Parameter `how` selects the type of the join: \"left\" (all rows of\n"
+    "DT), \"inner\" (only rows of DT that have a match in `frame`),\n"
+    "\"right\" (all rows of `frame`), or \"outer\" (all rows of both\n"
+    "frames). Parameter `mult` controls what happens when a row of DT\n"
+    "matches several rows of `frame`: with \"first\" only the first of\n"
+    "them is taken, with \"all\" the row of DT is repeated for each match.\n\n"
+    "Parameter `asof` requests an inexact match on the last key column of\n"
+    "the keyed `frame`: \"backward\" takes the last row whose key is not\n"
+    "greater than the key in DT, \"forward\" takes the first row whose key\n"
+    "is not less, and \"nearest\" takes the closest of the two. If\n"
+    "`tolerance` is given, then rows whose keys differ by more than this\n"
+    "amount are not matched.\n";
 }
 
 bool ojoin::pyobj::Type::is_subclassable() {
@@ -46,7 +64,15 @@ bool ojoin::pyobj::Type::is_subclassable() {
 
 void ojoin::pyobj::Type::init_methods_and_getsets(Methods&, GetSetters& gs) {
   static GSArgs args_joinframe("joinframe");
+  static GSArgs args_how("how");
+  static GSArgs args_mult("mult");
   ADD_GETTER(gs, &pyobj::get_joinframe, args_joinframe);
+  ADD_GETTER(gs, &pyobj::get_how, args_how);
+  ADD_GETTER(gs, &pyobj::get_mult, args_mult);
+  static GSArgs args_asof("asof");
+  static GSArgs args_tolerance("tolerance");
+  ADD_GETTER(gs, &pyobj::get_asof, args_asof);
+  ADD_GETTER(gs, &pyobj::get_tolerance, args_tolerance);
 }
 
 
@@ -63,9 +89,51 @@ void ojoin::pyobj::m__init__(PKArgs& args) {
   if (!join_frame.is_frame()) {
     throw TypeError() << "The argument to join() must be a Frame";
   }
-  DataTable* jdt = join_frame.to_frame();
-  if (jdt->get_nkeys() == 0) {
-    throw ValueError() << "The join frame is not keyed";
+
+  std::string arg_how = args[1].to<std::string>("left");
+  if (arg_how == "left") how = JoinType::LEFT;
+  else if (arg_how == "inner") how = JoinType::INNER;
+  else if (arg_how == "right") how = JoinType::RIGHT;
+  else if (arg_how == "outer") how = JoinType::OUTER;
+  else {
+    throw ValueError() << "Parameter `how` in join() should be one of "
+        "'left', 'inner', 'right' or 'outer', instead got '" << arg_how << "'";
+  }
+
+  std::string arg_mult = args[2].to<std::string>("first");
+  if (arg_mult == "first") mult_all = false;
+  else if (arg_mult == "all") mult_all = true;
+  else {
+    throw ValueError() << "Parameter `mult` in join() should be either "
+        "'first' or 'all', instead got '" << arg_mult << "'";
+  }
+
+  std::string arg_asof = args[3].to<std::string>("");
+  if (arg_asof.empty()) asof = AsofType::NONE;
+  else if (arg_asof == "backward") asof = AsofType::BACKWARD;
+  else if (arg_asof == "forward") asof = AsofType::FORWARD;
+  else if (arg_asof == "nearest") asof = AsofType::NEAREST;
+  else {
+    throw ValueError() << "Parameter `asof` in join() should be one of "
+        "'backward', 'forward' or 'nearest', instead got '" << arg_asof << "'";
+  }
+  if (asof != AsofType::NONE &&
+      (how == JoinType::RIGHT || how == JoinType::OUTER)) {
+    throw ValueError() << "Asof join can only be used with how='left' or "
+        "how='inner'";
+  }
+
+  tolerance = std::numeric_limits<double>::infinity();
+  if (!args[4].is_none_or_undefined()) {
+    if (asof == AsofType::NONE) {
+      throw ValueError() << "Parameter `tolerance` in join() can only be used "
+          "together with parameter `asof`";
+    }
+    tolerance = args[4].to_double();
+    if (!(tolerance >= 0)) {
+      throw ValueError() << "Parameter `tolerance` in join() cannot be "
+          "negative or NaN";
+    }
   }
 }
 
@@ -80,6 +148,39 @@ oobj ojoin::pyobj::get_joinframe() const {
 }
 
 
+oobj ojoin::pyobj::get_how() const {
+  switch (how) {
+    case JoinType::LEFT:  return ostring("left");
+    case JoinType::INNER: return ostring("inner");
+    case JoinType::RIGHT: return ostring("right");
+    case JoinType::OUTER: return ostring("outer");
+  }
+  return None();
+}
+
+
+oobj ojoin::pyobj::get_mult() const {
+  return ostring(mult_all? "all" : "first");
+}
+
+
+oobj ojoin::pyobj::get_asof() const {
+  switch (asof) {
+    case AsofType::NONE:     return None();
+    case AsofType::BACKWARD: return ostring("backward");
+    case AsofType::FORWARD:  return ostring("forward");
+    case AsofType::NEAREST:  return ostring("nearest");
+  }
+  return None();
+}
+
+
+oobj ojoin::pyobj::get_tolerance() const {
+  if (std::isinf(tolerance)) return None();
+  return ofloat(tolerance);
+}
+
+
 
 //------------------------------------------------------------------------------
 // ojoin
@@ -94,6 +195,26 @@ DataTable* ojoin::get_datatable() const {
 }
 
 
+JoinType ojoin::get_how() const {
+  return static_cast<pyobj*>(v)->how;
+}
+
+
+bool ojoin::get_mult_all() const {
+  return static_cast<pyobj*>(v)->mult_all;
+}
+
+
+AsofType ojoin::get_asof() const {
+  return static_cast<pyobj*>(v)->asof;
+}
+
+
+double ojoin::get_tolerance() const {
+  return static_cast<pyobj*>(v)->tolerance;
+}
+
+
 bool ojoin::check(PyObject* v) {
   if (!v) return false;
   auto typeptr = reinterpret_cast<PyObject*>(&pyobj::Type::type);
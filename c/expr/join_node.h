@@ -23,6 +23,7 @@
 #define dt_EXPR_JOIN_NODE_h
 #include "python/ext_type.h"
 #include "python/obj.h"
+#include "datatable.h"  // JoinType
 
 namespace py {
 
@@ -33,6 +34,11 @@ class ojoin : public oobj
   class pyobj : public PyObject {
     public:
       oobj join_frame;
+      double tolerance;
+      JoinType how;
+      AsofType asof;
+      bool mult_all;
+      size_t : 40;
 
       class Type : public ExtType<pyobj> {
         public:
@@ -46,6 +52,10 @@ class ojoin : public oobj
       void m__init__(PKArgs&);
       void m__dealloc__();
       oobj get_joinframe() const;
+      oobj get_how() const;
+      oobj get_mult() const;
+      oobj get_asof() const;
+      oobj get_tolerance() const;
 
     private:
       // The class does not use traditional constructor/destructor mechanism.
@@ -62,6 +72,10 @@ class ojoin : public oobj
     ojoin& operator=(ojoin&&) = default;
 
     DataTable* get_datatable() const;
+    JoinType get_how() const;
+    bool get_mult_all() const;
+    AsofType get_asof() const;
+    double get_tolerance() const;
 
     static bool check(PyObject* v);
     static void init(PyObject* m);
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #ifndef dt_EXPR_PY_EXPR_h
 #define dt_EXPR_PY_EXPR_h
+#include <vector>
 #include "expr/base_expr.h"
 #include "column.h"
 #include "groupby.h"
@@ -16,13 +17,30 @@
 namespace expr {
 
 typedef void (*mapperfn)(int64_t row0, int64_t row1, void** params);
-typedef void (*gmapperfn)(const int32_t* groups, int32_t grp, void** params);
 
 Column* unaryop(dt::unop opcode, Column* arg);
 Column* binaryop(size_t opcode, Column* lhs, Column* rhs);
 Column* reduceop(int opcode, Column* arg, const Groupby& groupby);
 Column* reduce_first(const Column* col, const Groupby& groupby);
 
+// Compute several reductions of the same column over the same groups, in a
+// single pass over the data. Each of the `opcodes` must satisfy
+// `can_reduce_together()`.
+bool can_reduce_together(int opcode, SType arg_type);
+std::vector<Column*> reduceops(const std::vector<int>& opcodes, Column* arg,
+                               const Groupby& groupby);
+
+// Kernels for the chunked evaluation of expressions (see "expr/fused.h"):
+// apply the operation to `n` consecutive elements of arrays `x` and `y` (the
+// unary operations ignore `y`), and write the results into `out`. The
+// functions below return nullptr if the operation cannot be evaluated in
+// this way, otherwise the stype of the result is stored in `res_type`.
+typedef void (*blockfn)(size_t n, const void* x, const void* y, void* out);
+blockfn unaryop_block(dt::unop opcode, SType arg_type, SType* res_type);
+blockfn cast_block(SType arg_type, SType res_type);
+blockfn binaryop_block(size_t opcode, SType lhs_type, SType rhs_type,
+                       SType* res_type);
+
 };
 
 #endif
@@ -9,8 +9,11 @@
 #include <cmath>      // std::sqrt
 #include <limits>     // std::numeric_limits<?>::max, ::infinity
 #include <type_traits>
+#include <vector>
 #include "types.h"
+#include "utils/assert.h"
 #include "utils/parallel.h"
+#include "utils/simd.h"
 
 namespace expr
 {
@@ -34,193 +37,534 @@ constexpr T infinity() {
 }
 
 
+
 //------------------------------------------------------------------------------
-// "First" reducer
+// Partial states
 //------------------------------------------------------------------------------
 
-Column* reduce_first(const Column* col, const Groupby& groupby) {
-  if (col->nrows == 0) {
-    return Column::new_data_column(col->stype(), 0);
+// Each reducer accumulates the values from a range of rows into a "state".
+// The state of a range can be merged with the state of the range that
+// immediately follows it (similar to `Stats::merge_stats()`), so that a large
+// group can be split into several ranges, reduced in parallel, and then the
+// partial results combined. Method `get()` returns the final value.
+
+struct CountState {
+  int64_t count;
+
+  CountState() : count(0) {}
+  void merge(const CountState& o) { count += o.count; }
+  int64_t get() const { return count; }
+};
+
+
+template<typename OT>
+struct SumState {
+  OT sum;
+
+  SumState() : sum(0) {}
+  void merge(const SumState& o) { sum += o.sum; }
+  OT get() const { return sum; }
+};
+
+
+// Compensated (Kahan) summation: the exact sum is approximately equal to
+// `sum - delta`.
+template<typename OT>
+struct MeanState {
+  OT sum;
+  OT delta;
+  int64_t count;
+
+  MeanState() : sum(0), delta(0), count(0) {}
+  void add(OT x) {
+    OT y = x - delta;
+    OT t = sum + y;
+    delta = (t - sum) - y;
+    sum = t;
+    count++;
   }
-  size_t ngrps = groupby.ngroups();
-  // groupby.offsets array has length `ngrps + 1` and contains offsets of the
-  // beginning of each group. We will take this array and reinterpret it as a
-  // RowIndex (taking only the first `ngrps` elements). Applying this rowindex
-  // to the column will produce the vector of first elements in that column.
-  arr32_t indices(ngrps, groupby.offsets_r());
-  RowIndex ri = RowIndex(std::move(indices), true)
-                * col->rowindex();
-  Column* res = col->shallowcopy(ri);
-  if (ngrps == 1) res->reify();
-  return res;
-}
+  void merge(const MeanState& o) {
+    OT y = (o.sum - o.delta) - delta;
+    OT t = sum + y;
+    delta = (t - sum) - y;
+    sum = t;
+    count += o.count;
+  }
+  OT get() const { return count == 0? GETNA<OT>() : sum / count; }
+};
+
+
+// Welford algorithm; the states are merged using the formula of Chan et al.
+template<typename OT>
+struct StdevState {
+  OT mean;
+  OT m2;
+  int64_t count;
+
+  StdevState() : mean(0), m2(0), count(0) {}
+  template<typename IT> void add(IT x) {
+    count++;
+    OT t1 = x - mean;
+    mean += t1 / count;
+    OT t2 = x - mean;
+    m2 += t1 * t2;
+  }
+  void merge(const StdevState& o) {
+    if (o.count == 0) return;
+    if (count == 0) { *this = o; return; }
+    int64_t n = count + o.count;
+    OT delta = o.mean - mean;
+    mean += delta * o.count / n;
+    m2 += o.m2 + delta * delta * count * o.count / n;
+    count = n;
+  }
+  OT get() const {
+    return count <= 1? GETNA<OT>() : std::sqrt(m2 / (count - 1));
+  }
+};
+
+
+// Minimum (if `MIN` is true) or maximum of the values
+template<typename T, bool MIN>
+struct MinMaxState {
+  T value;
+  int64_t count;
+
+  MinMaxState() : value(MIN? infinity<T>() : -infinity<T>()), count(0) {}
+  void add(T x) {
+    if (MIN? (x < value) : (x > value)) value = x;
+    count++;
+  }
+  void merge(const MinMaxState& o) {
+    if (MIN? (o.value < value) : (o.value > value)) value = o.value;
+    count += o.count;
+  }
+  T get() const { return count? value : GETNA<T>(); }
+};
 
 
 
 //------------------------------------------------------------------------------
-// Sum calculation
+// Kernels for contiguous data
 //------------------------------------------------------------------------------
 
+/**
+ * When the rows `row0 .. row1` of a column are stored contiguously in its
+ * data buffer (i.e. the column has no rowindex, or its rowindex is a slice
+ * with step 1), store the pointer to the first of them into `*px` and return
+ * true. Otherwise, the generic path via `RowIndex::iterate()` must be used.
+ */
+template<typename T>
+static bool contiguous_range(const Column* col, size_t row0, const T** px) {
+  const RowIndex& ri = col->rowindex();
+  const T* data = static_cast<const T*>(col->data());
+  if (std::is_same<uint32_t, T>::value ||
+      std::is_same<uint64_t, T>::value) data++;
+  if (ri.isabsent()) {
+    *px = data + row0;
+    return true;
+  }
+  if (ri.isslice() && ri.slice_step() == 1) {
+    *px = data + ri.slice_start() + row0;
+    return true;
+  }
+  return false;
+}
+
+
+// The kernels below process the data in blocks of `NLANES` elements, keeping
+// a separate accumulator for each position within the block. This breaks the
+// dependency chain between consecutive elements, and allows the compiler to
+// vectorize the inner loops. The NA checks are written as selects rather
+// than branches for the same reason.
+static constexpr size_t NLANES = 8;
+
+
+template<typename IT>
+static DT_KERNEL CountState count_kernel(const IT* x, size_t n) {
+  int64_t acc[NLANES] = {0};
+  size_t i = 0;
+  for (; i + NLANES <= n; i += NLANES) {
+    for (size_t k = 0; k < NLANES; ++k) {
+      acc[k] += !ISNA<IT>(x[i + k]);
+    }
+  }
+  for (; i < n; ++i) acc[0] += !ISNA<IT>(x[i]);
+  CountState res;
+  for (size_t k = 0; k < NLANES; ++k) res.count += acc[k];
+  return res;
+}
+
+
 template<typename IT, typename OT>
-static void sum_skipna(const int32_t* groups, int32_t grp, void** params) {
-  Column* col0 = static_cast<Column*>(params[0]);
-  Column* col1 = static_cast<Column*>(params[1]);
-  const IT* inputs = static_cast<const IT*>(col0->data());
-  OT* outputs = static_cast<OT*>(col1->data_w());
-  OT sum = 0;
-  size_t row0 = static_cast<size_t>(groups[grp]);
-  size_t row1 = static_cast<size_t>(groups[grp + 1]);
-  col0->rowindex().iterate(row0, row1, 1,
-    [&](size_t, size_t j) {
-      if (j == RowIndex::NA) return;
-      IT x = inputs[j];
-      if (!ISNA<IT>(x))
-        sum += static_cast<OT>(x);
-    });
-  outputs[grp] = sum;
+static DT_KERNEL SumState<OT> sum_kernel(const IT* x, size_t n) {
+  OT acc[NLANES] = {0};
+  size_t i = 0;
+  for (; i + NLANES <= n; i += NLANES) {
+    for (size_t k = 0; k < NLANES; ++k) {
+      IT v = x[i + k];
+      acc[k] += ISNA<IT>(v)? OT(0) : static_cast<OT>(v);
+    }
+  }
+  for (; i < n; ++i) {
+    if (!ISNA<IT>(x[i])) acc[0] += static_cast<OT>(x[i]);
+  }
+  SumState<OT> res;
+  for (size_t k = 0; k < NLANES; ++k) res.sum += acc[k];
+  return res;
+}
+
+
+// Compensated summation in each lane; the lanes are then merged together.
+template<typename IT, typename OT>
+static DT_KERNEL MeanState<OT> mean_kernel(const IT* x, size_t n) {
+  OT acc[NLANES] = {0};
+  OT delta[NLANES] = {0};
+  int64_t cnt[NLANES] = {0};
+  size_t i = 0;
+  for (; i + NLANES <= n; i += NLANES) {
+    for (size_t k = 0; k < NLANES; ++k) {
+      IT v = x[i + k];
+      bool isna = ISNA<IT>(v);
+      OT y = (isna? OT(0) : static_cast<OT>(v)) - delta[k];
+      OT t = acc[k] + y;
+      delta[k] = isna? delta[k] : (t - acc[k]) - y;
+      acc[k] = isna? acc[k] : t;
+      cnt[k] += !isna;
+    }
+  }
+  MeanState<OT> res;
+  for (size_t k = 0; k < NLANES; ++k) {
+    MeanState<OT> lane;
+    lane.sum = acc[k];
+    lane.delta = delta[k];
+    lane.count = cnt[k];
+    res.merge(lane);
+  }
+  for (; i < n; ++i) {
+    if (!ISNA<IT>(x[i])) res.add(static_cast<OT>(x[i]));
+  }
+  return res;
+}
+
+
+template<typename T, bool MIN>
+static DT_KERNEL MinMaxState<T, MIN> minmax_kernel(const T* x, size_t n) {
+  T init = MIN? infinity<T>() : -infinity<T>();
+  T acc[NLANES];
+  int64_t cnt[NLANES] = {0};
+  for (size_t k = 0; k < NLANES; ++k) acc[k] = init;
+  size_t i = 0;
+  for (; i + NLANES <= n; i += NLANES) {
+    for (size_t k = 0; k < NLANES; ++k) {
+      T v = x[i + k];
+      bool isna = ISNA<T>(v);
+      bool better = MIN? (v < acc[k]) : (v > acc[k]);
+      acc[k] = (better && !isna)? v : acc[k];
+      cnt[k] += !isna;
+    }
+  }
+  MinMaxState<T, MIN> res;
+  for (size_t k = 0; k < NLANES; ++k) {
+    MinMaxState<T, MIN> lane;
+    lane.value = acc[k];
+    lane.count = cnt[k];
+    res.merge(lane);
+  }
+  for (; i < n; ++i) {
+    if (!ISNA<T>(x[i])) res.add(x[i]);
+  }
+  return res;
+}
+
+
+// Each kernel is compiled twice: for the baseline instruction set, and for
+// AVX2. The AVX2 version is selected at runtime, if the CPU supports it.
+
+template<typename IT>
+DT_TARGET_AVX2 static CountState count_avx2(const IT* x, size_t n) {
+  return count_kernel<IT>(x, n);
+}
+
+template<typename IT, typename OT>
+DT_TARGET_AVX2 static SumState<OT> sum_avx2(const IT* x, size_t n) {
+  return sum_kernel<IT, OT>(x, n);
+}
+
+template<typename IT, typename OT>
+DT_TARGET_AVX2 static MeanState<OT> mean_avx2(const IT* x, size_t n) {
+  return mean_kernel<IT, OT>(x, n);
+}
+
+template<typename T, bool MIN>
+DT_TARGET_AVX2 static MinMaxState<T, MIN> minmax_avx2(const T* x, size_t n) {
+  return minmax_kernel<T, MIN>(x, n);
+}
+
+
+// Reduce `n` contiguous values with the kernel for the current CPU. These
+// functions are shared by the single and the multiple reducers, so that both
+// produce bit-identical results.
+
+template<typename IT>
+static CountState count_contiguous(const IT* x, size_t n) {
+  return cpu_has_avx2()? count_avx2<IT>(x, n) : count_kernel<IT>(x, n);
+}
+
+template<typename IT, typename OT>
+static SumState<OT> sum_contiguous(const IT* x, size_t n) {
+  return cpu_has_avx2()? sum_avx2<IT, OT>(x, n) : sum_kernel<IT, OT>(x, n);
+}
+
+template<typename IT, typename OT>
+static MeanState<OT> mean_contiguous(const IT* x, size_t n) {
+  return cpu_has_avx2()? mean_avx2<IT, OT>(x, n) : mean_kernel<IT, OT>(x, n);
+}
+
+template<typename T, bool MIN>
+static MinMaxState<T, MIN> minmax_contiguous(const T* x, size_t n) {
+  return cpu_has_avx2()? minmax_avx2<T, MIN>(x, n)
+                       : minmax_kernel<T, MIN>(x, n);
 }
 
 
 
 //------------------------------------------------------------------------------
-// Count calculation
+// Reducing a range of rows
 //------------------------------------------------------------------------------
 
-template<typename IT, typename OT>
-static void count_skipna(const int32_t* groups, int32_t grp, void** params) {
-  Column* col0 = static_cast<Column*>(params[0]);
-  Column* col1 = static_cast<Column*>(params[1]);
-  const IT* inputs = static_cast<const IT*>(col0->data());
+// Each of these functions computes the state of a reducer over the rows
+// `row0 .. row1` of the column `col`, skipping NA values. The contiguous
+// kernels are used when possible.
+
+template<typename IT>
+static CountState count_range(const Column* col, size_t row0, size_t row1) {
+  const IT* x;
+  if (contiguous_range(col, row0, &x)) {
+    return count_contiguous<IT>(x, row1 - row0);
+  }
+  const IT* inputs = static_cast<const IT*>(col->data());
   if (std::is_same<uint32_t, IT>::value ||
       std::is_same<uint64_t, IT>::value) inputs++;
-  OT* outputs = static_cast<OT*>(col1->data_w());
-  OT count = 0;
-  size_t row0 = static_cast<size_t>(groups[grp]);
-  size_t row1 = static_cast<size_t>(groups[grp + 1]);
-  col0->rowindex().iterate(row0, row1, 1,
+  CountState res;
+  col->rowindex().iterate(row0, row1, 1,
     [&](size_t, size_t j) {
       if (j == RowIndex::NA) return;
-      IT x = inputs[j];
-      count += !ISNA<IT>(x);
+      res.count += !ISNA<IT>(inputs[j]);
     });
-  outputs[grp] = count;
+  return res;
 }
 
 
-
-//------------------------------------------------------------------------------
-// Mean calculation
-//------------------------------------------------------------------------------
-
 template<typename IT, typename OT>
-static void mean_skipna(const int32_t* groups, int32_t grp, void** params) {
-  Column* col0 = static_cast<Column*>(params[0]);
-  Column* col1 = static_cast<Column*>(params[1]);
-  const IT* inputs = static_cast<const IT*>(col0->data());
-  OT* outputs = static_cast<OT*>(col1->data_w());
-  OT sum = 0;
-  int64_t cnt = 0;
-  OT delta = 0;
-  size_t row0 = static_cast<size_t>(groups[grp]);
-  size_t row1 = static_cast<size_t>(groups[grp + 1]);
-  col0->rowindex().iterate(row0, row1, 1,
+static SumState<OT> sum_range(const Column* col, size_t row0, size_t row1) {
+  const IT* x;
+  if (contiguous_range(col, row0, &x)) {
+    return sum_contiguous<IT, OT>(x, row1 - row0);
+  }
+  const IT* inputs = static_cast<const IT*>(col->data());
+  SumState<OT> res;
+  col->rowindex().iterate(row0, row1, 1,
     [&](size_t, size_t j) {
       if (j == RowIndex::NA) return;
       IT x = inputs[j];
-      if (ISNA<IT>(x)) return;
-      OT y = static_cast<OT>(x) - delta;
-      OT t = sum + y;
-      delta = (t - sum) - y;
-      sum = t;
-      cnt++;
+      if (!ISNA<IT>(x))
+        res.sum += static_cast<OT>(x);
     });
-  outputs[grp] = cnt == 0? GETNA<OT>() : sum / cnt;
+  return res;
 }
 
 
-
-//------------------------------------------------------------------------------
-// Standard deviation
-//------------------------------------------------------------------------------
-
-// Welford algorithm
 template<typename IT, typename OT>
-static void stdev_skipna(const int32_t* groups, int32_t grp, void** params) {
-  Column* col0 = static_cast<Column*>(params[0]);
-  Column* col1 = static_cast<Column*>(params[1]);
-  const IT* inputs = static_cast<const IT*>(col0->data());
-  OT* outputs = static_cast<OT*>(col1->data_w());
-  OT mean = 0;
-  OT m2 = 0;
-  int64_t cnt = 0;
-  size_t row0 = static_cast<size_t>(groups[grp]);
-  size_t row1 = static_cast<size_t>(groups[grp + 1]);
-  col0->rowindex().iterate(row0, row1, 1,
+static MeanState<OT> mean_range(const Column* col, size_t row0, size_t row1) {
+  const IT* x;
+  if (contiguous_range(col, row0, &x)) {
+    return mean_contiguous<IT, OT>(x, row1 - row0);
+  }
+  const IT* inputs = static_cast<const IT*>(col->data());
+  MeanState<OT> res;
+  col->rowindex().iterate(row0, row1, 1,
     [&](size_t, size_t j) {
       if (j == RowIndex::NA) return;
       IT x = inputs[j];
-      if (ISNA<IT>(x)) return;
-      cnt++;
-      OT t1 = x - mean;
-      mean += t1 / cnt;
-      OT t2 = x - mean;
-      m2 += t1 * t2;
+      if (!ISNA<IT>(x)) res.add(static_cast<OT>(x));
     });
-  outputs[grp] = cnt <= 1? GETNA<OT>() : std::sqrt(m2 / (cnt - 1));
+  return res;
 }
 
 
+template<typename IT, typename OT>
+static StdevState<OT> stdev_range(const Column* col, size_t row0, size_t row1)
+{
+  const IT* inputs = static_cast<const IT*>(col->data());
+  StdevState<OT> res;
+  col->rowindex().iterate(row0, row1, 1,
+    [&](size_t, size_t j) {
+      if (j == RowIndex::NA) return;
+      IT x = inputs[j];
+      if (!ISNA<IT>(x)) res.add(x);
+    });
+  return res;
+}
 
-//------------------------------------------------------------------------------
-// Minimum
-//------------------------------------------------------------------------------
 
-template<typename T>
-static void min_skipna(const int32_t* groups, int32_t grp, void** params) {
-  Column* col0 = static_cast<Column*>(params[0]);
-  Column* col1 = static_cast<Column*>(params[1]);
-  const T* inputs = static_cast<const T*>(col0->data());
-  T* outputs = static_cast<T*>(col1->data_w());
-  T res = infinity<T>();
-  size_t row0 = static_cast<size_t>(groups[grp]);
-  size_t row1 = static_cast<size_t>(groups[grp + 1]);
-  bool valid = false;
-  col0->rowindex().iterate(row0, row1, 1,
+template<typename T, bool MIN>
+static MinMaxState<T, MIN> minmax_range(const Column* col, size_t row0,
+                                        size_t row1)
+{
+  const T* x;
+  if (contiguous_range(col, row0, &x)) {
+    return minmax_contiguous<T, MIN>(x, row1 - row0);
+  }
+  const T* inputs = static_cast<const T*>(col->data());
+  MinMaxState<T, MIN> res;
+  col->rowindex().iterate(row0, row1, 1,
     [&](size_t, size_t j) {
       if (j == RowIndex::NA) return;
       T x = inputs[j];
-      if (ISNA<T>(x)) return;
-      if (x < res) res = x;
-      valid = true;
+      if (!ISNA<T>(x)) res.add(x);
     });
-  outputs[grp] = valid? res : GETNA<T>();
+  return res;
 }
 
 
 
 //------------------------------------------------------------------------------
-// Maximum
+// Scheduling
 //------------------------------------------------------------------------------
 
-template<typename T>
-static void max_skipna(const int32_t* groups, int32_t grp, void** params) {
-  Column* col0 = static_cast<Column*>(params[0]);
-  Column* col1 = static_cast<Column*>(params[1]);
-  const T* inputs = static_cast<const T*>(col0->data());
-  T* outputs = static_cast<T*>(col1->data_w());
-  T res = -infinity<T>();
-  bool valid = false;
-  size_t row0 = static_cast<size_t>(groups[grp]);
-  size_t row1 = static_cast<size_t>(groups[grp + 1]);
-  col0->rowindex().iterate(row0, row1, 1,
-    [&](size_t, size_t j) {
-      if (j == RowIndex::NA) return;
-      T x = inputs[j];
-      if (ISNA<T>(x)) return;
-      if (x > res) res = x;
-      valid = true;
-    });
-  outputs[grp] = valid? res : GETNA<T>();
+// Groups with more than `2 * SPLIT_SIZE` rows are split into ranges of about
+// `SPLIT_SIZE` rows, which are reduced in parallel. The split depends only on
+// the size of the group, so that the result does not depend on the number of
+// threads.
+static constexpr size_t SPLIT_SIZE = 1 << 16;
+
+// Number of consecutive small groups processed by a thread as a single task.
+static constexpr int GROUP_BATCH = 64;
+
+
+/**
+ * Apply the reducer `red` to all groups. The reducer must provide the type
+ * `state_t`, and methods
+ *
+ *   state_t reduce(size_t row0, size_t row1) const;
+ *   void store(size_t grp, const state_t& state) const;
+ *
+ * Small groups are processed in parallel, in batches of `GROUP_BATCH` groups
+ * each. Large groups are split into ranges which are reduced in parallel, and
+ * then the states of these ranges are merged.
+ */
+template<typename R, typename V>
+static void reduce_groups(const R& red, const V* groups, size_t ngrps) {
+  using state_t = typename R::state_t;
+  struct subrange { size_t grp, row0, row1; };
+  std::vector<subrange> subranges;
+  for (size_t g = 0; g < ngrps; ++g) {
+    size_t row0 = static_cast<size_t>(groups[g]);
+    size_t row1 = static_cast<size_t>(groups[g + 1]);
+    if (row1 - row0 <= 2 * SPLIT_SIZE) continue;
+    size_t nparts = (row1 - row0) / SPLIT_SIZE;
+    for (size_t i = 0; i < nparts; ++i) {
+      subranges.push_back({g, row0 + (row1 - row0) * i / nparts,
+                              row0 + (row1 - row0) * (i + 1) / nparts});
+    }
+  }
+
+  int64_t ng = static_cast<int64_t>(ngrps);
+  #pragma omp parallel for schedule(dynamic, GROUP_BATCH)
+  for (int64_t g = 0; g < ng; ++g) {
+    size_t row0 = static_cast<size_t>(groups[g]);
+    size_t row1 = static_cast<size_t>(groups[g + 1]);
+    if (row1 - row0 > 2 * SPLIT_SIZE) continue;
+    red.store(static_cast<size_t>(g), red.reduce(row0, row1));
+  }
+
+  if (subranges.empty()) return;
+  std::vector<state_t> states(subranges.size());
+  int64_t ns = static_cast<int64_t>(subranges.size());
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int64_t i = 0; i < ns; ++i) {
+    const subrange& sr = subranges[static_cast<size_t>(i)];
+    states[static_cast<size_t>(i)] = red.reduce(sr.row0, sr.row1);
+  }
+  size_t i = 0;
+  while (i < subranges.size()) {
+    size_t g = subranges[i].grp;
+    state_t st = states[i++];
+    while (i < subranges.size() && subranges[i].grp == g) {
+      st.merge(states[i++]);
+    }
+    red.store(g, st);
+  }
+}
+
+
+/**
+ * Apply the reducer `red` to all groups of the `groupby`, whose offsets may
+ * be either 32- or 64-bit. An empty groupby is treated as a single group
+ * containing all `nrows` rows.
+ */
+template<typename R>
+static void reduce_groupby(const R& red, const Groupby& gb, size_t nrows) {
+  if (!gb) {
+    int64_t grps[2] = {0, static_cast<int64_t>(nrows)};
+    reduce_groups(red, grps, 1);
+  } else if (gb.is64()) {
+    reduce_groups(red, gb.offsets64_r(), gb.ngroups());
+  } else {
+    reduce_groups(red, gb.offsets_r(), gb.ngroups());
+  }
+}
+
+
+/**
+ * Reducer that computes a single value from column `col` into the column
+ * `out` of type `OT`, using the range function `RANGE`.
+ */
+template<typename S, typename OT, S (*RANGE)(const Column*, size_t, size_t)>
+class SingleReducer {
+  private:
+    const Column* col;
+    OT* out;
+
+  public:
+    using state_t = S;
+    SingleReducer(const Column* c, Column* o)
+      : col(c), out(static_cast<OT*>(o->data_w())) {}
+    S reduce(size_t row0, size_t row1) const { return RANGE(col, row0, row1); }
+    void store(size_t g, const S& st) const { out[g] = static_cast<OT>(st.get()); }
+};
+
+
+using reducerfn = void (*)(const Column* col, Column* out,
+                           const Groupby& groupby);
+
+template<typename S, typename OT, S (*RANGE)(const Column*, size_t, size_t)>
+static void run_reducer(const Column* col, Column* out,
+                        const Groupby& groupby)
+{
+  reduce_groupby(SingleReducer<S, OT, RANGE>(col, out), groupby, col->nrows);
+}
+
+
+
+//------------------------------------------------------------------------------
+// "First" reducer
+//------------------------------------------------------------------------------
+
+Column* reduce_first(const Column* col, const Groupby& groupby) {
+  if (col->nrows == 0) {
+    return Column::new_data_column(col->stype(), 0);
+  }
+  size_t ngrps = groupby.ngroups();
+  // groupby.offsets array has length `ngrps + 1` and contains offsets of the
+  // beginning of each group. Taking the first `ngrps` elements of this array
+  // as a RowIndex, and applying it to the column will produce the vector of
+  // first elements in that column.
+  RowIndex ri = groupby.first_rows_rowindex() * col->rowindex();
+  Column* res = col->shallowcopy(ri);
+  if (ngrps == 1) res->reify();
+  return res;
 }
 
 
@@ -230,29 +574,43 @@ static void max_skipna(const int32_t* groups, int32_t grp, void** params) {
 //------------------------------------------------------------------------------
 
 template<typename T1, typename T2>
-static gmapperfn resolve1(int opcode) {
+static reducerfn resolve1(int opcode) {
   switch (opcode) {
-    case OpCode::Mean:  return mean_skipna<T1, T2>;
-    case OpCode::Min:   return min_skipna<T1>;
-    case OpCode::Max:   return max_skipna<T1>;
-    case OpCode::Stdev: return stdev_skipna<T1, T2>;
-    case OpCode::Sum:   return sum_skipna<T1, T2>;
-    case OpCode::Count: return count_skipna<T1, T2>;
-    default:            return nullptr;
+    case OpCode::Mean:
+      return run_reducer<MeanState<T2>, T2, mean_range<T1, T2>>;
+    case OpCode::Min:
+      return run_reducer<MinMaxState<T1, true>, T1, minmax_range<T1, true>>;
+    case OpCode::Max:
+      return run_reducer<MinMaxState<T1, false>, T1, minmax_range<T1, false>>;
+    case OpCode::Stdev:
+      return run_reducer<StdevState<T2>, T2, stdev_range<T1, T2>>;
+    default:
+      return nullptr;
   }
 }
 
 
-static gmapperfn resolve0(int opcode, SType stype) {
+template<typename IT, typename OT>
+static reducerfn resolve_sum() {
+  return run_reducer<SumState<OT>, OT, sum_range<IT, OT>>;
+}
+
+template<typename IT>
+static reducerfn resolve_count() {
+  return run_reducer<CountState, int64_t, count_range<IT>>;
+}
+
+
+static reducerfn resolve0(int opcode, SType stype) {
   if (opcode == OpCode::Sum) {
     switch (stype) {
       case SType::BOOL:
-      case SType::INT8:    return sum_skipna<int8_t, int64_t>;
-      case SType::INT16:   return sum_skipna<int16_t, int64_t>;
-      case SType::INT32:   return sum_skipna<int32_t, int64_t>;
-      case SType::INT64:   return sum_skipna<int64_t, int64_t>;
-      case SType::FLOAT32: return sum_skipna<float, double>;
-      case SType::FLOAT64: return sum_skipna<double, double>;
+      case SType::INT8:    return resolve_sum<int8_t, int64_t>();
+      case SType::INT16:   return resolve_sum<int16_t, int64_t>();
+      case SType::INT32:   return resolve_sum<int32_t, int64_t>();
+      case SType::INT64:   return resolve_sum<int64_t, int64_t>();
+      case SType::FLOAT32: return resolve_sum<float, double>();
+      case SType::FLOAT64: return resolve_sum<double, double>();
       default:             return nullptr;
     }
   }
@@ -260,14 +618,14 @@ static gmapperfn resolve0(int opcode, SType stype) {
   if (opcode == OpCode::Count) {
     switch (stype) {
       case SType::BOOL:
-      case SType::INT8:    return count_skipna<int8_t, int64_t>;
-      case SType::INT16:   return count_skipna<int16_t, int64_t>;
-      case SType::INT32:   return count_skipna<int32_t, int64_t>;
-      case SType::INT64:   return count_skipna<int64_t, int64_t>;
-      case SType::FLOAT32: return count_skipna<float, int64_t>;
-      case SType::FLOAT64: return count_skipna<double, int64_t>;
-      case SType::STR32:   return count_skipna<uint32_t, int64_t>;
-      case SType::STR64:   return count_skipna<uint64_t, int64_t>;
+      case SType::INT8:    return resolve_count<int8_t>();
+      case SType::INT16:   return resolve_count<int16_t>();
+      case SType::INT32:   return resolve_count<int32_t>();
+      case SType::INT64:   return resolve_count<int64_t>();
+      case SType::FLOAT32: return resolve_count<float>();
+      case SType::FLOAT64: return resolve_count<double>();
+      case SType::STR32:   return resolve_count<uint32_t>();
+      case SType::STR64:   return resolve_count<uint64_t>();
       default:             return nullptr;
     }
   }
@@ -286,53 +644,334 @@ static gmapperfn resolve0(int opcode, SType stype) {
 
 
 
+//------------------------------------------------------------------------------
+// Multiple reducers over the same column
+//------------------------------------------------------------------------------
+
+/**
+ * Combined state of all reducers that can be computed together. Here `IT` is
+ * the type of the input column, `ST` is the type used for the "sum" reducer,
+ * and `MT` for the "mean" and "stdev" reducers.
+ */
+template<typename IT, typename ST, typename MT>
+struct MultiState {
+  SumState<ST> sum;
+  MeanState<MT> mean;
+  StdevState<MT> stdev;
+  MinMaxState<IT, true> min;
+  MinMaxState<IT, false> max;
+  int64_t count;
+
+  MultiState() : count(0) {}
+  void merge(const MultiState& o) {
+    sum.merge(o.sum);
+    mean.merge(o.mean);
+    stdev.merge(o.stdev);
+    min.merge(o.min);
+    max.merge(o.max);
+    count += o.count;
+  }
+};
+
+
+/**
+ * Kernel that computes several reductions of contiguous data in a single
+ * pass. The template flags select which accumulators are updated (count is
+ * always computed). Each lane is updated in exactly the same way as in the
+ * kernels of the single reducers, and the lanes are merged in the same
+ * order, so that e.g. `sum(f.X)` has the same value regardless of the other
+ * reducers in the `j` list. The standard deviation has no lanes: the values
+ * are added to its state sequentially, as in `stdev_range()`.
+ */
+template<typename IT, typename ST, typename MT,
+         bool SUM, bool MEAN, bool MINMAX, bool STDEV>
+static DT_KERNEL MultiState<IT, ST, MT> multi_kernel(const IT* x, size_t n) {
+  int64_t cnt[NLANES] = {0};
+  ST sacc[NLANES] = {0};
+  MT macc[NLANES] = {0};
+  MT mdelta[NLANES] = {0};
+  IT vmin[NLANES];
+  IT vmax[NLANES];
+  for (size_t k = 0; k < NLANES; ++k) {
+    vmin[k] = infinity<IT>();
+    vmax[k] = -infinity<IT>();
+  }
+  MultiState<IT, ST, MT> res;
+  size_t i = 0;
+  for (; i + NLANES <= n; i += NLANES) {
+    for (size_t k = 0; k < NLANES; ++k) {
+      IT v = x[i + k];
+      bool isna = ISNA<IT>(v);
+      cnt[k] += !isna;
+      if (SUM) {
+        sacc[k] += isna? ST(0) : static_cast<ST>(v);
+      }
+      if (MEAN) {
+        MT y = (isna? MT(0) : static_cast<MT>(v)) - mdelta[k];
+        MT t = macc[k] + y;
+        mdelta[k] = isna? mdelta[k] : (t - macc[k]) - y;
+        macc[k] = isna? macc[k] : t;
+      }
+      if (MINMAX) {
+        vmin[k] = (v < vmin[k] && !isna)? v : vmin[k];
+        vmax[k] = (v > vmax[k] && !isna)? v : vmax[k];
+      }
+      if (STDEV) {
+        if (!isna) res.stdev.add(v);
+      }
+    }
+  }
+  // The tail of the "sum" goes into the first lane before the lanes are
+  // merged; for the other reducers it is added to the merged state.
+  size_t itail = i;
+  for (; i < n; ++i) {
+    if (ISNA<IT>(x[i])) continue;
+    res.count++;
+    if (SUM) sacc[0] += static_cast<ST>(x[i]);
+  }
+  for (size_t k = 0; k < NLANES; ++k) {
+    res.count += cnt[k];
+    if (SUM) res.sum.sum += sacc[k];
+    if (MEAN) {
+      MeanState<MT> lane;
+      lane.sum = macc[k];
+      lane.delta = mdelta[k];
+      lane.count = cnt[k];
+      res.mean.merge(lane);
+    }
+    if (MINMAX) {
+      MinMaxState<IT, true> lmin;
+      lmin.value = vmin[k];
+      lmin.count = cnt[k];
+      res.min.merge(lmin);
+      MinMaxState<IT, false> lmax;
+      lmax.value = vmax[k];
+      lmax.count = cnt[k];
+      res.max.merge(lmax);
+    }
+  }
+  for (i = itail; i < n; ++i) {
+    IT v = x[i];
+    if (ISNA<IT>(v)) continue;
+    if (MEAN) res.mean.add(static_cast<MT>(v));
+    if (MINMAX) {
+      res.min.add(v);
+      res.max.add(v);
+    }
+    if (STDEV) res.stdev.add(v);
+  }
+  return res;
+}
+
+
+template<typename IT, typename ST, typename MT,
+         bool SUM, bool MEAN, bool MINMAX, bool STDEV>
+DT_TARGET_AVX2 static MultiState<IT, ST, MT> multi_avx2(const IT* x,
+                                                        size_t n) {
+  return multi_kernel<IT, ST, MT, SUM, MEAN, MINMAX, STDEV>(x, n);
+}
+
+
+template<typename IT, typename ST, typename MT, int FLAGS>
+static MultiState<IT, ST, MT> multi_contiguous(const IT* x, size_t n) {
+  constexpr bool SUM = FLAGS & 1;
+  constexpr bool MEAN = FLAGS & 2;
+  constexpr bool MINMAX = FLAGS & 4;
+  constexpr bool STDEV = FLAGS & 8;
+  return cpu_has_avx2()
+         ? multi_avx2<IT, ST, MT, SUM, MEAN, MINMAX, STDEV>(x, n)
+         : multi_kernel<IT, ST, MT, SUM, MEAN, MINMAX, STDEV>(x, n);
+}
+
+
+template<typename IT, typename ST, typename MT>
+using multifn = MultiState<IT, ST, MT> (*)(const IT*, size_t);
+
+// Select the kernel for the given combination of flags
+// `SUM | MEAN << 1 | MINMAX << 2 | STDEV << 3`.
+template<typename IT, typename ST, typename MT>
+static multifn<IT, ST, MT> resolve_multi_kernel(int flags) {
+  static const multifn<IT, ST, MT> kernels[16] = {
+    multi_contiguous<IT, ST, MT, 0>,  multi_contiguous<IT, ST, MT, 1>,
+    multi_contiguous<IT, ST, MT, 2>,  multi_contiguous<IT, ST, MT, 3>,
+    multi_contiguous<IT, ST, MT, 4>,  multi_contiguous<IT, ST, MT, 5>,
+    multi_contiguous<IT, ST, MT, 6>,  multi_contiguous<IT, ST, MT, 7>,
+    multi_contiguous<IT, ST, MT, 8>,  multi_contiguous<IT, ST, MT, 9>,
+    multi_contiguous<IT, ST, MT, 10>, multi_contiguous<IT, ST, MT, 11>,
+    multi_contiguous<IT, ST, MT, 12>, multi_contiguous<IT, ST, MT, 13>,
+    multi_contiguous<IT, ST, MT, 14>, multi_contiguous<IT, ST, MT, 15>,
+  };
+  return kernels[flags];
+}
+
+
+/**
+ * Reducer that computes all reductions `opcodes` of a single column, reading
+ * its values only once. Only the accumulators for the requested reductions
+ * are updated. When the rows of a range are contiguous, they are reduced
+ * with the vectorized `multi_kernel()`.
+ */
+template<typename IT, typename ST, typename MT>
+class MultiReducer {
+  private:
+    const Column* col;
+    const std::vector<int>& opcodes;
+    const std::vector<Column*>& outs;
+    multifn<IT, ST, MT> kernel;
+    bool need_sum, need_mean, need_stdev, need_min, need_max;
+    size_t : 24;
+
+  public:
+    using state_t = MultiState<IT, ST, MT>;
+
+    MultiReducer(const Column* c, const std::vector<int>& ops,
+                 const std::vector<Column*>& o)
+      : col(c), opcodes(ops), outs(o), need_sum(false), need_mean(false),
+        need_stdev(false), need_min(false), need_max(false)
+    {
+      for (int op : opcodes) {
+        need_sum   |= (op == OpCode::Sum);
+        need_mean  |= (op == OpCode::Mean);
+        need_stdev |= (op == OpCode::Stdev);
+        need_min   |= (op == OpCode::Min);
+        need_max   |= (op == OpCode::Max);
+      }
+      int flags = (need_sum? 1 : 0) | (need_mean? 2 : 0) |
+                  (need_min || need_max? 4 : 0) | (need_stdev? 8 : 0);
+      kernel = resolve_multi_kernel<IT, ST, MT>(flags);
+    }
+
+    state_t reduce(size_t row0, size_t row1) const {
+      const IT* x;
+      if (contiguous_range(col, row0, &x)) {
+        return kernel(x, row1 - row0);
+      }
+      const IT* inputs = static_cast<const IT*>(col->data());
+      state_t st;
+      col->rowindex().iterate(row0, row1, 1,
+        [&](size_t, size_t j) {
+          if (j == RowIndex::NA) return;
+          IT x = inputs[j];
+          if (ISNA<IT>(x)) return;
+          st.count++;
+          if (need_sum) st.sum.sum += static_cast<ST>(x);
+          if (need_mean) st.mean.add(static_cast<MT>(x));
+          if (need_stdev) st.stdev.add(x);
+          if (need_min) st.min.add(x);
+          if (need_max) st.max.add(x);
+        });
+      return st;
+    }
+
+    void store(size_t grp, const state_t& st) const {
+      for (size_t k = 0; k < opcodes.size(); ++k) {
+        void* out = outs[k]->data_w();
+        switch (opcodes[k]) {
+          case OpCode::Sum:   static_cast<ST*>(out)[grp] = st.sum.get(); break;
+          case OpCode::Count: static_cast<int64_t*>(out)[grp] = st.count; break;
+          case OpCode::Mean:  static_cast<MT*>(out)[grp] = st.mean.get(); break;
+          case OpCode::Stdev: static_cast<MT*>(out)[grp] = st.stdev.get(); break;
+          case OpCode::Min:   static_cast<IT*>(out)[grp] = st.min.get(); break;
+          case OpCode::Max:   static_cast<IT*>(out)[grp] = st.max.get(); break;
+        }
+      }
+    }
+};
+
+
+template<typename IT, typename ST, typename MT>
+static void multi_reduce(const Groupby& groupby, const Column* col,
+                         const std::vector<int>& opcodes,
+                         const std::vector<Column*>& outs)
+{
+  reduce_groupby(MultiReducer<IT, ST, MT>(col, opcodes, outs), groupby,
+                 col->nrows);
+}
+
+
+
 //------------------------------------------------------------------------------
 // External API
 //------------------------------------------------------------------------------
 
+static SType result_stype(int opcode, SType arg_type) {
+  if (opcode == OpCode::Sum) {
+    return (arg_type == SType::FLOAT32 || arg_type == SType::FLOAT64)
+           ? SType::FLOAT64 : SType::INT64;
+  }
+  if (opcode == OpCode::Count) return SType::INT64;
+  return opcode == OpCode::Min || opcode == OpCode::Max ||
+         arg_type == SType::FLOAT32 ? arg_type : SType::FLOAT64;
+}
+
 Column* reduceop(int opcode, Column* arg, const Groupby& groupby)
 {
   if (opcode == OpCode::First) {
     return reduce_first(arg, groupby);
   }
   SType arg_type = arg->stype();
-  SType res_type = opcode == OpCode::Min || opcode == OpCode::Max ||
-                   arg_type == SType::FLOAT32 ? arg_type : SType::FLOAT64;
-  if (opcode == OpCode::Sum) {
-    if (arg_type == SType::FLOAT32 || arg_type == SType::FLOAT64) {
-      res_type = SType::FLOAT64;
-    } else {
-      res_type = SType::INT64;
-    }
-  }
-
-  if (opcode == OpCode::Count) {
-    res_type = SType::INT64;
-  }
+  SType res_type = result_stype(opcode, arg_type);
 
-  int32_t ngrps = static_cast<int32_t>(groupby.ngroups());
+  size_t ngrps = groupby.ngroups();
   if (ngrps == 0) ngrps = 1;
 
-  void* params[2];
-  params[0] = arg;
-  params[1] = Column::new_data_column(res_type, static_cast<size_t>(ngrps));
-
-  gmapperfn fn = resolve0(opcode, arg_type);
+  reducerfn fn = resolve0(opcode, arg_type);
   if (!fn) {
     throw RuntimeError()
       << "Unable to apply reduce function " << opcode
       << " to column(stype=" << arg_type << ")";
   }
+  Column* res = Column::new_data_column(res_type, ngrps);
+  (*fn)(arg, res, groupby);
+  return res;
+}
 
-  int32_t _grps[2] = {0, static_cast<int32_t>(arg->nrows)};
-  const int32_t* grps = ngrps == 1? _grps : groupby.offsets_r();
+bool can_reduce_together(int opcode, SType arg_type) {
+  bool numeric = arg_type == SType::BOOL || arg_type == SType::INT8 ||
+                 arg_type == SType::INT16 || arg_type == SType::INT32 ||
+                 arg_type == SType::INT64 || arg_type == SType::FLOAT32 ||
+                 arg_type == SType::FLOAT64;
+  return numeric && opcode != OpCode::First &&
+         opcode >= OpCode::Mean && opcode <= OpCode::Count;
+}
 
-  #pragma omp parallel for schedule(static)
-  for (int32_t g = 0; g < ngrps; ++g) {
-    (*fn)(grps, g, params);
-  }
 
-  return static_cast<Column*>(params[1]);
+std::vector<Column*> reduceops(const std::vector<int>& opcodes, Column* arg,
+                               const Groupby& groupby)
+{
+  SType arg_type = arg->stype();
+  size_t ngrps = groupby.ngroups();
+  if (ngrps == 0) ngrps = 1;
+  std::vector<Column*> outs;
+  for (int op : opcodes) {
+    xassert(can_reduce_together(op, arg_type));
+    outs.push_back(
+        Column::new_data_column(result_stype(op, arg_type), ngrps));
+  }
+  switch (arg_type) {
+    case SType::BOOL:
+    case SType::INT8:
+      multi_reduce<int8_t, int64_t, double>(groupby, arg, opcodes, outs);
+      break;
+    case SType::INT16:
+      multi_reduce<int16_t, int64_t, double>(groupby, arg, opcodes, outs);
+      break;
+    case SType::INT32:
+      multi_reduce<int32_t, int64_t, double>(groupby, arg, opcodes, outs);
+      break;
+    case SType::INT64:
+      multi_reduce<int64_t, int64_t, double>(groupby, arg, opcodes, outs);
+      break;
+    case SType::FLOAT32:
+      multi_reduce<float, double, float>(groupby, arg, opcodes, outs);
+      break;
+    case SType::FLOAT64:
+      multi_reduce<double, double, double>(groupby, arg, opcodes, outs);
+      break;
+    default:
+      xassert(false);  // LCOV_EXCL_LINE
+  }
+  return outs;
 }
 
 };  // namespace expr
@@ -21,6 +21,7 @@
 //------------------------------------------------------------------------------
 #include <regex>
 #include "expr/base_expr.h"
+#include "expr/cse.h"
 #include "utils/exceptions.h"
 
 namespace dt {
@@ -54,6 +55,8 @@ class expr_string_match_re : public base_expr {
     SType resolve(const workframe& wf) override;
     GroupbyMode get_groupby_mode(const workframe&) const override;
     Column* evaluate_eager(workframe& wf) override;
+    size_t hash(cse_table&, const workframe&) override;
+    bool equals(const base_expr&, const cse_table&) const override;
 
   private:
     template <typename T>
@@ -104,7 +107,7 @@ GroupbyMode expr_string_match_re::get_groupby_mode(const workframe& wf) const {
 
 
 Column* expr_string_match_re::evaluate_eager(workframe& wf) {
-  Column* arg_res = arg->evaluate_eager(wf);
+  Column* arg_res = arg->evaluate(wf);
   SType arg_stype = arg_res->stype();
   xassert(arg_stype == SType::STR32 || arg_stype == SType::STR64);
   return arg_stype == SType::STR32? _compute<uint32_t>(arg_res)
@@ -112,6 +115,22 @@ Column* expr_string_match_re::evaluate_eager(workframe& wf) {
 }
 
 
+size_t expr_string_match_re::hash(cse_table& cse, const workframe&) {
+  size_t h = hash_combine(exprCode::STRINGFN,
+                          static_cast<size_t>(strop::RE_MATCH));
+  h = hash_combine(h, hash_murmur2(pattern.data(), pattern.size(), 0));
+  return hash_combine(h, cse.add(arg));
+}
+
+
+bool expr_string_match_re::equals(const base_expr& other,
+                                  const cse_table& cse) const
+{
+  auto o = dynamic_cast<const expr_string_match_re*>(&other);
+  return o && o->pattern == pattern && cse.same(arg, o->arg);
+}
+
+
 template <typename T>
 Column* expr_string_match_re::_compute(Column* src) {
   auto ssrc = dynamic_cast<StringColumn<T>*>(src);
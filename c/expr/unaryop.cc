@@ -28,6 +28,15 @@ static void map_n(int64_t row0, int64_t row1, void** params) {
   }
 }
 
+template<typename IT, typename OT, OT (*OP)(IT)>
+static void block_n(size_t n, const void* x, const void*, void* out) {
+  const IT* arg_data = static_cast<const IT*>(x);
+  OT* res_data = static_cast<OT*>(out);
+  for (size_t i = 0; i < n; ++i) {
+    res_data[i] = OP(arg_data[i]);
+  }
+}
+
 template<typename IT, typename OT, OT (*OP)(IT, IT)>
 static void strmap_n(int64_t row0, int64_t row1, void** params) {
   StringColumn<IT>* col0 = static_cast<StringColumn<IT>*>(params[0]);
@@ -173,23 +182,28 @@ static mapperfn resolve0(SType stype, dt::unop opcode) {
 }
 
 
-Column* unaryop(dt::unop opcode, Column* arg)
-{
-  if (opcode == dt::unop::PLUS) return arg->shallowcopy();
-  arg->reify();
-
-  SType arg_type = arg->stype();
-  SType res_type = arg_type;
+static SType result_stype(dt::unop opcode, SType arg_type) {
   if (opcode == dt::unop::ISNA) {
-    res_type = SType::BOOL;
+    return SType::BOOL;
   } else if (arg_type == SType::BOOL && opcode == dt::unop::MINUS) {
-    res_type = SType::INT8;
+    return SType::INT8;
   } else if (opcode == dt::unop::EXP || opcode == dt::unop::LOGE ||
              opcode == dt::unop::LOG10) {
-    res_type = SType::FLOAT64;
+    return SType::FLOAT64;
   } else if (opcode == dt::unop::LEN) {
-    res_type = arg_type == SType::STR32? SType::INT32 : SType::INT64;
+    return arg_type == SType::STR32? SType::INT32 : SType::INT64;
   }
+  return arg_type;
+}
+
+
+Column* unaryop(dt::unop opcode, Column* arg)
+{
+  if (opcode == dt::unop::PLUS) return arg->shallowcopy();
+  arg->reify();
+
+  SType arg_type = arg->stype();
+  SType res_type = result_stype(opcode, arg_type);
   void* params[2];
   params[0] = arg;
   params[1] = Column::new_data_column(res_type, arg->nrows);
@@ -207,4 +221,84 @@ Column* unaryop(dt::unop opcode, Column* arg)
 }
 
 
+
+//------------------------------------------------------------------------------
+// Kernels for the chunked evaluation
+//------------------------------------------------------------------------------
+
+template<typename IT>
+static blockfn resolve_block1(dt::unop opcode) {
+  switch (opcode) {
+    case dt::unop::ISNA:    return block_n<IT, int8_t, op_isna<IT>>;
+    case dt::unop::MINUS:   return block_n<IT, IT, op_minus<IT>>;
+    case dt::unop::ABS:     return block_n<IT, IT, op_abs<IT>>;
+    case dt::unop::EXP:     return block_n<IT, double, op_exp<IT>>;
+    case dt::unop::LOGE:    return block_n<IT, double, op_loge<IT>>;
+    case dt::unop::LOG10:   return block_n<IT, double, op_log10<IT>>;
+    case dt::unop::INVERT:
+      if (std::is_floating_point<IT>::value) return nullptr;
+      return block_n<IT, IT, Inverse<IT>::impl>;
+    default:                return nullptr;
+  }
+}
+
+
+blockfn unaryop_block(dt::unop opcode, SType arg_type, SType* res_type) {
+  *res_type = result_stype(opcode, arg_type);
+  switch (arg_type) {
+    case SType::BOOL:
+      if (opcode == dt::unop::INVERT) return block_n<int8_t, int8_t, bool_inverse>;
+      return resolve_block1<int8_t>(opcode);
+    case SType::INT8:    return resolve_block1<int8_t>(opcode);
+    case SType::INT16:   return resolve_block1<int16_t>(opcode);
+    case SType::INT32:   return resolve_block1<int32_t>(opcode);
+    case SType::INT64:   return resolve_block1<int64_t>(opcode);
+    case SType::FLOAT32: return resolve_block1<float>(opcode);
+    case SType::FLOAT64: return resolve_block1<double>(opcode);
+    default: break;
+  }
+  return nullptr;
+}
+
+
+// Casts between the numeric stypes, same as `Column::cast()`
+template<typename IT, typename OT>
+inline static OT op_cast(IT x) {
+  return ISNA<IT>(x)? GETNA<OT>() : static_cast<OT>(x);
+}
+
+template<typename IT>
+inline static int8_t op_cast_bool(IT x) {
+  return ISNA<IT>(x)? GETNA<int8_t>() : (x != 0);
+}
+
+template<typename IT>
+static blockfn resolve_cast1(SType res_type) {
+  switch (res_type) {
+    case SType::BOOL:    return block_n<IT, int8_t, op_cast_bool<IT>>;
+    case SType::INT8:    return block_n<IT, int8_t, op_cast<IT, int8_t>>;
+    case SType::INT16:   return block_n<IT, int16_t, op_cast<IT, int16_t>>;
+    case SType::INT32:   return block_n<IT, int32_t, op_cast<IT, int32_t>>;
+    case SType::INT64:   return block_n<IT, int64_t, op_cast<IT, int64_t>>;
+    case SType::FLOAT32: return block_n<IT, float, op_cast<IT, float>>;
+    case SType::FLOAT64: return block_n<IT, double, op_cast<IT, double>>;
+    default:             return nullptr;
+  }
+}
+
+
+blockfn cast_block(SType arg_type, SType res_type) {
+  switch (arg_type) {
+    case SType::BOOL:
+    case SType::INT8:    return resolve_cast1<int8_t>(res_type);
+    case SType::INT16:   return resolve_cast1<int16_t>(res_type);
+    case SType::INT32:   return resolve_cast1<int32_t>(res_type);
+    case SType::INT64:   return resolve_cast1<int64_t>(res_type);
+    case SType::FLOAT32: return resolve_cast1<float>(res_type);
+    case SType::FLOAT64: return resolve_cast1<double>(res_type);
+    default:             return nullptr;
+  }
+}
+
+
 };  // namespace expr
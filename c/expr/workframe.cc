@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>          // std::max_element
 #include "expr/base_expr.h"
 #include "expr/collist.h"
 #include "expr/workframe.h"
@@ -33,9 +34,12 @@ namespace dt {
 workframe::workframe(DataTable* dt) {
   // The source frame must have flag `natural=false` so that `allcols_jn`
   // knows to select all columns from it.
-  frames.push_back(subframe {dt, RowIndex(), false});
+  frames.push_back(subframe {dt, RowIndex(), 0.0, false, false,
+                             JoinType::LEFT, AsofType::NONE});
   mode = EvalMode::SELECT;
   groupby_mode = GroupbyMode::NONE;
+  cse = nullptr;
+  coalesced_init = false;
 }
 
 
@@ -56,7 +60,8 @@ GroupbyMode workframe::get_groupby_mode() const {
 
 void workframe::add_join(py::ojoin oj) {
   DataTable* dt = oj.get_datatable();
-  frames.push_back(subframe {dt, RowIndex(), true});
+  frames.push_back(subframe {dt, RowIndex(), oj.get_tolerance(), true,
+                             oj.get_mult_all(), oj.get_how(), oj.get_asof()});
 }
 
 
@@ -92,8 +97,26 @@ void workframe::evaluate() {
   // Compute joins
   DataTable* xdt = frames[0].dt;
   for (size_t i = 1; i < frames.size(); ++i) {
-    DataTable* jdt = frames[i].dt;
-    frames[i].ri = natural_join(xdt, jdt);
+    subframe& jf = frames[i];
+    bool rows_preserved = (jf.how == JoinType::LEFT && !jf.mult_all);
+    if (mode != EvalMode::SELECT && !rows_preserved) {
+      throw ValueError() << "Only a left join with mult='first' can be used "
+          "when updating or deleting values in a Frame";
+    }
+    // If a previous join has already changed the rows of the source frame,
+    // then this join is applied to the rows selected so far.
+    dtptr xview;
+    if (frames[0].ri) {
+      xview = dtptr(::apply_rowindex(xdt, frames[0].ri));
+    }
+    auto ris = natural_join(xview? xview.get() : xdt, jf.dt,
+                            jf.how, jf.mult_all, jf.asof, jf.tolerance);
+    if (ris.first) {
+      for (size_t k = 0; k < i; ++k) {
+        frames[k].ri = ris.first * frames[k].ri;
+      }
+    }
+    jf.ri = std::move(ris.second);
   }
 
   // Compute groupby
@@ -119,10 +142,12 @@ void workframe::evaluate() {
       break;
 
     case EvalMode::DELETE:
+      xdt->reset_indices();
       jexpr->delete_(*this);
       break;
 
     case EvalMode::UPDATE:
+      xdt->reset_indices();
       jexpr->update(*this, repl.get());
       break;
   }
@@ -190,6 +215,10 @@ bool workframe::is_naturally_joined(size_t i) const {
   return frames[i].natural;
 }
 
+JoinType workframe::get_join_type(size_t i) const {
+  return frames[i].how;
+}
+
 bool workframe::has_groupby() const {
   return bool(byexpr);
 }
@@ -206,6 +235,11 @@ size_t workframe::nrows() const {
 }
 
 
+cse_table* workframe::get_cse() const {
+  return cse;
+}
+
+
 void workframe::apply_rowindex(const RowIndex& ri) {
   for (size_t i = 0; i < frames.size(); ++i) {
     frames[i].ri = ri * frames[i].ri;
@@ -214,7 +248,7 @@ void workframe::apply_rowindex(const RowIndex& ri) {
 
 
 void workframe::apply_groupby(const Groupby& gb_) {
-  xassert(static_cast<size_t>(gb_.offsets_r()[gb_.ngroups()]) == nrows());
+  xassert(gb_.last_offset() == nrows());
   gb = gb_;
 }
 
@@ -244,6 +278,113 @@ void workframe::add_column(
 }
 
 
+// Create an array RowIndex from the list of row numbers `rows`, choosing the
+// 32- or 64-bit storage depending on the largest row number.
+static RowIndex _make_rowindex(const intvec& rows, bool sorted) {
+  size_t n = rows.size();
+  size_t maxrow = n? *std::max_element(rows.begin(), rows.end()) : 0;
+  if (maxrow <= static_cast<size_t>(INT32_MAX) &&
+      n <= static_cast<size_t>(INT32_MAX)) {
+    arr32_t arr(n);
+    for (size_t i = 0; i < n; ++i) arr[i] = static_cast<int32_t>(rows[i]);
+    return RowIndex(std::move(arr), sorted);
+  } else {
+    arr64_t arr(n);
+    for (size_t i = 0; i < n; ++i) arr[i] = static_cast<int64_t>(rows[i]);
+    return RowIndex(std::move(arr), sorted);
+  }
+}
+
+
+/**
+ * In a right or outer join, the result contains rows of the joined frame
+ * that have no match in the source frame, and the source frame's columns are
+ * NA in such rows. For the join columns this is not desirable: in those rows
+ * their values are taken from the corresponding columns of the joined frame
+ * instead (the joined frame's own join columns are not selected). This
+ * applies to any selection of the join column from the source frame: via
+ * `:`, a list of columns, or an `f`-expression.
+ *
+ * Returns the new column for the column `col` of the source frame, or
+ * nullptr if that column does not need to be coalesced. Each column is
+ * coalesced only once per workframe, subsequent calls return its copies.
+ */
+Column* workframe::coalesce_join_column(size_t col) {
+  if (!coalesced_init) _init_coalesced();
+  auto it = coalesced.find(col);
+  if (it == coalesced.end()) return nullptr;
+  coalesced_column& cc = it->second;
+  if (!cc.computed) {
+    cc.column.reset(_coalesce(col, cc));
+    cc.computed = true;
+  }
+  return cc.column? cc.column->shallowcopy() : nullptr;
+}
+
+
+// Find the join columns of the source frame in all right and outer joins.
+// This must be done after the joins have been computed, and the rowindices
+// of the frames are final.
+void workframe::_init_coalesced() {
+  coalesced_init = true;
+  if (!frames[0].ri) return;
+  const DataTable* dt0 = frames[0].dt;
+  for (size_t k = 1; k < frames.size(); ++k) {
+    JoinType how = frames[k].how;
+    if (how != JoinType::RIGHT && how != JoinType::OUTER) continue;
+    intvec xcols, jcols;
+    find_join_columns(dt0, frames[k].dt, xcols, jcols);
+    for (size_t i = 0; i < xcols.size(); ++i) {
+      coalesced_column& cc = coalesced[xcols[i]];
+      cc.sources.push_back({k, jcols[i]});
+      cc.computed = false;
+    }
+  }
+}
+
+
+Column* workframe::_coalesce(size_t col, const coalesced_column& cc) const {
+  const DataTable* dt0 = frames[0].dt;
+  const RowIndex& ri0 = frames[0].ri;
+  size_t nrows = ri0.size();
+  Column* res = nullptr;
+  std::vector<bool> filled;
+  for (const auto& src : cc.sources) {
+    size_t k = src.first;
+    const Column* jcol = frames[k].dt->columns[src.second];
+    const RowIndex& rik = frames[k].ri;
+
+    intvec at, from;
+    for (size_t i = 0; i < nrows; ++i) {
+      if (ri0[i] != RowIndex::NA || (res && filled[i])) continue;
+      size_t r = rik[i];
+      if (r == RowIndex::NA) continue;
+      at.push_back(i);
+      from.push_back(r);
+    }
+    if (at.empty()) continue;
+
+    if (!res) {
+      const Column* xcol = dt0->columns[col];
+      res = xcol->shallowcopy(ri0 * xcol->rowindex());
+      res->reify();
+      filled.resize(nrows);
+    }
+    if (jcol->stype() > res->stype()) {
+      Column* tmp = res->cast(jcol->stype());
+      delete res;
+      res = tmp;
+    }
+    std::unique_ptr<Column> jvals(
+        jcol->shallowcopy(_make_rowindex(from, false) * jcol->rowindex()));
+    jvals->reify();
+    res->replace_values(_make_rowindex(at, true), jvals.get());
+    for (size_t i : at) filled[i] = true;
+  }
+  return res;
+}
+
+
 RowIndex& workframe::_product(const RowIndex& ra, const RowIndex& rb) {
   for (auto it = all_ri.rbegin(); it != all_ri.rend(); ++it) {
     if (it->ab == ra && it->bc == rb) {
@@ -21,6 +21,8 @@
 //------------------------------------------------------------------------------
 #ifndef dt_EXPR_WORKFRAME_h
 #define dt_EXPR_WORKFRAME_h
+#include <memory>            // std::unique_ptr
+#include <unordered_map>     // std::unordered_map
 #include <vector>            // std::vector
 #include "expr/by_node.h"    // py::oby, by_node_ptr
 #include "expr/i_node.h"     // i_node_ptr
@@ -32,12 +34,18 @@
 #include "rowindex.h"        // RowIndex
 namespace dt {
 
+class cse_table;
+
 
 struct subframe {
   DataTable* dt;
   RowIndex ri;
-  bool natural;  // was this frame joined naturally?
-  size_t : 56;
+  double tolerance;  // max distance between the keys in an asof join
+  bool natural;      // was this frame joined naturally?
+  bool mult_all;     // join all matching rows, or only the first one?
+  JoinType how;
+  AsofType asof;
+  size_t : 32;
 };
 using frvec = std::vector<subframe>;
 
@@ -90,6 +98,21 @@ class workframe {
     strvec colnames;
     struct ripair { RowIndex ab, bc, ac; };
     std::vector<ripair> all_ri;
+    cse_table* cse;  // common subexpressions of the list being evaluated
+
+    // Join columns of the source frame that are coalesced in right or outer
+    // joins (see `coalesce_join_column()`): for each such column, the list
+    // of its (frame, column) counterparts in the joined frames, and the
+    // coalesced column once it was computed.
+    struct coalesced_column {
+      std::vector<std::pair<size_t, size_t>> sources;
+      std::unique_ptr<Column> column;
+      bool computed;
+      size_t : 56;
+    };
+    std::unordered_map<size_t, coalesced_column> coalesced;
+    bool coalesced_init;
+    size_t : 56;
 
   public:
     workframe() = delete;
@@ -116,9 +139,11 @@ class workframe {
     const Groupby& get_groupby();
     const by_node& get_by_node() const;
     bool is_naturally_joined(size_t i) const;
+    JoinType get_join_type(size_t i) const;
     bool has_groupby() const;
     size_t nframes() const;
     size_t nrows() const;
+    cse_table* get_cse() const;
 
     void apply_rowindex(const RowIndex& ri);
     void apply_groupby(const Groupby& gb_);
@@ -126,13 +151,17 @@ class workframe {
     size_t size() const noexcept;
     void reserve(size_t n);
     void add_column(const Column*, const RowIndex&, std::string&&);
+    Column* coalesce_join_column(size_t i);
 
   private:
     RowIndex& _product(const RowIndex& ra, const RowIndex& rb);
+    void _init_coalesced();
+    Column* _coalesce(size_t col, const coalesced_column& cc) const;
     void fix_columns();
 
     friend class expr_column;  // Use _product
     friend class by_node;  // Allow access to `gb`
+    friend class cse_table;  // Attaches itself as `cse`
 };
 
 
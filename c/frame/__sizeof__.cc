@@ -64,6 +64,8 @@ size_t DataTable::memory_footprint() const {
   sz += sizeof(*this);
   sz += sizeof(Column*) * columns.capacity();
   sz += sizeof(std::string) * names.capacity();
+  if (join_index) sz += join_index->memory_footprint();
+  if (sort_cache) sz += sort_cache->memory_footprint();
   for (size_t i = 0; i < ncols; ++i) {
     sz += columns[i]->memory_footprint();
     sz += names[i].size();
@@ -166,6 +166,7 @@ void DatatableModule::init_methods_cbind() {
  */
 void DataTable::cbind(const std::vector<DataTable*>& dts)
 {
+  reset_indices();
   size_t t_ncols = ncols;
   size_t t_nrows = nrows;
   for (auto dt : dts) {
@@ -19,6 +19,8 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <cmath>        // std::abs
+#include <cstring>      // std::memcpy
 #include <limits>
 #include <memory>
 #include <type_traits>
@@ -26,6 +28,7 @@
 #include "column.h"
 #include "datatable.h"
 #include "datatablemodule.h"
+#include "models/murmurhash.h"
 #include "options.h"
 #include "py_rowindex.h"
 #include "python/args.h"
@@ -33,6 +36,7 @@
 #include "python/tuple.h"
 #include "types.h"
 #include "utils/assert.h"
+#include "utils/parallel.h"
 
 class Cmp;
 using indvec = std::vector<size_t>;
@@ -67,14 +71,26 @@ static comparator_maker cmps[DT_STYPES_COUNT][DT_STYPES_COUNT];
  *     or 0 depending if the row-value is greater than, less than, or equal
  *     to the value stored.
  *
+ *   hash_xrow() -> uint64_t
+ *     hash of the value from the X frame stored during the previous
+ *     `set_xrow()` call. The value is hashed after it was converted into
+ *     the J frame's type, so that equal values in X and J always produce
+ *     the same hash.
+ *
+ *   hash_jrow(size_t row) -> uint64_t
+ *     hash of the `row`th value in the J frame.
+ *
  * This comparison function is then used as the basis for the binary search
- * algorithm to perform a join between two tables.
+ * algorithm to perform a join between two tables. The hash functions are
+ * used by the hash join, which does not require the J frame to be sorted.
  */
 class Cmp {
   public:
     virtual ~Cmp();
     virtual int cmp_jrow(size_t row) const = 0;
     virtual int set_xrow(size_t row) = 0;
+    virtual uint64_t hash_xrow() const = 0;
+    virtual uint64_t hash_jrow(size_t row) const = 0;
 };
 
 Cmp::~Cmp() {}
@@ -94,6 +110,8 @@ class MultiCmp : public Cmp {
              const DataTable* Xdt, const DataTable* Jdt);
     int set_xrow(size_t row) override;
     int cmp_jrow(size_t row) const override;
+    uint64_t hash_xrow() const override;
+    uint64_t hash_jrow(size_t row) const override;
 };
 
 
@@ -135,6 +153,110 @@ int MultiCmp::cmp_jrow(size_t row) const {
   return 0;
 }
 
+uint64_t MultiCmp::hash_xrow() const {
+  uint64_t h = 0;
+  for (const cmpptr& ch : col_cmps) {
+    h = h * 31 + ch->hash_xrow();
+  }
+  return h;
+}
+
+uint64_t MultiCmp::hash_jrow(size_t row) const {
+  uint64_t h = 0;
+  for (const cmpptr& ch : col_cmps) {
+    h = h * 31 + ch->hash_jrow(row);
+  }
+  return h;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Hashing of individual values
+//------------------------------------------------------------------------------
+
+static constexpr uint64_t NA_HASH = 0x9E3779B97F4A7C15ULL;
+
+// Finalization mix from the Murmur3 hash: forces all bits of `k` to avalanche
+static inline uint64_t mix64(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+/**
+ * Hash a single fixed-width value. All NAs hash to the same value, and so do
+ * the floating-point zeros `0.0` and `-0.0`, since they compare equal.
+ */
+template <typename T>
+static inline uint64_t hash_fw(T value) {
+  if (ISNA<T>(value)) return NA_HASH;
+  if (std::is_integral<T>::value) {
+    return mix64(static_cast<uint64_t>(static_cast<int64_t>(value)));
+  }
+  double dvalue = static_cast<double>(value);
+  if (dvalue == 0) dvalue = 0;
+  uint64_t bits;
+  std::memcpy(&bits, &dvalue, sizeof(double));
+  return mix64(bits);
+}
+
+static inline uint64_t hash_str(const uint8_t* ch, size_t len) {
+  return hash_murmur2(ch, len, 0);
+}
+
+
+
+//------------------------------------------------------------------------------
+// RowMap
+//------------------------------------------------------------------------------
+
+/**
+ * Translates the row numbers of a column into the indices within its data
+ * buffer, according to the column's RowIndex. This allows the comparators to
+ * read the values of a view column directly, without materializing it first.
+ * Rows that the RowIndex maps to NA are mapped to `RowIndex::NA` here, and
+ * the comparators treat them as NA values.
+ */
+class RowMap {
+  private:
+    const int32_t* ind32;
+    const int64_t* ind64;
+    size_t start;
+    size_t step;
+
+  public:
+    explicit RowMap(const RowIndex& ri);
+    size_t operator[](size_t row) const;
+};
+
+
+RowMap::RowMap(const RowIndex& ri)
+  : ind32(nullptr), ind64(nullptr), start(0), step(1)
+{
+  if (ri.isarr32()) ind32 = ri.indices32();
+  else if (ri.isarr64()) ind64 = ri.indices64();
+  else if (ri.isslice()) {
+    start = ri.slice_start();
+    step = ri.slice_step();
+  }
+}
+
+inline size_t RowMap::operator[](size_t row) const {
+  if (ind32) {
+    int32_t r = ind32[row];
+    return r < 0? RowIndex::NA : static_cast<size_t>(r);
+  }
+  if (ind64) {
+    int64_t r = ind64[row];
+    return r < 0? RowIndex::NA : static_cast<size_t>(r);
+  }
+  return start + row * step;
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -146,20 +268,28 @@ class FwCmp : public Cmp {
   private:
     const TX* dataX;
     const TJ* dataJ;
+    RowMap mapX;
+    RowMap mapJ;
     TJ x_value;  // Current value from X frame, converted to TJ type
     size_t : (64 - 8 * sizeof(TJ)) & 63;
 
+    TJ get_jvalue(size_t row) const;
+
   public:
     FwCmp(const Column*, const Column*);
     static cmpptr make(const Column*, const Column*);
 
     int cmp_jrow(size_t row) const override;
     int set_xrow(size_t row) override;
+    uint64_t hash_xrow() const override;
+    uint64_t hash_jrow(size_t row) const override;
 };
 
 
 template <typename TX, typename TJ>
-FwCmp<TX, TJ>::FwCmp(const Column* xcol, const Column* jcol) {
+FwCmp<TX, TJ>::FwCmp(const Column* xcol, const Column* jcol)
+  : mapX(xcol->rowindex()), mapJ(jcol->rowindex())
+{
   auto xcol_f = dynamic_cast<const FwColumn<TX>*>(xcol);
   auto jcol_f = dynamic_cast<const FwColumn<TJ>*>(jcol);
   xassert(xcol_f && jcol_f);
@@ -173,9 +303,16 @@ cmpptr FwCmp<TX, TJ>::make(const Column* col1, const Column* col2) {
 }
 
 
+template <typename TX, typename TJ>
+inline TJ FwCmp<TX, TJ>::get_jvalue(size_t row) const {
+  size_t j = mapJ[row];
+  return j == RowIndex::NA? GETNA<TJ>() : dataJ[j];
+}
+
+
 template <typename TX, typename TJ>
 int FwCmp<TX, TJ>::cmp_jrow(size_t row) const {
-  TJ jval = dataJ[row];
+  TJ jval = get_jvalue(row);
   return (jval > x_value) - (jval < x_value) +
          (std::is_integral<TJ>::value? 0 : ISNA<TJ>(x_value) - ISNA<TJ>(jval));
 }
@@ -183,7 +320,8 @@ int FwCmp<TX, TJ>::cmp_jrow(size_t row) const {
 
 template <typename TX, typename TJ>
 int FwCmp<TX, TJ>::set_xrow(size_t row) {
-  TX newval = dataX[row];
+  size_t i = mapX[row];
+  TX newval = i == RowIndex::NA? GETNA<TX>() : dataX[i];
   if (ISNA<TX>(newval)) {
     x_value = GETNA<TJ>();
   } else {
@@ -207,6 +345,18 @@ int FwCmp<TX, TJ>::set_xrow(size_t row) {
 }
 
 
+template <typename TX, typename TJ>
+uint64_t FwCmp<TX, TJ>::hash_xrow() const {
+  return hash_fw<TJ>(x_value);
+}
+
+
+template <typename TX, typename TJ>
+uint64_t FwCmp<TX, TJ>::hash_jrow(size_t row) const {
+  return hash_fw<TJ>(get_jvalue(row));
+}
+
+
 
 //------------------------------------------------------------------------------
 // String Cmp
@@ -219,21 +369,29 @@ class StringCmp : public Cmp {
     const uint8_t* strdataJ;
     const TX* offsetsX;
     const TJ* offsetsJ;
+    RowMap mapX;
+    RowMap mapJ;
     TX xstart;
     TX xend;
     size_t : (128 - 2 * 8 * sizeof(TJ)) & 63;
 
+    void get_jrange(size_t row, TJ* start, TJ* end) const;
+
   public:
     StringCmp(const Column*, const Column*);
     static cmpptr make(const Column*, const Column*);
 
     int cmp_jrow(size_t row) const override;
     int set_xrow(size_t row) override;
+    uint64_t hash_xrow() const override;
+    uint64_t hash_jrow(size_t row) const override;
 };
 
 
 template <typename TX, typename TJ>
-StringCmp<TX, TJ>::StringCmp(const Column* xcol, const Column* jcol) {
+StringCmp<TX, TJ>::StringCmp(const Column* xcol, const Column* jcol)
+  : mapX(xcol->rowindex()), mapJ(jcol->rowindex())
+{
   auto xcol_s = dynamic_cast<const StringColumn<TX>*>(xcol);
   auto jcol_s = dynamic_cast<const StringColumn<TJ>*>(jcol);
   xassert(xcol_s && jcol_s);
@@ -249,13 +407,30 @@ cmpptr StringCmp<TX, TJ>::make(const Column* col1, const Column* col2) {
 }
 
 
+// Retrieve the offsets of the string in row `row` of the J column; the end
+// offset is NA if the string is NA.
+template <typename TX, typename TJ>
+inline void StringCmp<TX, TJ>::get_jrange(size_t row, TJ* start, TJ* end)
+  const
+{
+  size_t j = mapJ[row];
+  if (j == RowIndex::NA) {
+    *start = 0;
+    *end = GETNA<TJ>();
+  } else {
+    *start = offsetsJ[j - 1] & ~GETNA<TJ>();
+    *end = offsetsJ[j];
+  }
+}
+
+
 template <typename TX, typename TJ>
 int StringCmp<TX, TJ>::cmp_jrow(size_t row) const {
-  TJ jend = offsetsJ[row];
+  TJ jstart, jend;
+  get_jrange(row, &jstart, &jend);
   if (ISNA<TJ>(jend)) return ISNA<TX>(xend) - 1;
   if (ISNA<TX>(xend)) return 1;
 
-  TJ jstart = offsetsJ[row - 1] & ~GETNA<TJ>();
   TJ jlen = jend - jstart;
   TX xlen = xend - xstart;
   const uint8_t* xstr = strdataX + xstart;
@@ -274,12 +449,34 @@ int StringCmp<TX, TJ>::cmp_jrow(size_t row) const {
 
 template <typename TX, typename TJ>
 int StringCmp<TX, TJ>::set_xrow(size_t row) {
-  xend   = offsetsX[row];
-  xstart = offsetsX[row - 1] & ~GETNA<TX>();
+  size_t i = mapX[row];
+  if (i == RowIndex::NA) {
+    xstart = 0;
+    xend = GETNA<TX>();
+  } else {
+    xend   = offsetsX[i];
+    xstart = offsetsX[i - 1] & ~GETNA<TX>();
+  }
   return 0;
 }
 
 
+template <typename TX, typename TJ>
+uint64_t StringCmp<TX, TJ>::hash_xrow() const {
+  if (ISNA<TX>(xend)) return NA_HASH;
+  return hash_str(strdataX + xstart, static_cast<size_t>(xend - xstart));
+}
+
+
+template <typename TX, typename TJ>
+uint64_t StringCmp<TX, TJ>::hash_jrow(size_t row) const {
+  TJ jstart, jend;
+  get_jrange(row, &jstart, &jend);
+  if (ISNA<TJ>(jend)) return NA_HASH;
+  return hash_str(strdataJ + jstart, static_cast<size_t>(jend - jstart));
+}
+
+
 
 //------------------------------------------------------------------------------
 // Comparators for different stypes
@@ -357,11 +554,291 @@ static void _init_comparators() {
 
 
 
+//------------------------------------------------------------------------------
+// Hash index
+//------------------------------------------------------------------------------
+
+/**
+ * Open-addressing hash table over the rows of the J frame, keyed by the
+ * values in the join columns `jcols`. Each slot of the table stores the index
+ * of a row in J, or -1 if the slot is empty. When the J frame contains
+ * duplicate keys, only the first of the duplicate rows is stored. The row
+ * indices are stored as type `T`, which is `int64_t` only for J frames with
+ * more than INT32_MAX rows.
+ *
+ * The table is built in parallel: each thread inserts its rows into the
+ * shared array of slots using compare-and-swap, and the comparisons between
+ * J rows are done via a MultiCmp of the J frame with itself. The table is
+ * at most half full, so that linear probing remains short.
+ *
+ * Once built, the index is cached in the J frame (see `DataTable::join_index`)
+ * and reused by all subsequent joins on the same columns, until the frame is
+ * modified.
+ */
+template <typename T>
+class HashIndex : public JoinIndex {
+  private:
+    dt::array<T> slots;
+    size_t mask;
+    dt::array<T> heads;   // for each row in J, the first row with the same key
+    dt::array<T> nexts;   // for each row in J, the next row with the same key
+    dt::array<T> counts;  // for each first row, the number of rows with its key
+
+  public:
+    HashIndex(const indvec& jcols, const DataTable* jdt);
+    size_t find(const Cmp* cmp) const;
+
+    size_t memory_footprint() const override;
+
+    void build_groups(const indvec& jcols, const DataTable* jdt);
+    size_t head(size_t row) const;
+    size_t next(size_t row) const;
+    size_t group_size(size_t row) const;
+};
+
+
+JoinIndex::~JoinIndex() {}
+
+
+template <typename T>
+HashIndex<T>::HashIndex(const indvec& jcols, const DataTable* jdt) {
+  cols = jcols;
+  size_t nrows = jdt->nrows;
+  size_t capacity = 16;
+  while (capacity < 2 * nrows) capacity <<= 1;
+  mask = capacity - 1;
+  slots.resize(capacity);
+  T* slots_data = slots.data();
+  std::memset(slots_data, 0xFF, capacity * sizeof(T));  // fill with -1
+
+  size_t nth = std::min(std::max(nrows / 1000, size_t(1)),
+                        static_cast<size_t>(config::nthreads));
+  OmpExceptionManager oem;
+  #pragma omp parallel num_threads(nth)
+  {
+    try {
+      MultiCmp comparator(jcols, jcols, jdt, jdt);
+
+      #pragma omp for
+      for (size_t j = 0; j < nrows; ++j) {
+        T jrow = static_cast<T>(j);
+        comparator.set_xrow(j);
+        size_t islot = comparator.hash_xrow() & mask;
+        while (true) {
+          T curr;
+          #pragma omp atomic read
+          curr = slots_data[islot];
+          if (curr == -1) {
+            curr = __sync_val_compare_and_swap(slots_data + islot, -1, jrow);
+            if (curr == -1) break;
+          }
+          if (comparator.cmp_jrow(static_cast<size_t>(curr)) == 0) {
+            // Duplicate key: keep the row that comes first in J
+            while (jrow < curr) {
+              T prev =
+                  __sync_val_compare_and_swap(slots_data + islot, curr, jrow);
+              if (prev == curr) break;
+              curr = prev;
+            }
+            break;
+          }
+          islot = (islot + 1) & mask;
+        }
+      }
+    } catch (...) {
+      oem.capture_exception();
+    }
+  }
+  oem.rethrow_exception_if_any();
+}
+
+
+/**
+ * Find the row in J that matches the value stored in the comparator by the
+ * last `set_xrow()` call; or return `RowIndex::NA` if there is no such row.
+ */
+template <typename T>
+size_t HashIndex<T>::find(const Cmp* cmp) const {
+  size_t islot = cmp->hash_xrow() & mask;
+  while (true) {
+    T jrow = slots[islot];
+    if (jrow == -1) return RowIndex::NA;
+    if (cmp->cmp_jrow(static_cast<size_t>(jrow)) == 0) {
+      return static_cast<size_t>(jrow);
+    }
+    islot = (islot + 1) & mask;
+  }
+}
+
+
+// Approximate size of the index in memory, in bytes
+template <typename T>
+size_t HashIndex<T>::memory_footprint() const {
+  return sizeof(*this) + cols.size() * sizeof(size_t) +
+         (slots.size() + heads.size() + nexts.size() + counts.size()) *
+         sizeof(T);
+}
+
+
+/**
+ * Link together all rows in J that have the same key. This is needed when
+ * the join has to produce all matching rows for each row in X, not only the
+ * first one. After this call, the rows of each group can be traversed via
+ * `next()`, starting from the group's first row (which is the row returned
+ * by `find()`).
+ *
+ * The lookup of each row's group is done in parallel; the rows are then
+ * linked in a single sequential pass, so that within each group they
+ * remain in the same order as in J. The groups are built only once for an
+ * index that is cached in the J frame.
+ */
+template <typename T>
+void HashIndex<T>::build_groups(const indvec& jcols, const DataTable* jdt) {
+  size_t nrows = jdt->nrows;
+  if (heads.size() == nrows && nrows) return;  // already built
+  heads.resize(nrows);
+  nexts.resize(nrows);
+  counts.resize(nrows);
+  T* heads_data = heads.data();
+  T* nexts_data = nexts.data();
+  T* counts_data = counts.data();
+
+  size_t nth = std::min(std::max(nrows / 1000, size_t(1)),
+                        static_cast<size_t>(config::nthreads));
+  OmpExceptionManager oem;
+  #pragma omp parallel num_threads(nth)
+  {
+    try {
+      MultiCmp comparator(jcols, jcols, jdt, jdt);
+
+      #pragma omp for
+      for (size_t j = 0; j < nrows; ++j) {
+        comparator.set_xrow(j);
+        heads_data[j] = static_cast<T>(find(&comparator));
+      }
+    } catch (...) {
+      oem.capture_exception();
+    }
+  }
+  oem.rethrow_exception_if_any();
+
+  // `tails[h]` is the last row linked so far into the group with head `h`.
+  // Since the head is the smallest row in its group, it is always visited
+  // before the other rows of the same group.
+  dt::array<T> tails(nrows);
+  T* tails_data = tails.data();
+  for (size_t j = 0; j < nrows; ++j) {
+    T jrow = static_cast<T>(j);
+    size_t h = static_cast<size_t>(heads_data[j]);
+    nexts_data[j] = -1;
+    if (h == j) {
+      counts_data[j] = 1;
+    } else {
+      nexts_data[tails_data[h]] = jrow;
+      counts_data[h]++;
+    }
+    tails_data[h] = jrow;
+  }
+}
+
+
+template <typename T>
+inline size_t HashIndex<T>::head(size_t row) const {
+  return static_cast<size_t>(heads[row]);
+}
+
+template <typename T>
+inline size_t HashIndex<T>::next(size_t row) const {
+  T r = nexts[row];
+  return r == -1? RowIndex::NA : static_cast<size_t>(r);
+}
+
+template <typename T>
+inline size_t HashIndex<T>::group_size(size_t row) const {
+  return static_cast<size_t>(counts[row]);
+}
+
+
+
+//------------------------------------------------------------------------------
+// RowHashSet
+//------------------------------------------------------------------------------
+
+/**
+ * Growable hash set of rows of a frame, used for grouping the rows of a
+ * single frame. Unlike `HashIndex`, whose size is proportional to the number
+ * of rows in the frame, this table grows with the number of distinct values
+ * added to it, which makes it suitable for building small per-thread tables.
+ *
+ * The rows are compared via a comparator of the frame with itself; the hash
+ * of each stored row is kept alongside the row, so that the table can be
+ * resized without recomputing the hashes.
+ */
+class RowHashSet {
+  private:
+    std::vector<int32_t> rows;  // -1 marks an empty slot
+    std::vector<uint64_t> hashes;
+    size_t mask;
+    size_t count;
+
+  public:
+    RowHashSet();
+    int32_t insert(const Cmp* cmp, uint64_t hash, int32_t row);
+
+  private:
+    void grow();
+};
+
+
+RowHashSet::RowHashSet()
+  : rows(64, -1), hashes(64), mask(63), count(0) {}
+
+
+/**
+ * Find the row whose value is equal to the value stored in the comparator by
+ * the last `set_xrow()` call, or add `row` (which must be that row) if there
+ * is no such row yet. Returns the row found or added.
+ */
+int32_t RowHashSet::insert(const Cmp* cmp, uint64_t hash, int32_t row) {
+  size_t islot = hash & mask;
+  while (true) {
+    int32_t r = rows[islot];
+    if (r == -1) break;
+    if (hashes[islot] == hash && cmp->cmp_jrow(static_cast<size_t>(r)) == 0) {
+      return r;
+    }
+    islot = (islot + 1) & mask;
+  }
+  rows[islot] = row;
+  hashes[islot] = hash;
+  if (++count * 2 > rows.size()) grow();
+  return row;
+}
+
+
+void RowHashSet::grow() {
+  size_t capacity = rows.size() * 2;
+  std::vector<int32_t> oldrows(capacity, -1);
+  std::vector<uint64_t> oldhashes(capacity);
+  oldrows.swap(rows);
+  oldhashes.swap(hashes);
+  mask = capacity - 1;
+  for (size_t i = 0; i < oldrows.size(); ++i) {
+    if (oldrows[i] == -1) continue;
+    size_t islot = oldhashes[i] & mask;
+    while (rows[islot] != -1) islot = (islot + 1) & mask;
+    rows[islot] = oldrows[i];
+    hashes[islot] = oldhashes[i];
+  }
+}
+
+
+
 //------------------------------------------------------------------------------
 // Join functionality
 //------------------------------------------------------------------------------
 
-static size_t binsearch(Cmp* cmp, size_t nrows) {
+static size_t binsearch(const Cmp* cmp, size_t nrows) {
   // Use unsigned indices in order to avoid overflows
   size_t start = 0;
   size_t end   = nrows - 1;
@@ -379,56 +856,782 @@ static size_t binsearch(Cmp* cmp, size_t nrows) {
 }
 
 
+/**
+ * Return the first row `j` within `[start, end)` such that the J value in
+ * this row is not less than the X value stored in the comparator; or `end`
+ * if there is no such row.
+ */
+static size_t lower_bound(const Cmp* cmp, size_t start, size_t end) {
+  while (start < end) {
+    size_t mid = start + ((end - start) >> 1);
+    if (cmp->cmp_jrow(mid) < 0) start = mid + 1;
+    else end = mid;
+  }
+  return start;
+}
+
 
-// declared in datatable.h
-RowIndex natural_join(const DataTable* xdt, const DataTable* jdt) {
-  size_t k = jdt->get_nkeys();  // Number of join columns
-  xassert(k > 0);
+/**
+ * Same as `lower_bound()`, but assumes that the answer is likely to be close
+ * to `start`: the search range is doubled until it brackets the answer, and
+ * only then binary search is applied. The J value in row `start - 1` (if any)
+ * must be less than the X value.
+ */
+static size_t gallop(const Cmp* cmp, size_t start, size_t end) {
+  if (start >= end || cmp->cmp_jrow(start) >= 0) return start;
+  size_t lo = start;  // cmp_jrow(lo) < 0
+  size_t step = 1;
+  while (true) {
+    size_t hi = lo + step;
+    if (hi >= end) return lower_bound(cmp, lo + 1, end);
+    if (cmp->cmp_jrow(hi) >= 0) return lower_bound(cmp, lo + 1, hi);
+    lo = hi;
+    step <<= 1;
+  }
+}
 
-  // Determine how key columns in `jdt` match the columns in `xdt`
-  indvec xcols, jcols;
+
+/**
+ * Merge join of rows `[i0, i1)` of the X frame into the J frame, assuming
+ * that both frames are sorted by the join columns. The starting position
+ * within J is found via binary search, after which both frames are swept
+ * forward together (galloping over the runs of J rows that have no match
+ * in X).
+ */
+template <typename T>
+static void merge_join(Cmp* cmp, size_t i0, size_t i1, size_t jnrows,
+                       T* result_indices)
+{
+  size_t j = RowIndex::NA;
+  for (size_t i = i0; i < i1; ++i) {
+    if (cmp->set_xrow(i) != 0) {
+      result_indices[i] = -1;
+      continue;
+    }
+    j = (j == RowIndex::NA)? lower_bound(cmp, 0, jnrows)
+                           : gallop(cmp, j, jnrows);
+    bool match = (j < jnrows && cmp->cmp_jrow(j) == 0);
+    result_indices[i] = match? static_cast<T>(j) : -1;
+  }
+}
+
+
+/**
+ * Determine how the columns in `jdt` match the columns in `xdt`. If `jdt`
+ * is keyed, then it is joined on its key columns, all of which must be
+ * present in `xdt`. Otherwise, `jdt` is joined on all columns whose names
+ * are also present in `xdt`.
+ */
+void find_join_columns(const DataTable* xdt, const DataTable* jdt,
+                       indvec& xcols, indvec& jcols)
+{
+  size_t k = jdt->get_nkeys();
   py::otuple jnames = jdt->get_pynames();
-  for (size_t i = 0; i < k; ++i) {
-    int64_t index = xdt->colindex(jnames[i]);
-    if (index == -1) {
-      throw ValueError() << "Key column `" << jnames[i].to_string() << "` does "
-          "not exist in the left Frame";
+  if (k) {
+    for (size_t i = 0; i < k; ++i) {
+      int64_t index = xdt->colindex(jnames[i]);
+      if (index == -1) {
+        throw ValueError() << "Key column `" << jnames[i].to_string() << "` "
+            "does not exist in the left Frame";
+      }
+      xcols.push_back(static_cast<size_t>(index));
+      jcols.push_back(i);
+    }
+  }
+  else {
+    for (size_t i = 0; i < jdt->ncols; ++i) {
+      int64_t index = xdt->colindex(jnames[i]);
+      if (index == -1) continue;
+      xcols.push_back(static_cast<size_t>(index));
+      jcols.push_back(i);
+    }
+    if (xcols.empty()) {
+      throw ValueError() << "The join frame is not keyed, and has no columns "
+          "in common with the left Frame";
+    }
+  }
+}
+
+
+/**
+ * Check whether the X frame is sorted by the join columns `xcols`, in the
+ * order implied by the comparator (i.e. with NAs first). The check runs in
+ * parallel and stops as soon as any thread finds an unsorted pair of rows,
+ * so it is cheap for the frames that are not sorted.
+ */
+static bool _is_sorted(const indvec& xcols, const DataTable* xdt) {
+  size_t nrows = xdt->nrows;
+  if (nrows <= 1) return true;
+  size_t nth = std::min(std::max(nrows / 1000, size_t(1)),
+                        static_cast<size_t>(config::nthreads));
+  bool sorted = true;
+  OmpExceptionManager oem;
+  #pragma omp parallel num_threads(nth)
+  {
+    try {
+      MultiCmp comparator(xcols, xcols, xdt, xdt);
+      size_t ith = static_cast<size_t>(omp_get_thread_num());
+      size_t nthreads = static_cast<size_t>(omp_get_num_threads());
+      size_t i0 = std::max(nrows * ith / nthreads, size_t(1));
+      size_t i1 = nrows * (ith + 1) / nthreads;
+      for (size_t i = i0; i < i1; ++i) {
+        comparator.set_xrow(i);
+        if (comparator.cmp_jrow(i - 1) > 0) {
+          #pragma omp atomic write
+          sorted = false;
+        }
+        if ((i & 1023) == 0) {
+          bool still_sorted;
+          #pragma omp atomic read
+          still_sorted = sorted;
+          if (!still_sorted) break;
+        }
+      }
+    } catch (...) {
+      oem.capture_exception();
+    }
+  }
+  oem.rethrow_exception_if_any();
+  return sorted;
+}
+
+
+/**
+ * Check whether the X frame is keyed by the join columns `xcols`, in which
+ * case it is also sorted by them (since key values are unique, it doesn't
+ * matter if the key has fewer columns than `xcols`).
+ */
+static bool _is_keyed_by(const indvec& xcols, const DataTable* xdt) {
+  size_t xnkeys = std::min(xdt->get_nkeys(), xcols.size());
+  bool xkeyed = (xnkeys > 0);
+  for (size_t i = 0; i < xnkeys; ++i) {
+    xkeyed &= (xcols[i] == i);
+  }
+  return xkeyed;
+}
+
+
+enum class JoinMethod : uint8_t {
+  BINSEARCH,
+  HASH,
+  MERGE,
+};
+
+/**
+ * Decide which algorithm to use for joining `xdt` with `jdt`:
+ *
+ *   BINSEARCH
+ *     Each row of X is looked up in J via binary search, at the cost of
+ *     `log2(jnrows)` random accesses into J per row. This is only possible
+ *     when `jdt` is keyed (i.e. sorted by the join columns). This method is
+ *     preferable when X is small compared to J, or when J is small enough
+ *     to stay in the cache.
+ *
+ *   HASH
+ *     A hash table is built over J (which costs about 2 passes over J), and
+ *     then each row of X makes ~1 random access into that table. This is the
+ *     only method available when `jdt` is not keyed. The hash table is
+ *     cached in J, so if it was already built (`indexed`), or if the rows
+ *     looked up into J by the previous joins were enough to amortize its
+ *     cost, then only the lookups are counted.
+ *
+ *   MERGE
+ *     When both X and J are sorted by the join columns, the rows of X are
+ *     split into contiguous ranges, and for each range we find its starting
+ *     position in J once, and then sweep both frames linearly. The cost is
+ *     one sequential pass over X and J.
+ */
+static JoinMethod _choose_join_method(const DataTable* xdt,
+                                      const DataTable* jdt,
+                                      const indvec& xcols, bool indexed)
+{
+  if (jdt->get_nkeys() == 0) return JoinMethod::HASH;
+  size_t xnrows = xdt->nrows;
+  size_t jnrows = jdt->nrows;
+  size_t log2j = 0;
+  while ((size_t(1) << log2j) < jnrows) log2j++;
+  size_t cost_binsearch = xnrows * log2j;
+  bool amortized = indexed || (jdt->join_nlookups + xnrows >= jnrows);
+  size_t cost_hash = amortized? 2 * xnrows : 2 * (xnrows + 2 * jnrows);
+  size_t cost_merge = xnrows + jnrows;
+  if (cost_merge < std::min(cost_binsearch, cost_hash)) {
+    if (_is_keyed_by(xcols, xdt) || _is_sorted(xcols, xdt)) {
+      return JoinMethod::MERGE;
+    }
+  }
+  if (jnrows < 1024 || cost_binsearch <= cost_hash) {
+    return JoinMethod::BINSEARCH;
+  }
+  return JoinMethod::HASH;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Asof join
+//------------------------------------------------------------------------------
+
+/**
+ * Reader of the values of a numeric column as type `W` (which is `int64_t`
+ * for integer columns, or `double` when any of the asof columns is real).
+ * Same as the comparators, it reads view columns through their rowindex.
+ */
+template <typename W>
+class NumReader {
+  private:
+    using readfn = W (*)(const void*, size_t, bool*);
+    const void* data;
+    readfn reader;
+    RowMap map;
+
+    template <typename T>
+    static W read(const void* data, size_t i, bool* isna) {
+      T value = static_cast<const T*>(data)[i];
+      *isna = ISNA<T>(value);
+      return static_cast<W>(value);
+    }
+
+  public:
+    explicit NumReader(const Column* col);
+    W get(size_t row, bool* isna) const;
+};
+
+
+template <typename W>
+NumReader<W>::NumReader(const Column* col)
+  : data(col->data()), reader(nullptr), map(col->rowindex())
+{
+  switch (col->stype()) {
+    case SType::BOOL:
+    case SType::INT8:    reader = read<int8_t>; break;
+    case SType::INT16:   reader = read<int16_t>; break;
+    case SType::INT32:   reader = read<int32_t>; break;
+    case SType::INT64:   reader = read<int64_t>; break;
+    case SType::FLOAT32: reader = read<float>; break;
+    case SType::FLOAT64: reader = read<double>; break;
+    default: xassert(false);
+  }
+}
+
+template <typename W>
+inline W NumReader<W>::get(size_t row, bool* isna) const {
+  size_t i = map[row];
+  if (i == RowIndex::NA) {
+    *isna = true;
+    return 0;
+  }
+  return reader(data, i, isna);
+}
+
+
+static inline uint64_t absdiff(int64_t a, int64_t b) {
+  return a > b? static_cast<uint64_t>(a) - static_cast<uint64_t>(b)
+              : static_cast<uint64_t>(b) - static_cast<uint64_t>(a);
+}
+
+static inline double absdiff(double a, double b) {
+  return std::abs(a - b);
+}
+
+
+/**
+ * Comparator for the asof join. The leading join columns are compared
+ * exactly via a MultiCmp, and the last join column is compared as a number
+ * of type `W`, which allows measuring the distance between the keys.
+ */
+template <typename W>
+class AsofCmp : public Cmp {
+  private:
+    MultiCmp prefix;
+    NumReader<W> xreader;
+    NumReader<W> jreader;
+    W xvalue;
+    bool xna;
+    size_t : 56;
+
+  public:
+    AsofCmp(const indvec& xcols, const indvec& jcols,
+            const DataTable* xdt, const DataTable* jdt);
+    int set_xrow(size_t row) override;
+    int cmp_jrow(size_t row) const override;
+    uint64_t hash_xrow() const override;
+    uint64_t hash_jrow(size_t row) const override;
+
+    bool xvalue_isna() const { return xna; }
+    int cmp_prefix(size_t row) const { return prefix.cmp_jrow(row); }
+    bool jvalue_isna(size_t row) const;
+    double distance(size_t row) const;
+    bool is_closer(size_t row1, size_t row2) const;
+};
+
+
+template <typename W>
+AsofCmp<W>::AsofCmp(const indvec& xcols, const indvec& jcols,
+                    const DataTable* xdt, const DataTable* jdt)
+  : prefix(indvec(xcols.begin(), xcols.end() - 1),
+           indvec(jcols.begin(), jcols.end() - 1), xdt, jdt),
+    xreader(xdt->columns[xcols.back()]),
+    jreader(jdt->columns[jcols.back()]) {}
+
+
+template <typename W>
+int AsofCmp<W>::set_xrow(size_t row) {
+  xvalue = xreader.get(row, &xna);
+  return prefix.set_xrow(row);
+}
+
+
+template <typename W>
+int AsofCmp<W>::cmp_jrow(size_t row) const {
+  int r = prefix.cmp_jrow(row);
+  if (r) return r;
+  bool jna;
+  W jvalue = jreader.get(row, &jna);
+  if (jna || xna) return xna - jna;  // NA is less than any other value
+  return (jvalue > xvalue) - (jvalue < xvalue);
+}
+
+
+// The last column does not contribute to the hash, which remains consistent
+// with the comparison (equal keys have equal hashes).
+template <typename W>
+uint64_t AsofCmp<W>::hash_xrow() const {
+  return prefix.hash_xrow();
+}
+
+template <typename W>
+uint64_t AsofCmp<W>::hash_jrow(size_t row) const {
+  return prefix.hash_jrow(row);
+}
+
+
+template <typename W>
+bool AsofCmp<W>::jvalue_isna(size_t row) const {
+  bool jna;
+  jreader.get(row, &jna);
+  return jna;
+}
+
+
+template <typename W>
+double AsofCmp<W>::distance(size_t row) const {
+  bool jna;
+  W jvalue = jreader.get(row, &jna);
+  return static_cast<double>(absdiff(jvalue, xvalue));
+}
+
+
+// Return true if J row `row1` is not farther from the current X value than
+// the J row `row2`.
+template <typename W>
+bool AsofCmp<W>::is_closer(size_t row1, size_t row2) const {
+  bool jna;
+  W jvalue1 = jreader.get(row1, &jna);
+  W jvalue2 = jreader.get(row2, &jna);
+  return absdiff(jvalue1, xvalue) <= absdiff(jvalue2, xvalue);
+}
+
+
+/**
+ * Find the match for the X value stored in the comparator, given that `j`
+ * is the lower bound of that value in J (i.e. the first J row whose key is
+ * not less than the X key). The candidates are row `j` itself (if it has
+ * the same prefix), and row `j - 1` (if it has the same prefix and a non-NA
+ * value in the last column).
+ */
+template <typename W>
+static size_t _asof_match(const AsofCmp<W>& cmp, size_t j, size_t jnrows,
+                          AsofType asof, double tolerance)
+{
+  size_t jf = (j < jnrows && cmp.cmp_prefix(j) == 0)? j : RowIndex::NA;
+  size_t jb = (j > 0 && cmp.cmp_prefix(j - 1) == 0 && !cmp.jvalue_isna(j - 1))
+              ? j - 1 : RowIndex::NA;
+  size_t res = RowIndex::NA;
+  if (jf != RowIndex::NA && cmp.cmp_jrow(jf) == 0) {
+    res = jf;  // exact match
+  }
+  else if (asof == AsofType::BACKWARD) res = jb;
+  else if (asof == AsofType::FORWARD) res = jf;
+  else if (jb == RowIndex::NA) res = jf;
+  else if (jf == RowIndex::NA) res = jb;
+  else res = cmp.is_closer(jb, jf)? jb : jf;
+
+  if (res != RowIndex::NA && cmp.distance(res) > tolerance) {
+    res = RowIndex::NA;
+  }
+  return res;
+}
+
+
+/**
+ * Asof join: for each row in X, find the row in (keyed) J which matches
+ * exactly on all join columns except the last, and has the closest value in
+ * the last join column in the direction given by `asof`. The search uses
+ * the binary search over the sorted keys of J. If X is sorted by the join
+ * columns too, then the lower bound for each row is found by galloping
+ * forward from the lower bound of the previous row, instead of searching
+ * the entire J frame. Either way the rows of X are processed in parallel,
+ * with each thread handling a contiguous range of rows.
+ */
+template <typename W, typename T>
+static void _asof_search(const DataTable* xdt, const DataTable* jdt,
+                       const indvec& xcols, const indvec& jcols,
+                       AsofType asof, double tolerance, T* result_indices)
+{
+  size_t xnrows = xdt->nrows;
+  size_t jnrows = jdt->nrows;
+  bool xsorted = _is_keyed_by(xcols, xdt) || _is_sorted(xcols, xdt);
+  size_t nchunks = std::min(std::max(xnrows / 200, size_t(1)),
+                            static_cast<size_t>(config::nthreads));
+  OmpExceptionManager oem;
+  #pragma omp parallel num_threads(nchunks)
+  {
+    try {
+      AsofCmp<W> cmp(xcols, jcols, xdt, jdt);
+      size_t ith = static_cast<size_t>(omp_get_thread_num());
+      size_t nth = static_cast<size_t>(omp_get_num_threads());
+      size_t i0 = xnrows * ith / nth;
+      size_t i1 = xnrows * (ith + 1) / nth;
+      size_t j = RowIndex::NA;
+      for (size_t i = i0; i < i1; ++i) {
+        if (cmp.set_xrow(i) != 0 || cmp.xvalue_isna()) {
+          result_indices[i] = -1;
+          continue;
+        }
+        j = (xsorted && j != RowIndex::NA)? gallop(&cmp, j, jnrows)
+                                          : lower_bound(&cmp, 0, jnrows);
+        size_t res = _asof_match(cmp, j, jnrows, asof, tolerance);
+        result_indices[i] = res == RowIndex::NA? -1 : static_cast<T>(res);
+      }
+    } catch (...) {
+      oem.capture_exception();
     }
-    xcols.push_back(static_cast<size_t>(index));
-    jcols.push_back(i);
   }
+  oem.rethrow_exception_if_any();
+}
+
 
-  // For now, we materialize the join columns. Later, we can add an ability
-  // to operate on the view columns as well, via the `as_view` flag (similar
-  // to the `group()` function). A frame can only be joined as a view if all
-  // its columns have the same rowindex (or at least all columns needed to
-  // compute the result).
-  for (size_t j : xcols) {
-    xdt->columns[j]->reify();
+/**
+ * Check that the join of `xdt` with `jdt` on columns `xcols` / `jcols` can
+ * be performed as an asof join, and then do it, choosing the type for
+ * reading the values of the last join column.
+ */
+template <typename T>
+static void _asof_join(const DataTable* xdt, const DataTable* jdt,
+                       const indvec& xcols, const indvec& jcols,
+                       AsofType asof, double tolerance, T* result_indices)
+{
+  if (jdt->get_nkeys() == 0) {
+    throw ValueError() << "Asof join requires the join frame to be keyed";
   }
+  const Column* xcol = xdt->columns[xcols.back()];
+  const Column* jcol = jdt->columns[jcols.back()];
+  bool real = false;
+  for (SType st : {xcol->stype(), jcol->stype()}) {
+    switch (st) {
+      case SType::BOOL:
+      case SType::INT8:
+      case SType::INT16:
+      case SType::INT32:
+      case SType::INT64: break;
+      case SType::FLOAT32:
+      case SType::FLOAT64: real = true; break;
+      default:
+        throw TypeError() << "The last key column in an asof join must be "
+            "numeric, instead column `" << jdt->get_names()[jcols.back()]
+            << "` has types " << xcol->stype() << " and " << jcol->stype();
+    }
+  }
+  if (real) {
+    _asof_search<double>(xdt, jdt, xcols, jcols, asof, tolerance,
+                         result_indices);
+  } else {
+    _asof_search<int64_t>(xdt, jdt, xcols, jcols, asof, tolerance,
+                          result_indices);
+  }
+}
+
+
 
-  arr32_t arr_result_indices(xdt->nrows);
-  if (xdt->nrows) {
-    int32_t* result_indices = arr_result_indices.data();
+/**
+ * Given the array `matches` of the first matching J row for each row in X
+ * (or -1 if there is no match), produce the pair of rowindices (xri, jri)
+ * describing the rows of the join's result: the i-th row of the result is
+ * composed of row `xri[i]` of X and row `jri[i]` of J. Either of these may
+ * be NA, meaning that the corresponding frame contributes only NAs.
+ *
+ * The result is computed in two parallel passes over the chunks of X: first
+ * the number of output rows in each chunk is counted, then (after a prefix
+ * sum over the chunks) each chunk writes its rows at the known offset. The
+ * rows of J not matched by any row in X are handled the same way, and
+ * appended at the end. The output rowindices are 32-bit, unless the number
+ * of rows in the result (or in either of the frames) exceeds the option
+ * `join.max_int32_rows`.
+ *
+ * If `hindex` is given, then it must have its groups built, and each entry
+ * of `matches` is the first row of its group.
+ */
+template <typename T>
+class JoinExpander {
+  private:
+    const T* matches;
+    const HashIndex<T>* hindex;
+    size_t xnrows;
+    size_t jnrows;
+    size_t xchunks;
+    size_t jchunks;
+    std::vector<size_t> offsets;
+    dt::array<int8_t> jmatched;
+    bool keep_x;  // keep the rows of X that have no match in J
+    bool keep_j;  // keep the rows of J that have no match in X
+    bool expand;  // produce all matching rows of J, not only the first
+    size_t : 40;
+
+  public:
+    JoinExpander(const T* matches, size_t xnrows, size_t jnrows,
+                 const HashIndex<T>* hindex, JoinType how, bool mult_all);
+    std::pair<RowIndex, RowIndex> run();
+
+  private:
+    void mark_matched_jrows();
+    void count();
+    template <typename TO> std::pair<RowIndex, RowIndex> fill();
+};
+
+
+template <typename T>
+JoinExpander<T>::JoinExpander(const T* matches_, size_t xnrows_,
+                              size_t jnrows_, const HashIndex<T>* hindex_,
+                              JoinType how, bool mult_all)
+  : matches(matches_), hindex(hindex_), xnrows(xnrows_), jnrows(jnrows_)
+{
+  size_t nth = static_cast<size_t>(config::nthreads);
+  keep_x = (how == JoinType::LEFT || how == JoinType::OUTER);
+  keep_j = (how == JoinType::RIGHT || how == JoinType::OUTER);
+  expand = mult_all && hindex;
+  xchunks = std::min(std::max(xnrows / 1000, size_t(1)), nth * 4);
+  jchunks = keep_j? std::min(std::max(jnrows / 1000, size_t(1)), nth * 4) : 0;
+}
+
+
+template <typename T>
+std::pair<RowIndex, RowIndex> JoinExpander<T>::run() {
+  if (keep_j) mark_matched_jrows();
+  count();
+  size_t nrows = offsets.back();
+  if (sizeof(T) == 4 && nrows <= config::join_max_int32_rows) {
+    return fill<int32_t>();
+  } else {
+    return fill<int64_t>();
+  }
+}
+
+
+// Mark the rows of J that were matched by at least one row in X
+template <typename T>
+void JoinExpander<T>::mark_matched_jrows() {
+  size_t nth = static_cast<size_t>(config::nthreads);
+  jmatched.resize(jnrows);
+  int8_t* jmatched_data = jmatched.data();
+  if (!jnrows) return;
+  std::memset(jmatched_data, 0, jnrows);
+  #pragma omp parallel for num_threads(nth)
+  for (size_t i = 0; i < xnrows; ++i) {
+    T j = matches[i];
+    if (j == -1) continue;
+    #pragma omp atomic write
+    jmatched_data[j] = 1;
+  }
+  if (hindex) {
+    // Only the first row of each group was marked; propagate the marks
+    // to the remaining rows of the group.
+    #pragma omp parallel for num_threads(nth)
+    for (size_t j = 0; j < jnrows; ++j) {
+      size_t h = hindex->head(j);
+      if (h != j) jmatched_data[j] = jmatched_data[h];
+    }
+  }
+}
+
+
+// Pass 1: count the number of output rows produced by each chunk, and
+// convert these counts into the offsets of each chunk in the output.
+template <typename T>
+void JoinExpander<T>::count() {
+  size_t nth = static_cast<size_t>(config::nthreads);
+  offsets.assign(xchunks + jchunks + 1, 0);
+  const int8_t* jmatched_data = jmatched.data();
+  #pragma omp parallel for num_threads(nth) schedule(dynamic)
+  for (size_t c = 0; c < xchunks + jchunks; ++c) {
+    size_t cnt = 0;
+    if (c < xchunks) {
+      size_t i0 = xnrows * c / xchunks;
+      size_t i1 = xnrows * (c + 1) / xchunks;
+      for (size_t i = i0; i < i1; ++i) {
+        T j = matches[i];
+        cnt += (j == -1)? keep_x :
+               expand? hindex->group_size(static_cast<size_t>(j)) : 1;
+      }
+    } else {
+      size_t j0 = jnrows * (c - xchunks) / jchunks;
+      size_t j1 = jnrows * (c - xchunks + 1) / jchunks;
+      for (size_t j = j0; j < j1; ++j) {
+        cnt += !jmatched_data[j];
+      }
+    }
+    offsets[c + 1] = cnt;
+  }
+  for (size_t c = 1; c < offsets.size(); ++c) {
+    offsets[c] += offsets[c - 1];
+  }
+}
+
+
+// Pass 2: fill the rowindices
+template <typename T>
+template <typename TO>
+std::pair<RowIndex, RowIndex> JoinExpander<T>::fill() {
+  size_t nth = static_cast<size_t>(config::nthreads);
+  size_t nrows = offsets.back();
+  dt::array<TO> xrows(nrows);
+  dt::array<TO> jrows(nrows);
+  TO* xrows_data = xrows.data();
+  TO* jrows_data = jrows.data();
+  const int8_t* jmatched_data = jmatched.data();
+  #pragma omp parallel for num_threads(nth) schedule(dynamic)
+  for (size_t c = 0; c < xchunks + jchunks; ++c) {
+    size_t k = offsets[c];
+    if (c < xchunks) {
+      size_t i0 = xnrows * c / xchunks;
+      size_t i1 = xnrows * (c + 1) / xchunks;
+      for (size_t i = i0; i < i1; ++i) {
+        T j = matches[i];
+        TO irow = static_cast<TO>(i);
+        if (j == -1) {
+          if (!keep_x) continue;
+          xrows_data[k] = irow;
+          jrows_data[k++] = -1;
+        }
+        else if (expand) {
+          size_t jj = static_cast<size_t>(j);
+          do {
+            xrows_data[k] = irow;
+            jrows_data[k++] = static_cast<TO>(jj);
+            jj = hindex->next(jj);
+          } while (jj != RowIndex::NA);
+        }
+        else {
+          xrows_data[k] = irow;
+          jrows_data[k++] = static_cast<TO>(j);
+        }
+      }
+    } else {
+      size_t j0 = jnrows * (c - xchunks) / jchunks;
+      size_t j1 = jnrows * (c - xchunks + 1) / jchunks;
+      for (size_t j = j0; j < j1; ++j) {
+        if (jmatched_data[j]) continue;
+        xrows_data[k] = -1;
+        jrows_data[k++] = static_cast<TO>(j);
+      }
+    }
+    xassert(k == offsets[c + 1]);
+  }
+
+  // Without the unmatched J rows, the X rows appear in ascending order
+  return std::pair<RowIndex, RowIndex>(
+            RowIndex(std::move(xrows), /* sorted = */ !keep_j),
+            RowIndex(std::move(jrows)));
+}
+
+
+
+/**
+ * Return the hash index over columns `jcols` cached in `jdt`, or nullptr if
+ * there is no such index.
+ */
+template <typename T>
+static std::shared_ptr<HashIndex<T>> _get_cached_index(const DataTable* jdt,
+                                                       const indvec& jcols)
+{
+  if (!jdt->join_index || jdt->join_index->cols != jcols) return nullptr;
+  return std::dynamic_pointer_cast<HashIndex<T>>(jdt->join_index);
+}
+
+
+/**
+ * Build the hash index over columns `jcols` of `jdt`, and cache it in the
+ * frame (replacing the index previously cached, if any).
+ */
+template <typename T>
+static std::shared_ptr<HashIndex<T>> _build_index(const DataTable* jdt,
+                                                  const indvec& jcols)
+{
+  auto hindex = std::make_shared<HashIndex<T>>(jcols, jdt);
+  jdt->join_index = hindex;
+  jdt->join_nlookups = 0;
+  return hindex;
+}
+
+
+/**
+ * Implementation of `natural_join()`, where `T` is the type used to store
+ * row indices during the computation: `int32_t` if both frames have no more
+ * than INT32_MAX rows, and `int64_t` otherwise.
+ */
+template <typename T>
+static std::pair<RowIndex, RowIndex>
+_natural_join(const DataTable* xdt, const DataTable* jdt,
+              const indvec& xcols, const indvec& jcols,
+              JoinType how, bool mult_all, AsofType asof, double tolerance)
+{
+  dt::array<T> arr_result_indices(xdt->nrows);
+  std::shared_ptr<HashIndex<T>> hindex;
+  if (asof != AsofType::NONE) {
+    _asof_join(xdt, jdt, xcols, jcols, asof, tolerance,
+               arr_result_indices.data());
+  }
+  else if (xdt->nrows) {
+    T* result_indices = arr_result_indices.data();
     size_t nchunks = std::min(std::max(xdt->nrows / 200, size_t(1)),
                               static_cast<size_t>(config::nthreads));
     xassert(nchunks);
+    // Creating the comparator may fail if xcols and jcols are incompatible,
+    // so check this before building the hash index.
+    MultiCmp comparator0(xcols, jcols, xdt, jdt);
+
+    auto cached = _get_cached_index<T>(jdt, jcols);
+    JoinMethod method = _choose_join_method(xdt, jdt, xcols, bool(cached));
+    if (jdt->nrows && method == JoinMethod::HASH) {
+      hindex = cached? cached : _build_index<T>(jdt, jcols);
+    }
+    if (method == JoinMethod::BINSEARCH) {
+      jdt->join_nlookups += xdt->nrows;
+    }
 
     OmpExceptionManager oem;
     #pragma omp parallel num_threads(nchunks)
     {
       try {
-        // Creating the comparator may fail if xcols and jcols are incompatible
         MultiCmp comparator(xcols, jcols, xdt, jdt);
 
-        #pragma omp for
-        for (size_t i = 0; i < xdt->nrows; ++i) {
-          int r = comparator.set_xrow(i);
-          if (r == 0) {
-            size_t j = binsearch(&comparator, jdt->nrows);
-            result_indices[i] = static_cast<int32_t>(j);
-          } else {
-            result_indices[i] = -1;
+        if (method == JoinMethod::MERGE) {
+          size_t ith = static_cast<size_t>(omp_get_thread_num());
+          size_t nth = static_cast<size_t>(omp_get_num_threads());
+          size_t i0 = xdt->nrows * ith / nth;
+          size_t i1 = xdt->nrows * (ith + 1) / nth;
+          merge_join(&comparator, i0, i1, jdt->nrows, result_indices);
+        }
+        else {
+          #pragma omp for
+          for (size_t i = 0; i < xdt->nrows; ++i) {
+            int r = comparator.set_xrow(i);
+            if (r == 0 && jdt->nrows) {
+              size_t j = hindex? hindex->find(&comparator)
+                               : binsearch(&comparator, jdt->nrows);
+              result_indices[i] = static_cast<T>(j);
+            } else {
+              result_indices[i] = -1;
+            }
           }
         }
       } catch (...) {
@@ -438,7 +1641,163 @@ RowIndex natural_join(const DataTable* xdt, const DataTable* jdt) {
     oem.rethrow_exception_if_any();
   }
 
-  return RowIndex(std::move(arr_result_indices));
+  // Left join that takes only the first match: the rows of X are preserved
+  if (how == JoinType::LEFT && !mult_all) {
+    return std::pair<RowIndex, RowIndex>(
+              RowIndex(), RowIndex(std::move(arr_result_indices)));
+  }
+
+  // An unkeyed J frame may contain duplicate keys, in which case the groups
+  // of rows with the same key are needed. A keyed frame has unique keys.
+  if (jdt->get_nkeys() == 0 && jdt->nrows && asof == AsofType::NONE) {
+    if (!hindex) {
+      hindex = _get_cached_index<T>(jdt, jcols);
+      if (!hindex) hindex = _build_index<T>(jdt, jcols);
+    }
+    hindex->build_groups(jcols, jdt);
+  } else {
+    hindex = nullptr;
+  }
+  JoinExpander<T> expander(arr_result_indices.data(), xdt->nrows,
+                           jdt->nrows, hindex.get(), how, mult_all);
+  return expander.run();
+}
+
+
+template <typename T>
+static size_t _lookup_row(const DataTable* keydt, const DataTable* dt,
+                          const indvec& xcols, const indvec& jcols)
+{
+  MultiCmp comparator(xcols, jcols, keydt, dt);
+  if (dt->nrows == 0 || comparator.set_xrow(0) != 0) return RowIndex::NA;
+  auto hindex = _get_cached_index<T>(dt, jcols);
+  if (!hindex) hindex = _build_index<T>(dt, jcols);
+  return hindex->find(&comparator);
+}
+
+
+// declared in datatable.h
+size_t lookup_row(const DataTable* keydt, const DataTable* dt) {
+  xassert(keydt->nrows == 1 && dt->get_nkeys() > 0);
+  indvec xcols, jcols;
+  find_join_columns(keydt, dt, xcols, jcols);
+  if (dt->nrows <= static_cast<size_t>(INT32_MAX)) {
+    return _lookup_row<int32_t>(keydt, dt, xcols, jcols);
+  } else {
+    return _lookup_row<int64_t>(keydt, dt, xcols, jcols);
+  }
+}
+
+
+// declared in datatable.h
+arr32_t hash_row_heads(const DataTable* dt, const intvec& cols) {
+  size_t nrows = dt->nrows;
+  xassert(nrows <= static_cast<size_t>(INT32_MAX));
+  arr32_t heads(nrows);
+  if (nrows == 0) return heads;
+  int32_t* heads_data = heads.data();
+  size_t nth = std::min(std::max(nrows / 1000, size_t(1)),
+                        static_cast<size_t>(config::nthreads));
+
+  // A join index cached in the frame already maps each row to the first row
+  // with the same value.
+  auto hindex = _get_cached_index<int32_t>(dt, cols);
+  if (hindex) {
+    OmpExceptionManager oem;
+    #pragma omp parallel num_threads(nth)
+    {
+      try {
+        MultiCmp comparator(cols, cols, dt, dt);
+
+        #pragma omp for
+        for (size_t i = 0; i < nrows; ++i) {
+          comparator.set_xrow(i);
+          heads_data[i] = static_cast<int32_t>(hindex->find(&comparator));
+        }
+      } catch (...) {
+        oem.capture_exception();
+      }
+    }
+    oem.rethrow_exception_if_any();
+    return heads;
+  }
+
+  // Otherwise, the rows are split into `nchunks` contiguous chunks, and each
+  // chunk is grouped using its own hash table. Afterwards, the first rows of
+  // each chunk's groups are merged into a single table, in the order of the
+  // chunks, so that the head of each group is its first row overall.
+  size_t nchunks = nth;
+  size_t chunksize = (nrows + nchunks - 1) / nchunks;
+  std::vector<std::vector<int32_t>> chunk_heads(nchunks);
+  OmpExceptionManager oem;
+  #pragma omp parallel num_threads(nth)
+  {
+    try {
+      MultiCmp comparator(cols, cols, dt, dt);
+
+      #pragma omp for schedule(static, 1)
+      for (size_t ic = 0; ic < nchunks; ++ic) {
+        size_t i0 = ic * chunksize;
+        size_t i1 = std::min(i0 + chunksize, nrows);
+        RowHashSet rowset;
+        for (size_t i = i0; i < i1; ++i) {
+          int32_t irow = static_cast<int32_t>(i);
+          comparator.set_xrow(i);
+          int32_t h = rowset.insert(&comparator, comparator.hash_xrow(), irow);
+          heads_data[i] = h;
+          if (h == irow) chunk_heads[ic].push_back(irow);
+        }
+      }
+    } catch (...) {
+      oem.capture_exception();
+    }
+  }
+  oem.rethrow_exception_if_any();
+
+  if (nchunks > 1) {
+    MultiCmp comparator(cols, cols, dt, dt);
+    RowHashSet rowset;
+    for (const auto& rows : chunk_heads) {
+      for (int32_t row : rows) {
+        comparator.set_xrow(static_cast<size_t>(row));
+        heads_data[row] = rowset.insert(&comparator, comparator.hash_xrow(),
+                                        row);
+      }
+    }
+    // Now redirect every row to the global head of its chunk's group. The
+    // result is written into a separate array: the chunk heads are read by
+    // many rows, so they must not be overwritten in the same parallel loop.
+    arr32_t global_heads(nrows);
+    int32_t* global_data = global_heads.data();
+    #pragma omp parallel for num_threads(nth)
+    for (size_t i = 0; i < nrows; ++i) {
+      global_data[i] = heads_data[heads_data[i]];
+    }
+    return global_heads;
+  }
+  return heads;
+}
+
+
+// declared in datatable.h
+std::pair<RowIndex, RowIndex>
+natural_join(const DataTable* xdt, const DataTable* jdt, JoinType how,
+             bool mult_all, AsofType asof, double tolerance)
+{
+  indvec xcols, jcols;
+  find_join_columns(xdt, jdt, xcols, jcols);
+
+  // The join columns are not materialized: if any of them is a view, the
+  // comparators read its data through the column's rowindex.
+
+  size_t max32 = config::join_max_int32_rows;
+  if (xdt->nrows <= max32 && jdt->nrows <= max32) {
+    return _natural_join<int32_t>(xdt, jdt, xcols, jcols, how, mult_all,
+                                  asof, tolerance);
+  } else {
+    return _natural_join<int64_t>(xdt, jdt, xcols, jcols, how, mult_all,
+                                  asof, tolerance);
+  }
 }
 
 
@@ -21,7 +21,9 @@
 //------------------------------------------------------------------------------
 #include <numeric>
 #include "frame/py_frame.h"
+#include "python/int.h"
 #include "python/list.h"
+#include "python/tuple.h"
 
 
 
@@ -84,8 +86,80 @@ void Frame::set_key(robj val) {
 
 
 
-void Frame::Type::_init_key(GetSetters& gs) {
+static PKArgs args_lookup(
+    1, 0, 0, false, false,
+    {"key"}, "lookup",
+R"(lookup(self, key)
+--
+
+Return the index of the row whose key is equal to `key`, or None if there
+is no such row. The Frame must be keyed.
+
+The lookup uses a hash index over the key columns of the Frame, which is
+built on the first lookup, and then kept with the Frame and reused by all
+subsequent lookups and joins, until the Frame is modified.
+
+Parameters
+----------
+key: scalar | tuple
+    The value of the key to look up. If the Frame's key consists of several
+    columns, then this should be a tuple with one value for each of them.
+)");
+
+
+oobj Frame::lookup(const PKArgs& args) {
+  size_t K = dt->get_nkeys();
+  if (K == 0) {
+    throw ValueError() << "Frame.lookup() can only be used on a keyed Frame";
+  }
+  if (!args[0]) {
+    throw TypeError() << "Frame.lookup() is missing the required argument "
+        "`key`";
+  }
+  oobj key = args[0].to_oobj();
+  olist values(K);
+  if (key.is_tuple()) {
+    otuple key_tuple = key.to_otuple();
+    if (key_tuple.size() != K) {
+      throw ValueError() << "The key for Frame.lookup() should have " << K
+          << " value" << (K == 1? "" : "s") << ", instead got "
+          << key_tuple.size();
+    }
+    for (size_t i = 0; i < K; ++i) values.set(i, key_tuple[i]);
+  }
+  else if (K == 1) {
+    values.set(0, key);
+  }
+  else {
+    throw TypeError() << "The key for Frame.lookup() should be a tuple of "
+        << K << " values, instead got " << key.typeobj();
+  }
+
+  // Convert the key into a single-row frame with the same column names as
+  // the key columns. A None value gets the stype of its key column.
+  const strvec& names = dt->get_names();
+  colvec cols;
+  strvec key_names;
+  for (size_t i = 0; i < K; ++i) {
+    olist item(1);
+    item.set(0, values[i]);
+    int stype0 = values[i].is_none()? static_cast<int>(dt->columns[i]->stype())
+                                    : 0;
+    cols.push_back(Column::from_pylist(item, stype0));
+    key_names.push_back(names[i]);
+  }
+  DataTable keydt(std::move(cols), key_names);
+
+  size_t row = lookup_row(&keydt, dt);
+  if (row == RowIndex::NA) return None();
+  return oint(row);
+}
+
+
+
+void Frame::Type::_init_key(Methods& mm, GetSetters& gs) {
   ADD_GETSET(gs, &Frame::get_key, &Frame::set_key, args_key);
+  ADD_METHOD(mm, &Frame::lookup, args_lookup);
 }
 
 
@@ -269,7 +269,7 @@ const char* Frame::Type::classdoc() {
 
 void Frame::Type::init_methods_and_getsets(Methods& mm, GetSetters& gs) {
   _init_cbind(mm);
-  _init_key(gs);
+  _init_key(mm, gs);
   _init_init(mm);
   _init_jay(mm);
   _init_names(mm, gs);
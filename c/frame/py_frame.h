@@ -59,7 +59,7 @@ class Frame : public PyObject {
         static void _init_cbind(Methods&);
         static void _init_init(Methods&);
         static void _init_jay(Methods&);
-        static void _init_key(GetSetters&);
+        static void _init_key(Methods&, GetSetters&);
         static void _init_names(Methods&, GetSetters&);
         static void _init_rbind(Methods&);
         static void _init_replace(Methods&);
@@ -109,6 +109,7 @@ class Frame : public PyObject {
     oobj colindex(const PKArgs&);
     oobj copy(const PKArgs&);
     oobj head(const PKArgs&);
+    oobj lookup(const PKArgs&);
     void rbind(const PKArgs&);
     void repeat(const PKArgs&);
     void replace(const PKArgs&);
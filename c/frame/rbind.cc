@@ -269,6 +269,7 @@ void DataTable::rbind(
 {
   size_t new_ncols = cols.size();
   xassert(new_ncols >= ncols);
+  reset_indices();
 
   // If this is a view Frame, then it must be materialized.
   this->reify();
@@ -155,6 +155,7 @@ void Frame::replace(const PKArgs& args) {
   ReplaceAgent ra(dt);
   ra.parse_x_y(x, y);
   ra.split_x_y_by_type();
+  dt->reset_indices();
 
   for (size_t i = 0; i < dt->ncols; ++i) {
     // If a column is a view, then: for a fixed-width column it gets
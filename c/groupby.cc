@@ -6,59 +6,117 @@
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
 #include "groupby.h"
+#include <cstring>     // std::memcpy
+#include "utils/assert.h"
 #include "utils/exceptions.h"
 
 
-Groupby::Groupby() : n(0) {}
+Groupby::Groupby() : n(0), offsets64(false) {}
 
 
-Groupby::Groupby(size_t _n, MemoryRange&& _offs) {
-  if (_offs.size() < sizeof(int32_t) * (_n + 1)) {
+Groupby::Groupby(size_t _n, MemoryRange&& _offs, bool _offs64) {
+  size_t elemsize = _offs64? sizeof(int64_t) : sizeof(int32_t);
+  if (_offs.size() < elemsize * (_n + 1)) {
     throw RuntimeError() << "Cannot create groupby for " << _n << " groups "
         "from memory buffer of size " << _offs.size();
   }
-  if (_offs.get_element<int32_t>(0) != 0) {
+  if (_offs64? _offs.get_element<int64_t>(0) != 0
+             : _offs.get_element<int32_t>(0) != 0) {
     throw RuntimeError() << "Invalid memory buffer for the Groupby: its first "
         "element is not 0.";
   }
   offsets = std::move(_offs);
   n = _n;
+  offsets64 = _offs64;
 }
 
 
 Groupby Groupby::single_group(size_t nrows) {
+  size_t n = nrows? 1 : 0;
+  if (nrows > static_cast<size_t>(INT32_MAX)) {
+    MemoryRange mr = MemoryRange::mem(2 * sizeof(int64_t));
+    mr.set_element<int64_t>(0, 0);
+    mr.set_element<int64_t>(1, static_cast<int64_t>(nrows));
+    return Groupby(n, std::move(mr), true);
+  }
   MemoryRange mr = MemoryRange::mem(2 * sizeof(int32_t));
   mr.set_element<int32_t>(0, 0);
   mr.set_element<int32_t>(1, static_cast<int32_t>(nrows));
-  size_t n = nrows? 1 : 0;
   return Groupby(n, std::move(mr));
 }
 
 
 const int32_t* Groupby::offsets_r() const {
+  xassert(!offsets64);
   return static_cast<const int32_t*>(offsets.rptr());
 }
 
+const int64_t* Groupby::offsets64_r() const {
+  xassert(offsets64);
+  return static_cast<const int64_t*>(offsets.rptr());
+}
+
+bool Groupby::is64() const {
+  return offsets64;
+}
+
 
 size_t Groupby::ngroups() const {
   return n;
 }
 
+size_t Groupby::last_offset() const {
+  if (!offsets) return 0;
+  return offsets64? static_cast<size_t>(offsets64_r()[n])
+                  : static_cast<size_t>(offsets_r()[n]);
+}
+
+void Groupby::get_group(size_t i, size_t* i0, size_t* i1) const {
+  xassert(i < n);
+  if (offsets64) {
+    const int64_t* offs = offsets64_r();
+    *i0 = static_cast<size_t>(offs[i]);
+    *i1 = static_cast<size_t>(offs[i + 1]);
+  } else {
+    const int32_t* offs = offsets_r();
+    *i0 = static_cast<size_t>(offs[i]);
+    *i1 = static_cast<size_t>(offs[i + 1]);
+  }
+}
+
 Groupby::operator bool() const {
   return n != 0;
 }
 
 
-RowIndex Groupby::ungroup_rowindex() {
-  const int32_t* offs = offsets_r();
-  int32_t nrows = offs[n];
-  arr32_t indices(static_cast<size_t>(nrows));
-  int32_t* data = indices.data();
-  int32_t j = 0;
+RowIndex Groupby::first_rows_rowindex() const {
+  if (offsets64) {
+    arr64_t indices(n);
+    std::memcpy(indices.data(), offsets64_r(), n * sizeof(int64_t));
+    return RowIndex(std::move(indices), true);
+  } else {
+    arr32_t indices(n);
+    std::memcpy(indices.data(), offsets_r(), n * sizeof(int32_t));
+    return RowIndex(std::move(indices), true);
+  }
+}
+
+
+template <typename T>
+static RowIndex _ungroup_rowindex(const T* offs, size_t n) {
+  T nrows = offs[n];
+  dt::array<T> indices(static_cast<size_t>(nrows));
+  T* data = indices.data();
+  T j = 0;
   for (size_t i = 0; i < n; ++i) {
-    int32_t upto = offs[i + 1];
-    int32_t ii = static_cast<int32_t>(i);
+    T upto = offs[i + 1];
+    T ii = static_cast<T>(i);
     while (j < upto) data[j++] = ii;
   }
   return RowIndex(std::move(indices), /* sorted = */ true);
 }
+
+RowIndex Groupby::ungroup_rowindex() {
+  return offsets64? _ungroup_rowindex(offsets64_r(), n)
+                  : _ungroup_rowindex(offsets_r(), n);
+}
@@ -11,14 +11,26 @@
 #include "rowindex.h"
 
 
+/**
+ * Grouping of the rows of a frame into `n` consecutive groups. The groups are
+ * described by the array of `n + 1` offsets, with the first offset being 0,
+ * and the last equal to the total number of rows. The group `i` consists of
+ * rows `offsets[i] .. offsets[i + 1] - 1`.
+ *
+ * The offsets are stored as `int32_t`, unless the number of rows does not
+ * fit into this type, in which case `int64_t` offsets are used. The latter
+ * are accessed via `offsets64_r()`.
+ */
 class Groupby {
   private:
     MemoryRange offsets;
     size_t n;
+    bool offsets64;
+    size_t : 56;
 
   public:
     Groupby();
-    Groupby(size_t _n, MemoryRange&& _offs);
+    Groupby(size_t _n, MemoryRange&& _offs, bool _offs64 = false);
     Groupby(const Groupby&) = default;
     Groupby(Groupby&&) = default;
     Groupby& operator=(const Groupby&) = default;
@@ -26,9 +38,16 @@ class Groupby {
     static Groupby single_group(size_t nrows);
 
     const int32_t* offsets_r() const;
+    const int64_t* offsets64_r() const;
+    bool is64() const;
     size_t ngroups() const;
+    size_t last_offset() const;
+    void get_group(size_t i, size_t* i0, size_t* i1) const;
     explicit operator bool() const;
 
+    // Return a RowIndex that selects the first row of each group.
+    RowIndex first_rows_rowindex() const;
+
     // Return a RowIndex which can be used to perform "ungrouping" operation.
     // More specifically, it is a RowIndex with the following data:
     //     [0, 0, ..., 0, 1, 1, ..., 1, 2, ..., n, n, ..., n]
@@ -399,7 +399,8 @@ struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_NAME = 10,
     VT_NULLCOUNT = 12,
     VT_STATS_TYPE = 14,
-    VT_STATS = 16
+    VT_STATS = 16,
+    VT_SORTED = 18
   };
   Type type() const {
     return static_cast<Type>(GetField<uint8_t>(VT_TYPE, 0));
@@ -422,6 +423,9 @@ struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const void *stats() const {
     return GetPointer<const void *>(VT_STATS);
   }
+  uint8_t sorted() const {
+    return GetField<uint8_t>(VT_SORTED, 0);
+  }
   template<typename T> const T *stats_as() const;
   const StatsBool *stats_as_Bool() const {
     return stats_type() == Stats_Bool ? static_cast<const StatsBool *>(stats()) : nullptr;
@@ -455,6 +459,7 @@ struct Column FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint8_t>(verifier, VT_STATS_TYPE) &&
            VerifyOffset(verifier, VT_STATS) &&
            VerifyStats(verifier, stats(), stats_type()) &&
+           VerifyField<uint8_t>(verifier, VT_SORTED) &&
            verifier.EndTable();
   }
 };
@@ -484,6 +489,9 @@ struct ColumnBuilder {
   void add_stats(flatbuffers::Offset<void> stats) {
     fbb_.AddOffset(Column::VT_STATS, stats);
   }
+  void add_sorted(uint8_t sorted) {
+    fbb_.AddElement<uint8_t>(Column::VT_SORTED, sorted, 0);
+  }
   explicit ColumnBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -504,13 +512,15 @@ inline flatbuffers::Offset<Column> CreateColumn(
     flatbuffers::Offset<flatbuffers::String> name = 0,
     uint64_t nullcount = 0,
     Stats stats_type = Stats_NONE,
-    flatbuffers::Offset<void> stats = 0) {
+    flatbuffers::Offset<void> stats = 0,
+    uint8_t sorted = 0) {
   ColumnBuilder builder_(_fbb);
   builder_.add_nullcount(nullcount);
   builder_.add_stats(stats);
   builder_.add_name(name);
   builder_.add_strdata(strdata);
   builder_.add_data(data);
+  builder_.add_sorted(sorted);
   builder_.add_stats_type(stats_type);
   builder_.add_type(type);
   return builder_.Finish();
@@ -524,7 +534,8 @@ inline flatbuffers::Offset<Column> CreateColumnDirect(
     const char *name = nullptr,
     uint64_t nullcount = 0,
     Stats stats_type = Stats_NONE,
-    flatbuffers::Offset<void> stats = 0) {
+    flatbuffers::Offset<void> stats = 0,
+    uint8_t sorted = 0) {
   return jay::CreateColumn(
       _fbb,
       type,
@@ -533,7 +544,8 @@ inline flatbuffers::Offset<Column> CreateColumnDirect(
       name ? _fbb.CreateString(name) : 0,
       nullcount,
       stats_type,
-      stats);
+      stats,
+      sorted);
 }
 
 inline bool VerifyStats(flatbuffers::Verifier &, const void *, Stats type) {
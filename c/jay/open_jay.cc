@@ -156,6 +156,9 @@ static Column* column_from_jay(
     case jay::Type_Float64: initStats<double,  jay::StatsFloat64>(stats, jcol); break;
     default: break;
   }
+  if (jcol->sorted()) {
+    stats->set_sortedness_hint(static_cast<uint8_t>(jcol->sorted() - 1));
+  }
 
   return col;
 }
@@ -145,6 +145,11 @@ static flatbuffers::Offset<jay::Column> column_to_jay(
   cbb.add_type(stype_to_jaytype[static_cast<int>(col->stype())]);
   cbb.add_name(sname);
   cbb.add_nullcount(static_cast<uint64_t>(col->countna()));
+  // The sortedness is saved only if it is already known: computing it here
+  // would take an extra pass over the data of every column.
+  if (colstats && colstats->is_computed(Stat::Sorted)) {
+    cbb.add_sorted(static_cast<uint8_t>(1 + colstats->sortedness(col)));
+  }
 
   MemoryRange mbuf = col->data_buf();  // shallow copt of col's `mbuf`
   jay::Buffer saved_mbuf = saveMemoryRange(&mbuf, wb);
@@ -293,6 +293,7 @@ bool Aggregator<T>::sample_exemplars(size_t max_bins, size_t n_na_bins)
       }
     }
     dt_members->columns[0]->get_stats()->reset();
+    dt_members->reset_indices();
     was_sampled = true;
   }
 
@@ -347,6 +348,7 @@ void Aggregator<T>::aggregate_exemplars(bool was_sampled) {
     }
   }
   dt_members->columns[0]->get_stats()->reset();
+  dt_members->reset_indices();
 
   // Applying exemplars row index and binding exemplars with the counts.
   RowIndex ri_exemplars = RowIndex(std::move(exemplar_indices));
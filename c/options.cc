@@ -5,6 +5,7 @@
 //
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
+#include "expr/cse.h"  // dt::reduce_cache
 #include "python/_all.h"
 #include "python/ext_type.h"
 #include "python/obj.h"
@@ -25,11 +26,19 @@ size_t sort_max_chunk_length = 1 << 20;
 uint8_t sort_max_radix_bits = 16;
 uint8_t sort_over_radix_bits = 16;
 int32_t sort_nthreads = 1;
+size_t sort_max_int32_rows = INT32_MAX;
+size_t sort_memory_budget = 0;
+size_t sort_cache_size = size_t(1) << 28;
+bool sort_packed_strings = true;
 bool fread_anonymize = false;
 int64_t frame_names_auto_index = 0;
 std::string frame_names_auto_prefix = "C";
 bool display_interactive = false;
 bool display_interactive_hint = true;
+std::string groupby_method = "auto";
+size_t join_max_int32_rows = INT32_MAX;
+size_t expr_chunk_size = 4096;
+size_t expr_cache_size = 0;
 
 
 int32_t normalize_nthreads(int32_t nth) {
@@ -78,6 +87,25 @@ void set_sort_max_chunk_length(int64_t n) {
   sort_max_chunk_length = static_cast<size_t>(n);
 }
 
+// Thresholds for switching from 32- to 64-bit row indices: a value outside
+// of the range `[1, INT32_MAX]` resets the threshold to INT32_MAX.
+static size_t clamp_max_int32_rows(int64_t n) {
+  if (n < 1 || n > INT32_MAX) n = INT32_MAX;
+  return static_cast<size_t>(n);
+}
+
+void set_sort_max_int32_rows(int64_t n) {
+  sort_max_int32_rows = clamp_max_int32_rows(n);
+}
+
+void set_sort_memory_budget(int64_t n) {
+  sort_memory_budget = n < 0? 0 : static_cast<size_t>(n);
+}
+
+void set_sort_cache_size(int64_t n) {
+  sort_cache_size = n < 0? 0 : static_cast<size_t>(n);
+}
+
 void set_sort_max_radix_bits(int64_t n) {
   sort_max_radix_bits = static_cast<uint8_t>(n);
   if (sort_max_radix_bits <= 0)
@@ -98,6 +126,27 @@ void set_fread_anonymize(int8_t v) {
   fread_anonymize = v;
 }
 
+void set_groupby_method(const std::string& method) {
+  if (!(method == "auto" || method == "sort" || method == "hash")) {
+    throw ValueError() << "Invalid groupby.method parameter: `" << method
+        << "`; should be one of 'auto', 'sort' or 'hash'";
+  }
+  groupby_method = method;
+}
+
+void set_join_max_int32_rows(int64_t n) {
+  join_max_int32_rows = clamp_max_int32_rows(n);
+}
+
+void set_expr_chunk_size(int64_t n) {
+  expr_chunk_size = n < 0? 0 : static_cast<size_t>(n);
+}
+
+void set_expr_cache_size(int64_t n) {
+  expr_cache_size = n < 0? 0 : static_cast<size_t>(n);
+  dt::reduce_cache::trim();
+}
+
 
 
 static py::PKArgs args_set_option(
@@ -130,6 +179,18 @@ static py::oobj set_option(const py::PKArgs& args) {
   } else if (name == "sort.nthreads") {
     set_sort_nthreads(value.to_int32_strict());
 
+  } else if (name == "sort.max_int32_rows") {
+    set_sort_max_int32_rows(value.to_int64_strict());
+
+  } else if (name == "sort.memory_budget") {
+    set_sort_memory_budget(value.to_int64_strict());
+
+  } else if (name == "sort.cache_size") {
+    set_sort_cache_size(value.to_int64_strict());
+
+  } else if (name == "sort.packed_strings") {
+    sort_packed_strings = value.to_bool_strict();
+
   } else if (name == "core_logger") {
     set_core_logger(py::oobj(value).release());
 
@@ -148,6 +209,18 @@ static py::oobj set_option(const py::PKArgs& args) {
   } else if (name == "display.interactive_hint") {
     display_interactive_hint = value.to_bool_strict();
 
+  } else if (name == "groupby.method") {
+    set_groupby_method(value.to_string());
+
+  } else if (name == "join.max_int32_rows") {
+    set_join_max_int32_rows(value.to_int64_strict());
+
+  } else if (name == "expr.chunk_size") {
+    set_expr_chunk_size(value.to_int64_strict());
+
+  } else if (name == "expr.cache_size") {
+    set_expr_cache_size(value.to_int64_strict());
+
   } else {
     // throw ValueError() << "Unknown option `" << name << "`";
   }
@@ -185,6 +258,18 @@ static py::oobj get_option(const py::PKArgs& args) {
   } else if (name == "sort.nthreads") {
     return py::oint(sort_nthreads);
 
+  } else if (name == "sort.max_int32_rows") {
+    return py::oint(sort_max_int32_rows);
+
+  } else if (name == "sort.memory_budget") {
+    return py::oint(sort_memory_budget);
+
+  } else if (name == "sort.cache_size") {
+    return py::oint(sort_cache_size);
+
+  } else if (name == "sort.packed_strings") {
+    return py::obool(sort_packed_strings);
+
   } else if (name == "core_logger") {
     return logger? py::oobj(logger) : py::None();
 
@@ -203,6 +288,18 @@ static py::oobj get_option(const py::PKArgs& args) {
   } else if (name == "display.interactive_hint") {
     return py::obool(display_interactive_hint);
 
+  } else if (name == "groupby.method") {
+    return py::ostring(groupby_method);
+
+  } else if (name == "join.max_int32_rows") {
+    return py::oint(join_max_int32_rows);
+
+  } else if (name == "expr.chunk_size") {
+    return py::oint(expr_chunk_size);
+
+  } else if (name == "expr.cache_size") {
+    return py::oint(expr_cache_size);
+
   } else {
     throw ValueError() << "Unknown option `" << name << "`";
   }
@@ -21,11 +21,19 @@ extern size_t sort_max_chunk_length;
 extern uint8_t sort_max_radix_bits;
 extern uint8_t sort_over_radix_bits;
 extern int32_t sort_nthreads;
+extern size_t sort_max_int32_rows;
+extern size_t sort_memory_budget;
+extern size_t sort_cache_size;
+extern bool sort_packed_strings;
 extern bool fread_anonymize;
 extern int64_t frame_names_auto_index;
 extern std::string frame_names_auto_prefix;
 extern bool display_interactive;
 extern bool display_interactive_hint;
+extern std::string groupby_method;
+extern size_t join_max_int32_rows;
+extern size_t expr_chunk_size;
+extern size_t expr_cache_size;
 
 int32_t normalize_nthreads(int32_t nth);
 void set_nthreads(int32_t n);
@@ -36,7 +44,14 @@ void set_sort_max_chunk_length(int64_t n);
 void set_sort_max_radix_bits(int64_t n);
 void set_sort_over_radix_bits(int64_t n);
 void set_sort_nthreads(int32_t n);
+void set_sort_max_int32_rows(int64_t n);
+void set_sort_memory_budget(int64_t n);
+void set_sort_cache_size(int64_t n);
 void set_fread_anonymize(int8_t v);
+void set_groupby_method(const std::string& method);
+void set_join_max_int32_rows(int64_t n);
+void set_expr_chunk_size(int64_t n);
+void set_expr_cache_size(int64_t n);
 
 
 }
@@ -101,12 +101,12 @@ RowIndex::RowIndex(arr64_t&& arr, size_t min, size_t max) {
   TRACK(this, sizeof(*this), "RowIndex");
 }
 
-RowIndex::RowIndex(filterfn32* f, size_t n, bool sorted) {
+RowIndex::RowIndex(const filterfn32& f, size_t n, bool sorted) {
   impl = (new ArrayRowIndexImpl(f, n, sorted))->acquire();
   TRACK(this, sizeof(*this), "RowIndex");
 }
 
-RowIndex::RowIndex(filterfn64* f, size_t n, bool sorted) {
+RowIndex::RowIndex(const filterfn64& f, size_t n, bool sorted) {
   impl = (new ArrayRowIndexImpl(f, n, sorted))->acquire();
   TRACK(this, sizeof(*this), "RowIndex");
 }
@@ -213,6 +213,18 @@ void RowIndex::extract_into(arr32_t& target) const {
       std::memcpy(target.data(), indices32(), szlen * sizeof(int32_t));
       break;
     }
+    case RowIndexType::ARR64: {
+      if (max() <= INT32_MAX) {
+        const int64_t* src = indices64();
+        dt::run_interleaved(
+          [&](size_t i0, size_t i1, size_t di) {
+            for (size_t i = i0; i < i1; i += di) {
+              target[i] = static_cast<int32_t>(src[i]);
+            }
+          }, szlen);
+      }
+      break;
+    }
     case RowIndexType::SLICE: {
       if (szlen <= INT32_MAX && max() <= INT32_MAX) {
         size_t start = slice_start();
@@ -232,6 +244,42 @@ void RowIndex::extract_into(arr32_t& target) const {
 }
 
 
+void RowIndex::extract_into(arr64_t& target) const {
+  if (!impl) return;
+  size_t szlen = size();
+  xassert(target.size() >= szlen);
+  switch (impl->type) {
+    case RowIndexType::ARR32: {
+      const int32_t* src = indices32();
+      dt::run_interleaved(
+        [&](size_t i0, size_t i1, size_t di) {
+          for (size_t i = i0; i < i1; i += di) {
+            target[i] = static_cast<int64_t>(src[i]);
+          }
+        }, szlen);
+      break;
+    }
+    case RowIndexType::ARR64: {
+      std::memcpy(target.data(), indices64(), szlen * sizeof(int64_t));
+      break;
+    }
+    case RowIndexType::SLICE: {
+      size_t start = slice_start();
+      size_t step = slice_step();
+      dt::run_interleaved(
+        [&](size_t i0, size_t i1, size_t di) {
+          for (size_t i = i0; i < i1; i += di) {
+            target[i] = static_cast<int64_t>(start + i * step);
+          }
+        }, szlen);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+
 RowIndex operator *(const RowIndex& ri1, const RowIndex& ri2) {
   if (ri1.isabsent()) return RowIndex(ri2);
   if (ri2.isabsent()) return RowIndex(ri1);
@@ -21,6 +21,7 @@
 //------------------------------------------------------------------------------
 #ifndef dt_ROWINDEX_h
 #define dt_ROWINDEX_h
+#include <functional>     // std::function
 #include "utils/array.h"
 
 class Column;
@@ -35,8 +36,10 @@ enum class RowIndexType : uint8_t {
   SLICE = 3,
 };
 
-using filterfn32 = int (size_t row0, size_t row1, int32_t* ind, size_t* nouts);
-using filterfn64 = int (size_t row0, size_t row1, int64_t* ind, size_t* nouts);
+using filterfn32 = std::function<int(size_t row0, size_t row1, int32_t* ind,
+                                     size_t* nouts)>;
+using filterfn64 = std::function<int(size_t row0, size_t row1, int64_t* ind,
+                                     size_t* nouts)>;
 
 
 
@@ -99,11 +102,12 @@ class RowIndex {
      * multiple threads.
      *
      * @param f
-     *     Pointer to the filter function with the signature `(row0, row1, out,
-     *     &nouts) -> int`. The filter function has to determine which rows in
-     *     the range `row0:row1` are to be included, and write their indices
-     *     into the array `out`. It should also store in the variable `nouts`
-     *     the number of rows selected.
+     *     The filter function with the signature `(row0, row1, out, &nouts)
+     *     -> int`. The filter function has to determine which rows in the
+     *     range `row0:row1` are to be included, and write their indices into
+     *     the array `out`. It should also store in the variable `nouts` the
+     *     number of rows selected. The function is called from multiple
+     *     threads concurrently (at most 65536 rows at a time).
      *
      * @param n
      *     Number of rows in the datatable that is being filtered.
@@ -112,8 +116,8 @@ class RowIndex {
      *     When True indicates that the filter function is guaranteed to produce
      *     row index in sorted order.
      */
-    RowIndex(filterfn32* f, size_t n, bool sorted);
-    RowIndex(filterfn64* f, size_t n, bool sorted);
+    RowIndex(const filterfn32& f, size_t n, bool sorted);
+    RowIndex(const filterfn64& f, size_t n, bool sorted);
 
     /**
      * Create RowIndex from either a boolean or an integer column.
@@ -143,6 +147,7 @@ class RowIndex {
     size_t slice_step() const noexcept;
 
     void extract_into(arr32_t&) const;
+    void extract_into(arr64_t&) const;
 
     /**
      * Convert the RowIndex into an array `int8_t[nrows]`, where each entry
@@ -183,7 +183,7 @@ ArrayRowIndexImpl::ArrayRowIndexImpl(const Column* col) {
 }
 
 
-ArrayRowIndexImpl::ArrayRowIndexImpl(filterfn32* ff, size_t n, bool sorted) {
+ArrayRowIndexImpl::ArrayRowIndexImpl(const filterfn32& ff, size_t n, bool sorted) {
   xassert(n <= std::numeric_limits<int32_t>::max());
   ascending = sorted;
   data = nullptr;
@@ -247,7 +247,7 @@ ArrayRowIndexImpl::ArrayRowIndexImpl(filterfn32* ff, size_t n, bool sorted) {
 
       size_t row0 = i * rows_per_chunk;
       size_t row1 = std::min(row0 + rows_per_chunk, n);
-      (*ff)(row0, row1, buf.data(), &buf_length);
+      ff(row0, row1, buf.data(), &buf_length);
 
       #pragma omp ordered
       {
@@ -273,7 +273,7 @@ ArrayRowIndexImpl::ArrayRowIndexImpl(filterfn32* ff, size_t n, bool sorted) {
 }
 
 
-ArrayRowIndexImpl::ArrayRowIndexImpl(filterfn64* ff, size_t n, bool sorted) {
+ArrayRowIndexImpl::ArrayRowIndexImpl(const filterfn64& ff, size_t n, bool sorted) {
   ascending = sorted;
   data = nullptr;
   owned = true;
@@ -300,7 +300,7 @@ ArrayRowIndexImpl::ArrayRowIndexImpl(filterfn64* ff, size_t n, bool sorted) {
       }
       size_t row0 = i * rows_per_chunk;
       size_t row1 = std::min(row0 + rows_per_chunk, n);
-      (*ff)(row0, row1, buf.data(), &buf_length);
+      ff(row0, row1, buf.data(), &buf_length);
       #pragma omp ordered
       {
         out_offset = out_length;
@@ -394,9 +394,9 @@ void ArrayRowIndexImpl::init_from_boolean_column(const BoolColumn* col) {
     auto ind32 = static_cast<int32_t*>(data);
     size_t k = 0;
     col->rowindex().iterate(0, col->nrows, 1,
-      [&](size_t, size_t j) {
+      [&](size_t i, size_t j) {
         if (tdata[j] == 1)
-          ind32[k++] = static_cast<int32_t>(j);
+          ind32[k++] = static_cast<int32_t>(i);
       });
   } else {
     type = RowIndexType::ARR64;
@@ -404,9 +404,9 @@ void ArrayRowIndexImpl::init_from_boolean_column(const BoolColumn* col) {
     auto ind64 = static_cast<int64_t*>(data);
     size_t k = 0;
     col->rowindex().iterate(0, col->nrows, 1,
-      [&](size_t, size_t j) {
+      [&](size_t i, size_t j) {
         if (tdata[j] == 1)
-          ind64[k++] = static_cast<int64_t>(j);
+          ind64[k++] = static_cast<int64_t>(i);
       });
   }
   ascending = true;
@@ -475,12 +475,14 @@ RowIndexImpl* ArrayRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
     if (type == RowIndexType::ARR32) {
       auto ind32 = static_cast<const int32_t*>(data);
       for (size_t i = 0; i < length; ++i) {
+        if (ind32[i] < 0) { rowsres[i] = -1; continue; }
         size_t j = start + static_cast<size_t>(ind32[i]) * step;
         rowsres[i] = static_cast<int64_t>(j);
       }
     } else {
       auto ind64 = static_cast<const int64_t*>(data);
       for (size_t i = 0; i < length; ++i) {
+        if (ind64[i] < 0) { rowsres[i] = -1; continue; }
         size_t j = start + static_cast<size_t>(ind64[i]) * step;
         rowsres[i] = static_cast<int64_t>(j);
       }
@@ -497,7 +499,7 @@ RowIndexImpl* ArrayRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
     auto rows_ab = static_cast<const int32_t*>(arii->data);
     auto rows_bc = static_cast<const int32_t*>(data);
     for (size_t i = 0; i < length; ++i) {
-      rowsres[i] = rows_ab[rows_bc[i]];
+      rowsres[i] = rows_bc[i] < 0? -1 : rows_ab[rows_bc[i]];
     }
     bool res_sorted = ascending && arii->ascending;
     return new ArrayRowIndexImpl(std::move(rowsres), res_sorted);
@@ -509,21 +511,21 @@ RowIndexImpl* ArrayRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
       auto rows_ab = static_cast<const int32_t*>(arii->data);
       auto rows_bc = static_cast<const int64_t*>(data);
       for (size_t i = 0; i < length; ++i) {
-        rowsres[i] = rows_ab[rows_bc[i]];
+        rowsres[i] = rows_bc[i] < 0? -1 : rows_ab[rows_bc[i]];
       }
     }
     if (uptype == RowIndexType::ARR64 && type == RowIndexType::ARR32) {
       auto rows_ab = static_cast<const int64_t*>(arii->data);
       auto rows_bc = static_cast<const int32_t*>(data);
       for (size_t i = 0; i < length; ++i) {
-        rowsres[i] = rows_ab[rows_bc[i]];
+        rowsres[i] = rows_bc[i] < 0? -1 : rows_ab[rows_bc[i]];
       }
     }
     if (uptype == RowIndexType::ARR64 && type == RowIndexType::ARR64) {
       auto rows_ab = static_cast<const int64_t*>(arii->data);
       auto rows_bc = static_cast<const int64_t*>(data);
       for (size_t i = 0; i < length; ++i) {
-        rowsres[i] = rows_ab[rows_bc[i]];
+        rowsres[i] = rows_bc[i] < 0? -1 : rows_ab[rows_bc[i]];
       }
     }
     bool res_sorted = ascending && arii->ascending;
@@ -543,7 +545,7 @@ RowIndexImpl* ArrayRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
 void ArrayRowIndexImpl::compactify()
 {
   if (type == RowIndexType::ARR32) return;
-  if ((max > INT32_MAX && max != RowIndex::MAX) || length > INT32_MAX) return;
+  if ((max > INT32_MAX && max != RowIndex::NA) || length > INT32_MAX) return;
 
   int32_t* ind32 = static_cast<int32_t*>(data);
   int64_t* ind64 = static_cast<int64_t*>(data);
@@ -33,14 +33,17 @@ namespace dt {
 namespace set {
 
 struct ccolvec {
-  std::vector<const Column*> cols;
-  std::string colname;
+  std::vector<colvec> cols;  // for each input frame, the list of its columns
+  std::vector<const DataTable*> frames;  // the input frames themselves
+  strvec colnames;
+  // For each column, an upper bound on the number of distinct values in that
+  // column across all frames (including NAs), or 0 if unknown.
+  std::vector<size_t> nuniques;
 };
 
 struct sort_result {
   std::vector<size_t> sizes;
-  std::unique_ptr<Column> col;
-  std::string colname;
+  dtptr dt;
   RowIndex ri;
   Groupby gb;
 };
@@ -50,43 +53,83 @@ struct sort_result {
 // helper functions
 //------------------------------------------------------------------------------
 
-static py::oobj make_pyframe(sort_result& sr, arr32_t&& arr) {
+template <typename V>
+static py::oobj make_pyframe(sort_result& sr, dt::array<V>&& arr) {
   // The array of rowindices `arr` is typically shuffled because the values
   // in the input are sorted before they are compared.
   RowIndex out_ri = RowIndex(std::move(arr), false);
-  Column* out_col = sr.col->shallowcopy(out_ri);
-  out_col->reify();
-  DataTable* dt = new DataTable({out_col}, {sr.colname});
+  colvec out_cols;
+  for (const Column* col : sr.dt->columns) {
+    Column* out_col = col->shallowcopy(out_ri);
+    out_col->reify();
+    out_cols.push_back(out_col);
+  }
+  DataTable* dt = new DataTable(std::move(out_cols), sr.dt->get_names());
   return py::oobj::from_new_reference(py::Frame::from_datatable(dt));
 }
 
-static void verify_frame_1column(DataTable* dt) {
-  if (dt->ncols == 1) return;
-  throw ValueError() << "Only single-column Frames are allowed, but received "
-      "a Frame with " << dt->ncols << " columns";
+// Group offsets and row indices of the sorted frame, which are either 32- or
+// 64-bit depending on the size of the frame.
+template <typename V> static const V* group_offsets(const sort_result&);
+template <typename V> static const V* sorted_indices(const sort_result&);
+
+template <> const int32_t* group_offsets(const sort_result& sr) {
+  return sr.gb.offsets_r();
+}
+template <> const int64_t* group_offsets(const sort_result& sr) {
+  return sr.gb.offsets64_r();
+}
+template <> const int32_t* sorted_indices(const sort_result& sr) {
+  return sr.ri.indices32();
+}
+template <> const int64_t* sorted_indices(const sort_result& sr) {
+  return sr.ri.indices64();
+}
+
+static void add_frame(ccolvec& cc, DataTable* dt, const py::PKArgs& args) {
+  if (dt->ncols == 0) return;
+  if (cc.cols.empty()) {
+    cc.colnames = dt->get_names();
+    cc.nuniques.resize(dt->ncols, 0);
+  }
+  else if (dt->ncols != cc.colnames.size()) {
+    throw ValueError() << "Frames passed to " << args.get_short_name()
+        << "() must have the same number of columns, however the first "
+        "frame has " << cc.colnames.size() << " column"
+        << (cc.colnames.size() == 1? "" : "s") << ", while another has "
+        << dt->ncols;
+  }
+  size_t nframes = cc.cols.size();
+  colvec cols;
+  for (size_t i = 0; i < dt->ncols; ++i) {
+    const Column* col = dt->columns[i];
+    // Only use the stats that were already computed: computing the number
+    // of unique values requires a sort, defeating the purpose.
+    Stats* stats = col->get_stats_if_exist();
+    size_t nu = 0;
+    if (col->stype() == SType::BOOL) nu = 3;
+    else if (stats && stats->is_computed(Stat::NUnique)) {
+      nu = stats->nunique(col) + 1;
+    }
+    if (nu == 0 || (nframes && cc.nuniques[i] == 0)) cc.nuniques[i] = 0;
+    else cc.nuniques[i] += nu;
+    Column* colcopy = col->shallowcopy();
+    colcopy->reify();
+    cols.push_back(colcopy);
+  }
+  cc.cols.push_back(std::move(cols));
+  cc.frames.push_back(dt);
 }
 
 static ccolvec columns_from_args(const py::PKArgs& args) {
   ccolvec res;
   for (auto va : args.varargs()) {
     if (va.is_frame()) {
-      DataTable* dt = va.to_frame();
-      if (dt->ncols == 0) continue;
-      verify_frame_1column(dt);
-      Column* col = dt->columns[0]->shallowcopy();
-      col->reify();
-      res.cols.push_back(col);
-      if (res.colname.empty()) res.colname = dt->get_names()[0];
+      add_frame(res, va.to_frame(), args);
     }
     else if (va.is_iterable()) {
       for (auto item : va.to_oiter()) {
-        DataTable* dt = item.to_frame();
-        if (dt->ncols == 0) continue;
-        verify_frame_1column(dt);
-        Column* col = dt->columns[0]->shallowcopy();
-        col->reify();
-        res.cols.push_back(col);
-        if (res.colname.empty()) res.colname = dt->get_names()[0];
+        add_frame(res, item.to_frame(), args);
       }
     }
     else {
@@ -97,42 +140,77 @@ static ccolvec columns_from_args(const py::PKArgs& args) {
   return res;
 }
 
-static sort_result sort_columns(ccolvec&& cv) {
-  std::vector<const Column*>& cols = cv.cols;
-  xassert(!cols.empty());
+
+/**
+ * Decide whether the rows of the combined frame should be grouped via a hash
+ * table rather than sorted. Hashing is beneficial when the number of distinct
+ * rows is small compared to the total number of rows, since then only the
+ * distinct rows need to be sorted. The cardinality is estimated from the
+ * `nunique` stats of the input columns. When it is not known, the hash is
+ * used for multi-column frames only: sorting by K columns requires K passes
+ * over the data, whereas the hash looks at all columns at once.
+ */
+static bool use_hash_grouping(const std::vector<size_t>& nuniques,
+                              const DataTable* dt)
+{
+  for (const Column* col : dt->columns) {
+    if (col->stype() == SType::OBJ) return false;
+  }
+  double card = 1.0;
+  for (size_t nu : nuniques) {
+    if (nu == 0) return dt->ncols > 1;
+    card *= static_cast<double>(nu);
+  }
+  return card * 4 <= static_cast<double>(dt->nrows);
+}
+
+
+static sort_result sort_columns(ccolvec&& cc) {
+  std::vector<colvec>& frames = cc.cols;
+  xassert(!frames.empty());
   sort_result res;
-  res.colname = std::move(cv.colname);
   size_t cumsize = 0;
-  for (auto col : cols) {
-    cumsize += col->nrows;
+  for (auto& fcols : frames) {
+    cumsize += fcols[0]->nrows;
     res.sizes.push_back(cumsize);
   }
-  if (cols.size() == 1) {
-    res.col = std::unique_ptr<Column>(const_cast<Column*>(cols[0]));
-    res.col->reify();
-  } else {
-    // Note: `rbind` will delete all the columns in the vector `cols`...
-    // Therefore, `cols` cannot be used after this call
-    res.col = std::unique_ptr<Column>((new VoidColumn(0))->rbind(cols));
-  }
-  res.ri = res.col->sort(&res.gb);
 
+  size_t ncols = cc.colnames.size();
+  colvec columns;
+  for (size_t i = 0; i < ncols; ++i) {
+    if (frames.size() == 1) {
+      columns.push_back(frames[0][i]);
+    } else {
+      // Note: `rbind` will delete all the columns in the vector `cols`...
+      // Therefore, these columns cannot be used after this call
+      std::vector<const Column*> cols;
+      for (auto& fcols : frames) cols.push_back(fcols[i]);
+      columns.push_back((new VoidColumn(0))->rbind(cols));
+    }
+  }
+  res.dt = dtptr(new DataTable(std::move(columns), cc.colnames));
+  // A single input frame is grouped directly, so that the result is taken
+  // from (and stored into) that frame's sort cache. Its rows are the same as
+  // the rows of `res.dt`.
+  const DataTable* gdt = frames.size() == 1? cc.frames[0] : res.dt.get();
+  bool hash = use_hash_grouping(cc.nuniques, gdt);
+
+  std::vector<sort_spec> spec;
+  for (size_t i = 0; i < ncols; ++i) spec.push_back(sort_spec(i));
+  auto rigb = hash? gdt->group_hashed(spec) : gdt->group(spec);
+  res.ri = std::move(rigb.first);
+  res.gb = std::move(rigb.second);
   return res;
 }
 
 
-static py::oobj _union(ccolvec&& cols) {
-  if (cols.cols.empty()) {
-    return py::oobj::from_new_reference(
-              py::Frame::from_datatable(new DataTable()));
-  }
-  sort_result sorted = sort_columns(std::move(cols));
-
+template <typename V>
+static py::oobj _union_impl(sort_result& sorted) {
   size_t ngrps = sorted.gb.ngroups();
-  const int32_t* goffsets = sorted.gb.offsets_r();
-  const int32_t* indices = sorted.ri.indices32();
-  arr32_t arr(ngrps);
-  int32_t* out_indices = arr.data();
+  const V* goffsets = group_offsets<V>(sorted);
+  const V* indices = sorted_indices<V>(sorted);
+  dt::array<V> arr(ngrps);
+  V* out_indices = arr.data();
 
   for (size_t i = 0; i < ngrps; ++i) {
     out_indices[i] = indices[goffsets[i]];
@@ -140,6 +218,16 @@ static py::oobj _union(ccolvec&& cols) {
   return make_pyframe(sorted, std::move(arr));
 }
 
+static py::oobj _union(ccolvec&& cols) {
+  if (cols.cols.empty()) {
+    return py::oobj::from_new_reference(
+              py::Frame::from_datatable(new DataTable()));
+  }
+  sort_result sorted = sort_columns(std::move(cols));
+  return sorted.gb.is64()? _union_impl<int64_t>(sorted)
+                         : _union_impl<int32_t>(sorted);
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -154,15 +242,15 @@ static py::PKArgs args_unique(
 R"(unique(frame)
 --
 
-Find the unique values in the ``frame``.
+Find the unique rows in the ``frame``.
 
-The ``frame`` can have multiple columns, in which case the unique values from
-all columns taken together will be returned.
+The ``frame`` can have multiple columns, in which case two rows are considered
+equal only if they are equal in all columns.
 
-This methods sorts the values in order to find the uniques. Thus, the return
-values will be ordered. However, this should be considered an implementation
-detail: in the future we may use a different algorithm (such as hash-based),
-which may return the results in a different order.
+The unique rows are found either by sorting the ``frame``, or with a hash
+table followed by sorting of only the unique rows; the algorithm is chosen
+based on the estimated number of unique rows. In both cases the returned rows
+will be ordered. However, this should be considered an implementation detail.
 )");
 
 
@@ -173,12 +261,7 @@ static py::oobj unique(const py::PKArgs& args) {
   DataTable* dt = args[0].to_frame();
 
   ccolvec cc;
-  for (auto col : dt->columns) {
-    cc.cols.push_back(col->shallowcopy());
-  }
-  if (dt->ncols == 1) {
-    cc.colname = dt->get_names()[0];
-  }
+  add_frame(cc, dt, args);
   return _union(std::move(cc));
 }
 
@@ -198,10 +281,10 @@ R"(union(*frames)
 
 Find the union of values in all `frames`.
 
-Each frame should have only a single column (however, empty frames are allowed
-too). The values in each frame will be treated as a set, and this function will
+All frames should have the same number of columns (however, empty frames are
+allowed too). The rows in each frame will be treated as a set, and this function will
 perform the Union operation on these sets. The result will be returned as a
-single-column Frame. Input `frames` are allowed to have different stypes, in
+Frame. Input `frames` are allowed to have different stypes, in
 which case they will be upcasted to the smallest common stype, similar to the
 functionality of ``rbind()``.
 
@@ -220,15 +303,13 @@ static py::oobj union_(const py::PKArgs& args) {
 // intersect()
 //------------------------------------------------------------------------------
 
-template <bool TWO>
-static py::oobj _intersect(ccolvec&& cc) {
-  size_t K = cc.cols.size();
-  sort_result sorted = sort_columns(std::move(cc));
+template <bool TWO, typename V>
+static py::oobj _intersect_impl(sort_result& sorted, size_t K) {
   size_t ngrps = sorted.gb.ngroups();
-  const int32_t* goffsets = sorted.gb.offsets_r();
-  const int32_t* indices = sorted.ri.indices32();
-  arr32_t arr(ngrps);
-  int32_t* out_indices = arr.data();
+  const V* goffsets = group_offsets<V>(sorted);
+  const V* indices = sorted_indices<V>(sorted);
+  dt::array<V> arr(ngrps);
+  V* out_indices = arr.data();
   size_t j = 0;
 
   if (TWO) {
@@ -236,11 +317,11 @@ static py::oobj _intersect(ccolvec&& cc) {
     // first element in a group is < n1 (belongs to column 0), and the last is
     // >= n1 (belongs to column 1).
     xassert(K == 2);
-    int32_t n1 = static_cast<int32_t>(sorted.sizes[0]);
+    V n1 = static_cast<V>(sorted.sizes[0]);
     for (size_t i = 0; i < ngrps; ++i) {
-      int32_t x = indices[goffsets[i]];
+      V x = indices[goffsets[i]];
       if (x < n1) {
-        int32_t y = indices[goffsets[i + 1] - 1];
+        V y = indices[goffsets[i + 1] - 1];
         if (y >= n1) {
           out_indices[j++] = x;
         }
@@ -251,15 +332,15 @@ static py::oobj _intersect(ccolvec&& cc) {
     // for each element in a group we check whether it belongs to each
     // of the K input vectors.
     xassert(K > 2);
-    int32_t iK = static_cast<int32_t>(K);
-    int32_t off0, off1 = 0;
+    V iK = static_cast<V>(K);
+    V off0, off1 = 0;
     for (size_t i = 1; i <= ngrps; ++i) {
       off0 = off1;
       off1 = goffsets[i];
-      int32_t ii = off0;
+      V ii = off0;
       if (off0 + iK > off1) continue;
       for (size_t k = 0; k < K; ++k) {
-        int32_t nk = static_cast<int32_t>(sorted.sizes[k]);
+        V nk = static_cast<V>(sorted.sizes[k]);
         if (indices[ii] >= nk) goto cont_outer_loop;
         while (ii < off1 && indices[ii] < nk) ++ii;
         if (ii == off1) {
@@ -276,6 +357,14 @@ static py::oobj _intersect(ccolvec&& cc) {
   return make_pyframe(sorted, std::move(arr));
 }
 
+template <bool TWO>
+static py::oobj _intersect(ccolvec&& cc) {
+  size_t K = cc.cols.size();
+  sort_result sorted = sort_columns(std::move(cc));
+  return sorted.gb.is64()? _intersect_impl<TWO, int64_t>(sorted, K)
+                         : _intersect_impl<TWO, int32_t>(sorted, K);
+}
+
 
 static py::PKArgs args_intersect(
     0, 0, 0,
@@ -287,10 +376,10 @@ R"(intersect(*frames)
 
 Find the intersection of sets of values in all `frames`.
 
-Each frame should have only a single column (however, empty frames are allowed
-too). The values in each frame will be treated as a set, and this function will
+All frames should have the same number of columns (however, empty frames are
+allowed too). The rows in each frame will be treated as a set, and this function will
 perform the Intersection operation on these sets. The result will be returned
-as a single-column Frame. Input `frames` are allowed to have different stypes,
+as a Frame. Input `frames` are allowed to have different stypes,
 in which case they will be upcasted to the smallest common stype, similar to the
 functionality of ``rbind()``.
 
@@ -317,20 +406,19 @@ static py::oobj intersect(const py::PKArgs& args) {
 // setdiff()
 //------------------------------------------------------------------------------
 
-static py::oobj _setdiff(ccolvec&& cc) {
-  xassert(cc.cols.size() >= 2);
-  sort_result sorted = sort_columns(std::move(cc));
+template <typename V>
+static py::oobj _setdiff_impl(sort_result& sorted) {
   size_t ngrps = sorted.gb.ngroups();
-  const int32_t* goffsets = sorted.gb.offsets_r();
-  const int32_t* indices = sorted.ri.indices32();
-  arr32_t arr(ngrps);
-  int32_t* out_indices = arr.data();
+  const V* goffsets = group_offsets<V>(sorted);
+  const V* indices = sorted_indices<V>(sorted);
+  dt::array<V> arr(ngrps);
+  V* out_indices = arr.data();
   size_t j = 0;
 
-  int32_t n1 = static_cast<int32_t>(sorted.sizes[0]);
+  V n1 = static_cast<V>(sorted.sizes[0]);
   for (size_t i = 0; i < ngrps; ++i) {
-    int32_t x = indices[goffsets[i]];
-    int32_t y = indices[goffsets[i + 1] - 1];
+    V x = indices[goffsets[i]];
+    V y = indices[goffsets[i + 1] - 1];
     if (x < n1 && y < n1) {
       out_indices[j++] = x;
     }
@@ -339,6 +427,13 @@ static py::oobj _setdiff(ccolvec&& cc) {
   return make_pyframe(sorted, std::move(arr));
 }
 
+static py::oobj _setdiff(ccolvec&& cc) {
+  xassert(cc.cols.size() >= 2);
+  sort_result sorted = sort_columns(std::move(cc));
+  return sorted.gb.is64()? _setdiff_impl<int64_t>(sorted)
+                         : _setdiff_impl<int32_t>(sorted);
+}
+
 
 static py::PKArgs args_setdiff(
     0, 0, 0,
@@ -350,10 +445,10 @@ R"(setdiff(frame0, *frames)
 
 Find the set-difference between `frame0` and the other `frames`.
 
-Each frame should have only a single column (however, empty frames are allowed
-too). The values in each frame will be treated as a set, and this function will
+All frames should have the same number of columns (however, empty frames are
+allowed too). The rows in each frame will be treated as a set, and this function will
 compute the set difference between the first frame and the union of the other
-frames. The result will be returned as a single-column Frame. Input frames
+frames. The result will be returned as a Frame. Input frames
 are allowed to have different stypes, in which case they will be upcasted to
 the smallest common stype, similar to the functionality of ``rbind()``.
 
@@ -375,15 +470,13 @@ static py::oobj setdiff(const py::PKArgs& args) {
 // symdiff()
 //------------------------------------------------------------------------------
 
-template <bool TWO>
-static py::oobj _symdiff(ccolvec&& cc) {
-  size_t K = cc.cols.size();
-  sort_result sr = sort_columns(std::move(cc));
+template <bool TWO, typename V>
+static py::oobj _symdiff_impl(sort_result& sr, size_t K) {
   size_t ngrps = sr.gb.ngroups();
-  const int32_t* goffsets = sr.gb.offsets_r();
-  const int32_t* indices = sr.ri.indices32();
-  arr32_t arr(ngrps);
-  int32_t* out_indices = arr.data();
+  const V* goffsets = group_offsets<V>(sr);
+  const V* indices = sorted_indices<V>(sr);
+  dt::array<V> arr(ngrps);
+  V* out_indices = arr.data();
   size_t j = 0;
 
   if (TWO) {
@@ -391,10 +484,10 @@ static py::oobj _symdiff(ccolvec&& cc) {
     // first element in a group belongs to the same column as the last element
     // in a group
     xassert(K == 2);
-    int32_t n1 = static_cast<int32_t>(sr.sizes[0]);
+    V n1 = static_cast<V>(sr.sizes[0]);
     for (size_t i = 0; i < ngrps; ++i) {
-      int32_t x = indices[goffsets[i]];
-      int32_t y = indices[goffsets[i + 1] - 1];
+      V x = indices[goffsets[i]];
+      V y = indices[goffsets[i + 1] - 1];
       if ((x < n1) == (y < n1)) {
         out_indices[j++] = x;
       }
@@ -404,14 +497,14 @@ static py::oobj _symdiff(ccolvec&& cc) {
     // for each group count the number of columns that have elements in
     // that group.
     xassert(K > 2);
-    int32_t off0, off1 = 0;
+    V off0, off1 = 0;
     for (size_t i = 1; i <= ngrps; ++i) {
       off0 = off1;
       off1 = goffsets[i];
-      int32_t ii = off0;
+      V ii = off0;
       size_t kk = 0;  // number of columns whose elements are in this group
       for (size_t k = 0; k < K; ++k) {
-        int32_t nk = static_cast<int32_t>(sr.sizes[k]);
+        V nk = static_cast<V>(sr.sizes[k]);
         if (indices[ii] >= nk) continue;
         kk++;
         while (ii < off1 && indices[ii] < nk) ++ii;
@@ -426,6 +519,14 @@ static py::oobj _symdiff(ccolvec&& cc) {
   return make_pyframe(sr, std::move(arr));
 }
 
+template <bool TWO>
+static py::oobj _symdiff(ccolvec&& cc) {
+  size_t K = cc.cols.size();
+  sort_result sr = sort_columns(std::move(cc));
+  return sr.gb.is64()? _symdiff_impl<TWO, int64_t>(sr, K)
+                     : _symdiff_impl<TWO, int32_t>(sr, K);
+}
+
 
 static py::PKArgs args_symdiff(
     0, 0, 0,
@@ -437,10 +538,10 @@ R"(symdiff(*frames)
 
 Find the symmetric difference between the sets of values in all `frames`.
 
-Each frame should have only a single column (however, empty frames are allowed
-too). The values in each frame will be treated as a set, and this function will
+All frames should have the same number of columns (however, empty frames are
+allowed too). The rows in each frame will be treated as a set, and this function will
 perform the Symmetric Difference operation on these sets. The result will be
-returned as a single-column Frame. Input `frames` are allowed to have different
+returned as a Frame. Input `frames` are allowed to have different
 stypes, in which case they will be upcasted to the smallest common stype,
 similar to the functionality of ``rbind()``.
 
@@ -36,7 +36,7 @@
 //      https://en.wikipedia.org/wiki/Radix_sort
 //      https://en.wikipedia.org/wiki/Insertion_sort
 //      http://stereopsis.com/radix.html
-//      /microbench/sort
+//      benchmarks/bench.py, c/zbench.cc  (benchmarks)
 //
 // Based on the parallel radix sort algorithm by Matt Dowle in (R)data.table:
 //      https://github.com/Rdatatable/data.table/src/forder.c
@@ -125,7 +125,10 @@
 #include <algorithm>  // std::min
 #include <cstdlib>    // std::abs
 #include <cstring>    // std::memset, std::memcpy
+#include <memory>     // std::unique_ptr
+#include <sstream>    // std::ostringstream
 #include <vector>     // std::vector
+#include <unistd.h>   // getpid
 #include "column.h"
 #include "datatable.h"
 #include "datatablemodule.h"
@@ -137,7 +140,9 @@
 #include "utils/alloc.h"
 #include "utils/array.h"
 #include "utils/assert.h"
+#include "utils/file.h"
 #include "utils/parallel.h"
+#include "writebuf.h"
 
 //------------------------------------------------------------------------------
 // Helper classes for managing memory
@@ -243,6 +248,135 @@ void swap(rmem& left, rmem& right) noexcept {
 
 
 
+//------------------------------------------------------------------------------
+// Sort keys
+//------------------------------------------------------------------------------
+
+/**
+ * Order-preserving 64-bit key of the values in a column, used whenever the
+ * rows have to be compared one by one rather than radix-sorted: when merging
+ * the sorted runs of an external sort, and when checking or merging already
+ * sorted data. The `row` arguments are indices into the column's data (i.e.
+ * after applying its rowindex, if any). NAs map to 0, and all other values
+ * to non-zero keys in the same order as the radix sort uses.
+ * For non-string columns distinct values have distinct keys; for strings the
+ * key contains only the first 7 characters, and `compare()` has to look at
+ * the rest of the string whenever the keys are equal.
+ */
+class SortKey {
+  private:
+    const void* data;
+    const uint8_t* strdata;
+    SType stype;
+    bool descending;
+    size_t : 48;
+
+  public:
+    SortKey(const Column* col, bool desc)
+      : data(col->data()), strdata(nullptr), stype(col->stype()),
+        descending(desc)
+    {
+      if (stype == SType::VOID || stype == SType::OBJ) {
+        throw NotImplError() << "Unable to sort Column of stype " << stype;
+      }
+      if (stype == SType::STR32) {
+        auto scol = static_cast<const StringColumn<uint32_t>*>(col);
+        data = scol->offsets();
+        strdata = scol->ustrdata();
+      }
+      if (stype == SType::STR64) {
+        auto scol = static_cast<const StringColumn<uint64_t>*>(col);
+        data = scol->offsets();
+        strdata = scol->ustrdata();
+      }
+    }
+
+    uint64_t key(size_t row) const {
+      uint64_t k = 0;
+      switch (stype) {
+        case SType::BOOL:
+          return descending
+            ? static_cast<uint8_t>(128 - get<int8_t>(row)) >> 6
+            : static_cast<uint8_t>(get<int8_t>(row) + 191) >> 6;
+        case SType::INT8:    k = _int_key<int8_t>(row); break;
+        case SType::INT16:   k = _int_key<int16_t>(row); break;
+        case SType::INT32:   k = _int_key<int32_t>(row); break;
+        case SType::INT64:   k = _int_key<int64_t>(row); break;
+        case SType::FLOAT32: return _float_key<uint32_t>(row);
+        case SType::FLOAT64: return _float_key<uint64_t>(row);
+        case SType::STR32:   k = _str_key<uint32_t>(row); break;
+        case SType::STR64:   k = _str_key<uint64_t>(row); break;
+        default:
+          throw NotImplError() << "Unable to sort Column of stype " << stype;
+      }
+      // For descending order reverse the non-NA keys: k -> 2^64 - k
+      return (descending && k)? (0 - k) : k;
+    }
+
+    /**
+     * Compare rows `a` and `b` whose keys are `ka` and `kb` respectively.
+     * Return negative, zero or positive value if row `a` sorts before, same
+     * as, or after row `b`.
+     */
+    int compare(size_t a, uint64_t ka, size_t b, uint64_t kb) const {
+      if (ka != kb) return (ka < kb)? -1 : 1;
+      if (ka == 0) return 0;
+      int r = stype == SType::STR32? _str_compare<uint32_t>(a, b) :
+              stype == SType::STR64? _str_compare<uint64_t>(a, b) : 0;
+      return descending? -r : r;
+    }
+
+  private:
+    template <typename T> T get(size_t row) const {
+      return static_cast<const T*>(data)[row];
+    }
+
+    template <typename T> uint64_t _int_key(size_t row) const {
+      T v = get<T>(row);
+      if (ISNA<T>(v)) return 0;
+      return static_cast<uint64_t>(static_cast<int64_t>(v)) ^ (1ULL << 63);
+    }
+
+    // Same transform as in `SortContext::_initF()`
+    template <typename TO> uint64_t _float_key(size_t row) const {
+      constexpr TO EXP
+        = static_cast<TO>(sizeof(TO) == 8? 0x7FF0000000000000ULL : 0x7F800000);
+      constexpr TO SIG
+        = static_cast<TO>(sizeof(TO) == 8? 0x000FFFFFFFFFFFFFULL : 0x007FFFFF);
+      constexpr TO SBT
+        = static_cast<TO>(sizeof(TO) == 8? 0x8000000000000000ULL : 0x80000000);
+      constexpr int SHIFT = sizeof(TO) * 8 - 1;
+      TO t = get<TO>(row);
+      if ((t & EXP) == EXP && (t & SIG) != 0) return 0;
+      return descending? t ^ (~SBT & ((t>>SHIFT) - 1))
+                       : t ^ (SBT | -(t>>SHIFT));
+    }
+
+    // The first 7 characters of the string go into the upper 7 bytes of the
+    // key, and the lowest byte is `1 + min(len, 7)`.
+    template <typename T> uint64_t _str_key(size_t row) const {
+      const T* offs = static_cast<const T*>(data);
+      T end = offs[row];
+      if (ISNA<T>(end)) return 0;
+      T start = offs[row - 1] & ~GETNA<T>();
+      size_t len = std::min(static_cast<size_t>(end - start), size_t(7));
+      uint64_t k = 0;
+      for (size_t i = 0; i < len; ++i) {
+        k |= static_cast<uint64_t>(strdata[start + i]) << (56 - 8 * i);
+      }
+      return k | (len + 1);
+    }
+
+    template <typename T> int _str_compare(size_t a, size_t b) const {
+      const T* offs = static_cast<const T*>(data);
+      return compare_offstrings<-1, T>(
+          strdata, offs[a - 1] & ~GETNA<T>(), offs[a],
+                   offs[b - 1] & ~GETNA<T>(), offs[b]);
+    }
+};
+
+
+
 //------------------------------------------------------------------------------
 // SortContext
 //------------------------------------------------------------------------------
@@ -288,6 +422,12 @@ void swap(rmem& left, rmem& right) noexcept {
  *   starting from each we need to sort. The assertion being that all prefixes
  *   before position `strstart` are already properly sorted.
  *
+ * strpacked
+ *   Same as `strtype`, but for the string columns whose keys in `x` are
+ *   their packed prefixes (see `_initS_packed()`), while `strtype` is 0. This
+ *   is set only if some of the strings are longer than the prefixes, so that
+ *   the groups of tied prefixes may need to be sorted further.
+ *
  * nsigbits
  *   Number of significant bits in the elements of `x`. This cannot exceed
  *   `8 * elemsize`, but could be less. This value is an assertion that all
@@ -345,20 +485,21 @@ void swap(rmem& left, rmem& right) noexcept {
  *   Size in bytes of each element in `xx`. This cannot be greater than
  *   `elemsize`, however `next_elemsize` can be 0.
  */
+template <typename V>
 class SortContext {
   private:
-    arr32_t groups;
+    dt::array<V> groups;
     omem container_x;
     omem container_xx;
     omem container_o;
     omem container_oo;
     dt::array<size_t> arr_hist;
-    GroupGatherer gg;
+    GroupGatherer<V> gg;
 
     rmem x;
     rmem xx;
-    int32_t* o;
-    int32_t* next_o;
+    V* o;
+    V* next_o;
     size_t*  histogram;
     const uint8_t* strdata;
     const void* stroffs;
@@ -373,9 +514,9 @@ class SortContext {
     uint8_t nsigbits;
     uint8_t shift;
     uint8_t strtype;
+    uint8_t strpacked;
     bool use_order;
     bool descending;
-    int : 8;
 
   public:
   SortContext(size_t nrows, const RowIndex& rowindex, bool make_groups) {
@@ -383,15 +524,16 @@ class SortContext {
     next_o = nullptr;
     strdata = nullptr;
     histogram = nullptr;
+    strpacked = 0;
     use_order = false;
     descending = false;
 
     nth = static_cast<size_t>(config::sort_nthreads);
     n = nrows;
-    container_o.ensure_size(n * sizeof(int32_t));
-    o = static_cast<int32_t*>(container_o.ptr);
+    container_o.ensure_size(n * sizeof(V));
+    o = static_cast<V*>(container_o.ptr);
     if (rowindex) {
-      arr32_t co(n, o);
+      dt::array<V> co(n, o);
       rowindex.extract_into(co);
       use_order = true;
     }
@@ -408,11 +550,265 @@ class SortContext {
 
   void start_sort(const Column* col, bool desc) {
     descending = desc;
+    if (n > 1) {
+      if (_sort_monotonic(col, desc)) return;
+      if (n > config::sort_insert_method_threshold && _sort_runs(col, desc)) {
+        return;
+      }
+    }
     if (desc) {
       _prepare_data_for_column<false>(col);
     } else {
       _prepare_data_for_column<true>(col);
     }
+    // The groups of tied string prefixes are needed to complete the sort,
+    // even if the caller does not need the groups.
+    if (strpacked && !groups) {
+      groups.resize(n + 1);
+      groups[0] = 0;
+      gg.init(groups.data() + 1, 0);
+    }
+    _sort_prepared();
+    if (strpacked) _sort_string_ties();
+  }
+
+
+  /**
+   * If the column is already sorted in either direction (as determined by
+   * its `Stat::Sorted` statistic), then the ordering is found in a single
+   * pass over the data: the rows are split into groups of equal values, and
+   * the groups are emitted in the requested order -- as they are, or
+   * reversed, with the NA group always first. The rows within each group
+   * keep their original order, so the result is the same as that of the
+   * radix sort. Returns false if the column is not sorted.
+   */
+  bool _sort_monotonic(const Column* col, bool desc) {
+    uint8_t flags = col->get_stats()->sortedness(col);
+    if (!flags) return false;
+    // `fwd` means that the non-NA values are already in the requested order;
+    // the NAs are then at the start of the column if it is non-decreasing,
+    // and at the end if it is non-increasing.
+    bool fwd = (flags & (desc? SORTED_NONINCR : SORTED_NONDECR)) != 0;
+    bool na_first = (fwd != desc);
+    if (fwd && na_first && !groups) {
+      _fill_identity_order();
+      return true;
+    }
+    SortKey key(col, false);
+    dt::array<V> starts = _find_groups(key);
+    size_t ng = starts.size() - 1;
+    const V* st = starts.data();
+    size_t g_na = na_first? 0 : ng - 1;
+    bool has_na = (key.key(_row(static_cast<size_t>(st[g_na]))) == 0);
+    if (fwd && (na_first || !has_na)) {
+      _fill_identity_order();
+      for (size_t g = 0; groups && g < ng; ++g) {
+        gg.push(static_cast<size_t>(st[g + 1] - st[g]));
+      }
+      return true;
+    }
+    allocate_oo();
+    size_t pos = 0;
+    auto emit = [&](size_t g) {
+      size_t i0 = static_cast<size_t>(st[g]);
+      size_t i1 = static_cast<size_t>(st[g + 1]);
+      for (size_t i = i0; i < i1; ++i) {
+        next_o[pos++] = static_cast<V>(_row(i));
+      }
+      if (groups) gg.push(i1 - i0);
+    };
+    if (has_na) emit(g_na);
+    size_t g0 = (has_na && na_first)? 1 : 0;
+    size_t g1 = (has_na && !na_first)? ng - 1 : ng;
+    if (fwd) {
+      for (size_t g = g0; g < g1; ++g) emit(g);
+    } else {
+      for (size_t g = g1; g > g0; --g) emit(g - 1);
+    }
+    xassert(pos == n);
+    std::memcpy(o, next_o, n * sizeof(V));
+    use_order = true;
+    return true;
+  }
+
+
+  /**
+   * Nearly sorted data, consisting of a few sorted runs (for example a
+   * sorted frame to which several more sorted chunks were appended), is
+   * sorted by merging these runs instead of the radix sort. The runs are
+   * merged pairwise with a stable merge, so that the result is the same as
+   * that of the radix sort. Returns false if there are too many runs; this
+   * is detected early, after looking at `O(MAX_RUNS)` rows of random data.
+   *
+   * This is used for real and string columns only: the radix sort of
+   * boolean/integer columns, whose keys are narrowed to the range of their
+   * values, is faster than merging even just a couple of runs.
+   */
+  bool _sort_runs(const Column* col, bool desc) {
+    constexpr size_t MAX_RUNS = 8;
+    LType lt = col->ltype();
+    if (lt != LType::REAL && lt != LType::STRING) return false;
+    struct keyed_row { uint64_t key; V row; };
+    SortKey key(col, desc);
+    auto less = [&](const keyed_row& a, const keyed_row& b) {
+      return key.compare(static_cast<size_t>(a.row), a.key,
+                         static_cast<size_t>(b.row), b.key) < 0;
+    };
+    // Find the boundaries of the runs, filling the keys as we go
+    std::vector<keyed_row> arr1(n);
+    keyed_row* src = arr1.data();
+    std::vector<size_t> bounds = {0};
+    src[0] = {key.key(_row(0)), static_cast<V>(_row(0))};
+    for (size_t i = 1; i < n; ++i) {
+      size_t j = _row(i);
+      src[i] = {key.key(j), static_cast<V>(j)};
+      if (less(src[i], src[i - 1])) {
+        if (bounds.size() == MAX_RUNS) return false;
+        bounds.push_back(i);
+      }
+    }
+    bounds.push_back(n);
+
+    std::vector<keyed_row> arr2(n);
+    keyed_row* dst = arr2.data();
+    while (bounds.size() > 2) {
+      size_t npairs = (bounds.size() - 1) / 2;
+      #pragma omp parallel for schedule(dynamic) num_threads(nth)
+      for (size_t p = 0; p < npairs; ++p) {
+        size_t i0 = bounds[2*p], i1 = bounds[2*p + 1], i2 = bounds[2*p + 2];
+        std::merge(src + i0, src + i1, src + i1, src + i2, dst + i0, less);
+      }
+      if ((bounds.size() - 1) % 2) {
+        size_t i0 = bounds[bounds.size() - 2];
+        std::copy(src + i0, src + n, dst + i0);
+      }
+      std::vector<size_t> newbounds;
+      for (size_t b = 0; b < bounds.size(); b += 2) {
+        newbounds.push_back(bounds[b]);
+      }
+      if (newbounds.back() != n) newbounds.push_back(n);
+      bounds.swap(newbounds);
+      std::swap(src, dst);
+    }
+
+    if (groups) {
+      size_t grpstart = 0;
+      for (size_t i = 1; i < n; ++i) {
+        if (less(src[i - 1], src[i])) {
+          gg.push(i - grpstart);
+          grpstart = i;
+        }
+      }
+      gg.push(n - grpstart);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      o[i] = src[i].row;
+    }
+    use_order = true;
+    return true;
+  }
+
+
+  // Index in the column's data of the i-th row being sorted
+  size_t _row(size_t i) const {
+    return use_order? static_cast<size_t>(o[i]) : i;
+  }
+
+  void _fill_identity_order() {
+    if (!use_order) {
+      #pragma omp parallel for schedule(static) num_threads(nth)
+      for (size_t i = 0; i < n; ++i) {
+        o[i] = static_cast<V>(i);
+      }
+      use_order = true;
+    }
+  }
+
+  /**
+   * Split the rows (in their current order) into groups of equal values,
+   * and return the array of the groups' starting offsets, followed by `n`.
+   * Each thread finds the group starts within its own chunk of rows.
+   */
+  dt::array<V> _find_groups(const SortKey& key) {
+    size_t nch = std::min(nth * 4, std::max(size_t(1), n / 4096));
+    size_t chsize = (n - 1) / nch + 1;
+    std::vector<std::vector<V>> chstarts(nch);
+    #pragma omp parallel for schedule(dynamic) num_threads(nth)
+    for (size_t c = 0; c < nch; ++c) {
+      size_t i0 = c * chsize;
+      size_t i1 = std::min(n, i0 + chsize);
+      if (i0 >= i1) continue;
+      std::vector<V>& out = chstarts[c];
+      size_t jprev = _row(i0 ? i0 - 1 : 0);
+      uint64_t kprev = key.key(jprev);
+      if (i0 == 0) out.push_back(0);
+      for (size_t i = i0 ? i0 : 1; i < i1; ++i) {
+        size_t j = _row(i);
+        uint64_t k = key.key(j);
+        if (key.compare(jprev, kprev, j, k)) out.push_back(static_cast<V>(i));
+        jprev = j;
+        kprev = k;
+      }
+    }
+    size_t total = 1;
+    for (auto& v : chstarts) total += v.size();
+    dt::array<V> res(total);
+    V* resdata = res.data();
+    for (auto& v : chstarts) {
+      std::copy(v.begin(), v.end(), resdata);
+      resdata += v.size();
+    }
+    *resdata = static_cast<V>(n);
+    return res;
+  }
+
+
+  /**
+   * Sort by several boolean/integer columns at once. The prepared keys of
+   * all columns (see `packed_nbits()`) are combined into a single key `x`,
+   * with the first column in the most significant bits, so that sorting by
+   * this compound key is equivalent to sorting by each column in turn.
+   */
+  void start_sort_packed(const std::vector<const Column*>& cols,
+                         const std::vector<bool>& descs) {
+    xassert(cols.size() == descs.size());
+    strtype = 0;
+    strdata = nullptr;
+    descending = false;
+    int totalbits = 0;
+    for (const Column* col : cols) {
+      totalbits += packed_nbits(col);
+    }
+    xassert(totalbits > 0 && totalbits <= 64);
+    nsigbits = static_cast<uint8_t>(totalbits);
+    if (nsigbits > 32)      _pack_keys<uint64_t>(cols, descs);
+    else if (nsigbits > 16) _pack_keys<uint32_t>(cols, descs);
+    else if (nsigbits > 8)  _pack_keys<uint16_t>(cols, descs);
+    else                    _pack_keys<uint8_t >(cols, descs);
+    _sort_prepared();
+  }
+
+
+  /**
+   * Number of bits taken by the prepared keys of column `col` when it is
+   * packed together with other columns, or 0 if the column cannot be packed.
+   * Only boolean and integer columns are packable; for the latter the number
+   * of bits is derived from the column's min/max stats, same as in `_initI`.
+   */
+  static int packed_nbits(const Column* col) {
+    switch (col->stype()) {
+      case SType::BOOL:  return 2;
+      case SType::INT8:  return _int_nbits<int8_t,  uint8_t>(col);
+      case SType::INT16: return _int_nbits<int16_t, uint16_t>(col);
+      case SType::INT32: return _int_nbits<int32_t, uint32_t>(col);
+      case SType::INT64: return _int_nbits<int64_t, uint64_t>(col);
+      default:           return 0;
+    }
+  }
+
+
+  // Sort the data prepared in `x` (first column)
+  void _sort_prepared() {
     if (n <= config::sort_insert_method_threshold) {
       if (use_order) {
         kinsert_sort();
@@ -443,39 +839,131 @@ class SortContext {
     // to be expanded.
     next_elemsize = elemsize;
     allocate_xx();
+    // The first column may have been ordered without the radix sort, which
+    // would otherwise have allocated `next_o`.
+    if (!next_o) allocate_oo();
 
     dt::array<radix_range> rrmap(nradixes);
     radix_range* rrmap_ptr = rrmap.data();
     _fill_rrmap_from_groups(rrmap_ptr);
 
-    if (make_groups) {
+    if (make_groups || strpacked) {
       gg.init(groups.data() + 1, 0);
       _radix_recurse<true>(rrmap_ptr);
     } else {
       _radix_recurse<false>(rrmap_ptr);
     }
+    if (strpacked) _sort_string_ties();
+  }
+
+
+  /**
+   * Find the rows that may be among the first `k` rows once the data is
+   * sorted by column `col`. These are the rows whose key in `x` does not
+   * exceed the k-th smallest key (for strings the key is only the first
+   * character, so there may be many such rows). Each thread collects the `k`
+   * smallest keys within its part of the data into a bounded max-heap, and
+   * these are then merged to find the k-th smallest key overall.
+   *
+   * The indices of the candidate rows are returned in ascending order.
+   */
+  dt::array<V> topk_candidates(const Column* col, bool desc, size_t k) {
+    xassert(k > 0 && k < n);
+    descending = desc;
+    if (desc) {
+      _prepare_data_for_column<false>(col);
+    } else {
+      _prepare_data_for_column<true>(col);
+    }
+    switch (elemsize) {
+      case 1:  return _topk_candidates<uint8_t>(k);
+      case 2:  return _topk_candidates<uint16_t>(k);
+      case 4:  return _topk_candidates<uint32_t>(k);
+      default: return _topk_candidates<uint64_t>(k);
+    }
+  }
+
+  template <typename T>
+  dt::array<V> _topk_candidates(size_t k) {
+    const T* tx = x.data<T>();
+    std::vector<std::vector<T>> heaps(nth);
+    #pragma omp parallel num_threads(nth)
+    {
+      size_t ith = static_cast<size_t>(omp_get_thread_num());
+      std::vector<T>& heap = heaps[ith];
+      heap.reserve(k);
+      #pragma omp for schedule(static)
+      for (size_t j = 0; j < n; ++j) {
+        T v = tx[j];
+        if (heap.size() < k) {
+          heap.push_back(v);
+          std::push_heap(heap.begin(), heap.end());
+        } else if (v < heap.front()) {
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = v;
+          std::push_heap(heap.begin(), heap.end());
+        }
+      }
+    }
+    std::vector<T> keys;
+    for (auto& heap : heaps) {
+      keys.insert(keys.end(), heap.begin(), heap.end());
+    }
+    xassert(keys.size() >= k);
+    std::nth_element(keys.begin(), keys.begin() + static_cast<long>(k - 1),
+                     keys.end());
+    T threshold = keys[k - 1];
+
+    // Collect the candidate rows: first count them within each chunk, then
+    // write their indices at the cumulative offsets.
+    size_t nchunks_ = std::max(size_t(1), std::min(nth * 4, n / 1024));
+    size_t chunksize = (n - 1) / nchunks_ + 1;
+    std::vector<size_t> counts(nchunks_ + 1, 0);
+    #pragma omp parallel for schedule(static) num_threads(nth)
+    for (size_t i = 0; i < nchunks_; ++i) {
+      size_t j1 = std::min(n, (i + 1) * chunksize);
+      size_t cnt = 0;
+      for (size_t j = i * chunksize; j < j1; ++j) {
+        cnt += (tx[j] <= threshold);
+      }
+      counts[i + 1] = cnt;
+    }
+    for (size_t i = 0; i < nchunks_; ++i) {
+      counts[i + 1] += counts[i];
+    }
+    dt::array<V> res(counts[nchunks_]);
+    V* resdata = res.data();
+    #pragma omp parallel for schedule(static) num_threads(nth)
+    for (size_t i = 0; i < nchunks_; ++i) {
+      size_t j1 = std::min(n, (i + 1) * chunksize);
+      size_t off = counts[i];
+      for (size_t j = i * chunksize; j < j1; ++j) {
+        if (tx[j] <= threshold) resdata[off++] = static_cast<V>(j);
+      }
+    }
+    return res;
   }
 
 
   RowIndex get_result_rowindex() {
-    auto data = static_cast<int32_t*>(container_o.release());
-    return RowIndex(arr32_t(n, data, true));
+    auto data = static_cast<V*>(container_o.release());
+    return RowIndex(dt::array<V>(n, data, true));
   }
 
   Groupby extract_groups() {
     size_t ng = gg.size();
     xassert(groups.size() > ng);
     groups.resize(ng + 1);
-    return Groupby(ng, groups.to_memoryrange());
+    return Groupby(ng, groups.to_memoryrange(), sizeof(V) == 8);
   }
 
   Groupby copy_groups() {
     size_t ng = gg.size();
     xassert(groups.size() > ng);
-    size_t memsize = (ng + 1) * sizeof(int32_t);
+    size_t memsize = (ng + 1) * sizeof(V);
     MemoryRange mr = MemoryRange::mem(memsize);
     std::memcpy(mr.xptr(), groups.data(), memsize);
-    return Groupby(ng, std::move(mr));
+    return Groupby(ng, std::move(mr), sizeof(V) == 8);
   }
 
   std::pair<RowIndex, Groupby> get_result_groups() {
@@ -483,7 +971,8 @@ class SortContext {
     xassert(groups.size() > ng);
     groups.resize(ng + 1);
     return std::pair<RowIndex, Groupby>(get_result_rowindex(),
-                                        Groupby(ng, groups.to_memoryrange()));
+                                        Groupby(ng, groups.to_memoryrange(),
+                                                sizeof(V) == 8));
   }
 
 
@@ -503,13 +992,14 @@ class SortContext {
   }
 
   void allocate_oo() {
-    container_oo.ensure_size(n * 4);
-    next_o = static_cast<int*>(container_oo.ptr);
+    container_oo.ensure_size(n * sizeof(V));
+    next_o = static_cast<V*>(container_oo.ptr);
   }
 
   template <bool ASC>
   void _prepare_data_for_column(const Column* col) {
     strtype = 0;
+    strpacked = 0;
     strdata = nullptr;
     // These will initialize `x`, `elemsize` and `nsigbits`, and also
     // `strdata`, `stroffs`, `strstart` for string columns
@@ -522,8 +1012,14 @@ class SortContext {
       case SType::INT64:   _initI<ASC, int64_t, uint64_t>(col); break;
       case SType::FLOAT32: _initF<ASC, uint32_t>(col); break;
       case SType::FLOAT64: _initF<ASC, uint64_t>(col); break;
-      case SType::STR32:   _initS<ASC, uint32_t>(col); break;
-      case SType::STR64:   _initS<ASC, uint64_t>(col); break;
+      case SType::STR32:
+        if (config::sort_packed_strings) _initS_packed<ASC, uint32_t>(col);
+        else                             _initS<ASC, uint32_t>(col);
+        break;
+      case SType::STR64:
+        if (config::sort_packed_strings) _initS_packed<ASC, uint64_t>(col);
+        else                             _initS<ASC, uint64_t>(col);
+        break;
       default:
         throw NotImplError() << "Unable to sort Column of stype " << stype;
     }
@@ -616,6 +1112,75 @@ class SortContext {
   }
 
 
+  template <typename T, typename TU>
+  static int _int_nbits(const Column* col) {
+    auto icol = static_cast<const IntColumn<T>*>(col);
+    T min = icol->min();
+    T max = icol->max();
+    return static_cast<int>(sizeof(T) * 8) -
+           dt::nlz(static_cast<TU>(max - min + 1));
+  }
+
+  template <typename TO>
+  void _pack_keys(const std::vector<const Column*>& cols,
+                  const std::vector<bool>& descs) {
+    elemsize = sizeof(TO);
+    allocate_x();
+    TO* xo = x.data<TO>();
+    std::memset(xo, 0, n * sizeof(TO));
+    int shift = nsigbits;
+    for (size_t i = 0; i < cols.size(); ++i) {
+      const Column* col = cols[i];
+      shift -= packed_nbits(col);
+      bool asc = !descs[i];
+      switch (col->stype()) {
+        case SType::BOOL:
+          if (asc) _pack_bool<true, TO>(col, shift);
+          else     _pack_bool<false, TO>(col, shift);
+          break;
+        case SType::INT8:  _pack_int<int8_t,  uint8_t,  TO>(col, asc, shift); break;
+        case SType::INT16: _pack_int<int16_t, uint16_t, TO>(col, asc, shift); break;
+        case SType::INT32: _pack_int<int32_t, uint32_t, TO>(col, asc, shift); break;
+        case SType::INT64: _pack_int<int64_t, uint64_t, TO>(col, asc, shift); break;
+        default: xassert(false);
+      }
+    }
+    xassert(shift == 0);
+  }
+
+  // Same transform as in `_initB`
+  template <bool ASC, typename TO>
+  void _pack_bool(const Column* col, int shift) {
+    const uint8_t* xi = static_cast<const uint8_t*>(col->data());
+    TO* xo = x.data<TO>();
+    #pragma omp parallel for schedule(static) num_threads(nth)
+    for (size_t j = 0; j < n; j++) {
+      uint8_t t = xi[use_order? static_cast<size_t>(o[j]) : j];
+      TO k = ASC? static_cast<uint8_t>(t + 191) >> 6
+                : static_cast<uint8_t>(128 - t) >> 6;
+      xo[j] |= static_cast<TO>(k << shift);
+    }
+  }
+
+  // Same transform as in `_initI_impl`
+  template <typename T, typename TU, typename TO>
+  void _pack_int(const Column* col, bool asc, int shift) {
+    auto icol = static_cast<const IntColumn<T>*>(col);
+    TU una = static_cast<TU>(GETNA<T>());
+    TU uedge = static_cast<TU>(asc? icol->min() : icol->max());
+    const TU* xi = static_cast<const TU*>(col->data());
+    TO* xo = x.data<TO>();
+    #pragma omp parallel for schedule(static) num_threads(nth)
+    for (size_t j = 0; j < n; j++) {
+      TU t = xi[use_order? static_cast<size_t>(o[j]) : j];
+      TO k = t == una? 0 :
+             asc? static_cast<TO>(static_cast<TU>(t - uedge + 1))
+                : static_cast<TO>(static_cast<TU>(uedge - t + 1));
+      xo[j] |= static_cast<TO>(k << shift);
+    }
+  }
+
+
   /**
    * For float32/64 we need to carefully manipulate the bits in order to present
    * them in the correct order as uint32/64. At bit level, the structure of
@@ -708,7 +1273,7 @@ class SortContext {
     #pragma omp parallel for schedule(static) num_threads(nth) \
             reduction(max:maxlen)
     for (size_t j = 0; j < n; ++j) {
-      int32_t k = use_order? o[j] : static_cast<int32_t>(j);
+      V k = use_order? o[j] : static_cast<V>(j);
       T offend = offs[k];
       if (ISNA<T>(offend)) {
         xo[j] = 0;    // NA string
@@ -728,6 +1293,104 @@ class SortContext {
   }
 
 
+  /**
+   * Alternative preparation of string columns, where the key of each string
+   * in `x` is its prefix packed into a 64-bit integer (see `_str_key()`), so
+   * that each radix pass consumes 7 characters instead of 1. If all strings
+   * are shorter than that, the prefixes are only as long as the longest
+   * string. The keys are then shifted by their minimum and narrowed to the
+   * fewest bytes needed, which discards the prefix common to all strings.
+   * For the strings that are longer than 7 characters the sort is completed
+   * by `_sort_string_ties()`.
+   */
+  template <bool ASC, typename T>
+  void _initS_packed(const Column* col) {
+    auto scol = static_cast<const StringColumn<T>*>(col);
+    strdata = reinterpret_cast<const uint8_t*>(scol->strdata());
+    const T* offs = scol->offsets();
+    stroffs = static_cast<const void*>(offs);
+    elemsize = 8;
+    next_elemsize = 8;
+    allocate_x();
+    allocate_xx();
+    uint64_t* keys = xx.data<uint64_t>();
+
+    T maxlen = 0;
+    #pragma omp parallel for schedule(static) num_threads(nth) \
+            reduction(max:maxlen)
+    for (size_t j = 0; j < n; ++j) {
+      size_t row = _row(j);
+      T end = offs[row];
+      T len = ISNA<T>(end)? 0 : end - (offs[row - 1] & ~GETNA<T>());
+      if (len > maxlen) maxlen = len;
+    }
+    size_t width = std::min(static_cast<size_t>(maxlen), size_t(7));
+
+    uint64_t kmin = UINT64_MAX, kmax = 0;
+    #pragma omp parallel for schedule(static) num_threads(nth) \
+            reduction(min:kmin) reduction(max:kmax)
+    for (size_t j = 0; j < n; ++j) {
+      uint64_t k = _str_key<ASC>(offs, _row(j), 0, width);
+      keys[j] = k;
+      if (k < kmin) kmin = k;
+      if (k > kmax) kmax = k;
+    }
+    _narrow_keys(keys, n, kmin, kmax);
+    strpacked = maxlen > 7? sizeof(T) / 4 : 0;
+  }
+
+  /**
+   * Key of the string in `row` for sorting by its characters starting from
+   * `depth`: the next `width` (at most 7) characters are packed big-endian
+   * into the upper bytes of the key, followed by the byte `1 + min(len,
+   * width + 1)`, where `len` is the number of the remaining characters.
+   * Thus this last byte is `width + 2` if and only if the string continues
+   * past these characters. NA strings have key 0.
+   */
+  template <bool ASC, typename T>
+  uint64_t _str_key(const T* offs, size_t row, size_t depth,
+                    size_t width = 7) const {
+    T end = offs[row];
+    if (ISNA<T>(end)) return 0;
+    T start = (offs[row - 1] & ~GETNA<T>()) + static_cast<T>(depth);
+    size_t len = end > start? static_cast<size_t>(end - start) : 0;
+    size_t m = std::min(len, width);
+    uint64_t k = 0;
+    for (size_t i = 0; i < m; ++i) {
+      k = (k << 8) | strdata[start + i];
+    }
+    k <<= 8 * (width - m);
+    k = (k << 8) | (std::min(len, width + 1) + 1);
+    return ASC? k : 0 - k;
+  }
+
+  /**
+   * Store the 64-bit keys `keys[0..m)`, shifted by their minimum `kmin`,
+   * into `x` using the narrowest element type that fits `kmax - kmin`, and
+   * set `elemsize` and `nsigbits` accordingly.
+   */
+  void _narrow_keys(const uint64_t* keys, size_t m, uint64_t kmin,
+                    uint64_t kmax) {
+    if (m == 0) kmin = kmax = 0;
+    nsigbits = static_cast<uint8_t>(64 - dt::nlz(kmax - kmin));
+    if (nsigbits == 0) nsigbits = 1;
+    if (nsigbits > 32)      _narrow_keys_impl<uint64_t>(keys, m, kmin);
+    else if (nsigbits > 16) _narrow_keys_impl<uint32_t>(keys, m, kmin);
+    else if (nsigbits > 8)  _narrow_keys_impl<uint16_t>(keys, m, kmin);
+    else                    _narrow_keys_impl<uint8_t >(keys, m, kmin);
+  }
+
+  template <typename TO>
+  void _narrow_keys_impl(const uint64_t* keys, size_t m, uint64_t kmin) {
+    elemsize = sizeof(TO);
+    TO* xo = x.data<TO>();
+    #pragma omp parallel for schedule(static) num_threads(nth)
+    for (size_t j = 0; j < m; ++j) {
+      xo[j] = static_cast<TO>(keys[j] - kmin);
+    }
+  }
+
+
   //============================================================================
   // Radix sorting parameters
   //============================================================================
@@ -900,7 +1563,7 @@ class SortContext {
       for (size_t j = j0; j < j1; ++j) {
         size_t k = tcounts[xi[j] >> shift]++;
         xassert(k < n);
-        next_o[k] = use_order? o[j] : static_cast<int32_t>(j);
+        next_o[k] = use_order? o[j] : static_cast<V>(j);
         if (OUT) {
           xo[k] = static_cast<TO>(xi[j] & mask);
         }
@@ -926,7 +1589,7 @@ class SortContext {
       for (size_t j = j0; j < j1; ++j) {
         size_t k = tcounts[xi[j]]++;
         xassert(k < n);
-        int32_t w = use_order? o[j] : static_cast<int32_t>(j);
+        V w = use_order? o[j] : static_cast<V>(j);
         T offend = soffs[w];
         T offstart = (soffs[w - 1] & ~GETNA<T>()) + sstart;
         if (ISNA<T>(offend)) {
@@ -959,7 +1622,7 @@ class SortContext {
    */
   template <bool make_groups>
   void radix_psort() {
-    int32_t* ores = o;
+    V* ores = o;
     determine_sorting_parameters();
     build_histogram();
     reorder_data();
@@ -982,7 +1645,7 @@ class SortContext {
 
     // Done. Save to array `o` the computed ordering of the input vector `x`.
     if (ores && o != ores) {
-      std::memcpy(ores, o, n * sizeof(int32_t));
+      std::memcpy(ores, o, n * sizeof(V));
       next_o = o;
       o = ores;
     }
@@ -1034,13 +1697,13 @@ class SortContext {
     size_t   _n        = n;
     rmem     _x        { x };
     rmem     _xx       { xx };
-    int32_t* _o        = o;
-    int32_t* _next_o   = next_o;
+    V*       _o        = o;
+    V*       _next_o   = next_o;
     uint8_t  _elemsize = elemsize;
     size_t   _nradixes = nradixes;
     size_t   _strstart = strstart;
-    int32_t  ggoff0    = make_groups? gg.cumulative_size() : 0;
-    int32_t* ggdata0   = make_groups? gg.data() : nullptr;
+    V        ggoff0    = make_groups? gg.cumulative_size() : 0;
+    V*       ggdata0   = make_groups? gg.data() : nullptr;
 
     // At this point the distribution of radix range sizes may or may not
     // be uniform. If the distribution is uniform (i.e. roughly same number
@@ -1079,7 +1742,7 @@ class SortContext {
         o = _o + off;
         next_o = _next_o + off;
         if (make_groups) {
-          gg.init(ggdata0 + off, ggoff0 + static_cast<int32_t>(off));
+          gg.init(ggdata0 + off, ggoff0 + static_cast<V>(off));
           radix_psort<true>();
           rrmap[rri].size = gg.size() | GROUPED;
         } else {
@@ -1105,23 +1768,23 @@ class SortContext {
     // sort each of them independently using a simpler insertion sort
     // method.
     size_t nthreads = std::min(nth, nsmallgroups);
-    int32_t* tmp = nullptr;
+    V* tmp = nullptr;
     bool own_tmp = false;
     if (size0) {
-      // size_t size_all = size0 * nthreads * sizeof(int32_t);
+      // size_t size_all = size0 * nthreads * sizeof(V);
       // if ((size_t)_next_elemsize * _n <= size_all) {
-      //   tmp = (int32_t*)_x;
+      //   tmp = (V*)_x;
       // } else {
       own_tmp = true;
-      tmp = new int32_t[size0 * nthreads];
+      tmp = new V[size0 * nthreads];
       TRACK(tmp, sizeof(tmp), "sort.tmp");
       // }
     }
     #pragma omp parallel num_threads(nthreads)
     {
       int tnum = omp_get_thread_num();
-      int32_t* oo = tmp + tnum * static_cast<int32_t>(size0);
-      GroupGatherer tgg;
+      V* oo = tmp + static_cast<size_t>(tnum) * size0;
+      GroupGatherer<V> tgg;
 
       #pragma omp for schedule(dynamic)
       for (size_t i = 0; i < _nradixes; ++i) {
@@ -1132,9 +1795,9 @@ class SortContext {
         } else if (zn > 1) {
           int32_t  tn = static_cast<int32_t>(zn);
           rmem     tx { _x, off * elemsize, zn * elemsize };
-          int32_t* to = _o + off;
+          V*       to = _o + off;
           if (make_groups) {
-            tgg.init(ggdata0 + off, static_cast<int32_t>(off) + ggoff0);
+            tgg.init(ggdata0 + off, static_cast<V>(off) + ggoff0);
           }
           if (strtype == 0) {
             switch (elemsize) {
@@ -1156,7 +1819,7 @@ class SortContext {
             rrmap[i].size = static_cast<size_t>(tgg.size());
           }
         } else if (zn == 1 && make_groups) {
-          ggdata0[off] = static_cast<int32_t>(off) + ggoff0 + 1;
+          ggdata0[off] = static_cast<V>(off) + ggoff0 + 1;
           rrmap[i].size = 1;
         }
       }
@@ -1175,13 +1838,153 @@ class SortContext {
 
 
 
+  //============================================================================
+  // Ties of packed string prefixes
+  //============================================================================
+
+  /**
+   * Complete the sort of a string column by its packed prefixes (see
+   * `_initS_packed()`). At this point `groups` contain the groups of rows
+   * whose strings are equal in their first `depth` characters. The groups
+   * whose strings continue past `depth` are sorted by the next 7 characters,
+   * and split into subgroups; the other groups are already final. This is
+   * repeated until no such groups remain.
+   *
+   * Same as in `_radix_recurse()`, the large groups are radix-sorted one at
+   * a time (each using all threads), while the small groups are sorted in
+   * parallel with the insertion sort. Since the insertion sort here compares
+   * contiguous 64-bit keys rather than strings, it remains faster than the
+   * radix sort for larger groups than `sort.insert_method_threshold`.
+   */
+  void _sort_string_ties() {
+    if (strpacked == 1) _sort_string_ties_impl<uint32_t>();
+    else                _sort_string_ties_impl<uint64_t>();
+  }
+
+  template <typename T>
+  void _sort_string_ties_impl() {
+    const T* offs = static_cast<const T*>(stroffs);
+    size_t   _n        = n;
+    rmem     _x        { x };
+    rmem     _xx       { xx };
+    V*       _o        = o;
+    V*       _next_o   = next_o;
+    uint8_t  _elemsize = elemsize;
+    uint8_t  _nsigbits = nsigbits;
+    V*       ggdata0   = groups.data() + 1;
+    size_t   rrlarge   = 4 * config::sort_insert_method_threshold;
+    constexpr size_t GROUPED = size_t(1) << 63;
+    xassert(o == container_o.ptr);
+    container_x.ensure_size(n * 8);
+    container_xx.ensure_size(n * 8);
+    if (!next_o) allocate_oo();
+    rmem xall(container_x);
+    rmem xxall(container_xx);
+    _next_o = next_o;
+
+    for (size_t depth = 7; ; depth += 7) {
+      size_t ng = gg.size();
+      dt::array<radix_range> rrmap(ng);
+      radix_range* rr = rrmap.data();
+      _fill_rrmap_from_groups(rr);
+      // Find the groups that remain tied, marking the sizes of all other
+      // groups as 1 (since they will not be split). The groups are stored
+      // at their offsets, and consolidated back by `from_chunks()`.
+      size_t ntied = 0;
+      size_t size0 = 0;
+      for (size_t i = 0; i < ng; ++i) {
+        size_t sz = rr[i].size;
+        T end = offs[_o[rr[i].offset]];
+        T start = offs[_o[rr[i].offset] - 1] & ~GETNA<T>();
+        if (sz > 1 && !ISNA<T>(end) && end - start > depth) {
+          ntied++;
+          if (sz <= rrlarge && sz > size0) size0 = sz;
+        } else {
+          ggdata0[rr[i].offset] = static_cast<V>(rr[i].offset + sz);
+          rr[i].size = 1;
+        }
+      }
+      for (size_t i = 0; i < ng; ++i) {
+        size_t sz = rr[i].size;
+        if (sz <= rrlarge) continue;
+        size_t off = rr[i].offset;
+        uint64_t* keys = xxall.data<uint64_t>() + off;
+        uint64_t kmin = UINT64_MAX, kmax = 0;
+        #pragma omp parallel for schedule(static) num_threads(nth) \
+                reduction(min:kmin) reduction(max:kmax)
+        for (size_t j = 0; j < sz; ++j) {
+          uint64_t k = descending? _str_key<false>(offs, _o[off + j], depth)
+                                 : _str_key<true>(offs, _o[off + j], depth);
+          keys[j] = k;
+          if (k < kmin) kmin = k;
+          if (k > kmax) kmax = k;
+        }
+        if (kmin == kmax) {
+          ggdata0[off] = static_cast<V>(off + sz);
+          rr[i].size = 1;
+          continue;
+        }
+        x = rmem(xall, off * 8, sz * 8);
+        _narrow_keys(keys, sz, kmin, kmax);
+        n = sz;
+        xx = rmem(xxall, off * 8, sz * 8);
+        o = _o + off;
+        next_o = _next_o + off;
+        gg.init(ggdata0 + off, static_cast<V>(off));
+        radix_psort<true>();
+        rr[i].size = gg.size() | GROUPED;
+      }
+      n = _n;
+      o = _o;
+      next_o = _next_o;
+
+      size_t nthreads = std::max(size_t(1), std::min(nth, ntied));
+      dt::array<V> tmparr(size0 * nthreads);
+      #pragma omp parallel num_threads(nthreads)
+      {
+        size_t ith = static_cast<size_t>(omp_get_thread_num());
+        V* tmp = tmparr.data() + ith * size0;
+        GroupGatherer<V> tgg;
+
+        #pragma omp for schedule(dynamic)
+        for (size_t i = 0; i < ng; ++i) {
+          size_t sz = rr[i].size;
+          if (sz & GROUPED) {
+            rr[i].size = sz & ~GROUPED;
+            continue;
+          }
+          if (sz <= 1) continue;
+          size_t off = rr[i].offset;
+          uint64_t* keys = xall.data<uint64_t>() + off;
+          for (size_t j = 0; j < sz; ++j) {
+            keys[j] = descending? _str_key<false>(offs, _o[off + j], depth)
+                                : _str_key<true>(offs, _o[off + j], depth);
+          }
+          tgg.init(ggdata0 + off, static_cast<V>(off));
+          insert_sort_keys(keys, _o + off, tmp, static_cast<int>(sz), tgg);
+          rr[i].size = tgg.size();
+        }
+      }
+      gg.init(ggdata0, 0);
+      gg.from_chunks(rr, ng);
+      if (!ntied) break;
+    }
+
+    x = _x;
+    xx = _xx;
+    elemsize = _elemsize;
+    nsigbits = _nsigbits;
+  }
+
+
+
   //============================================================================
   // Insert sort
   //============================================================================
 
   void kinsert_sort() {
-    arr32_t tmparr(n);
-    int32_t* tmp = tmparr.data();
+    dt::array<V> tmparr(n);
+    V* tmp = tmparr.data();
     int32_t nn = static_cast<int32_t>(n);
     if (strtype == 0) {
       switch (elemsize) {
@@ -1218,7 +2021,7 @@ class SortContext {
     }
   }
 
-  template <typename T> void _insert_sort_keys(int32_t* tmp) {
+  template <typename T> void _insert_sort_keys(V* tmp) {
     T* xt = x.data<T>();
     int32_t nn = static_cast<int32_t>(n);
     insert_sort_keys(xt, o, tmp, nn, gg);
@@ -1240,11 +2043,347 @@ class SortContext {
 using RiGb = std::pair<RowIndex, Groupby>;
 
 
+/**
+ * Return true if sorting `nrows` rows (possibly through the `rowindex`)
+ * requires 64-bit row indices and group offsets. Otherwise, the more compact
+ * 32-bit indices are used.
+ */
+static bool _use_int64(size_t nrows, const RowIndex& rowindex) {
+  size_t limit = config::sort_max_int32_rows;
+  return nrows > limit || (rowindex && rowindex.max() > limit);
+}
+
+
+template <typename V>
+static void _group_impl(const DataTable* dt,
+                        const std::vector<sort_spec>& spec, RiGb& result)
+{
+  size_t n = spec.size();
+  const Column* col0 = dt->columns[spec[0].col_index];
+  // Leading boolean/integer columns whose prepared keys together fit into a
+  // single radix (`sort.max_radix_bits`) are sorted in one pass by their
+  // packed compound key, instead of recursing into the groups of each column.
+  // Wider compound keys are not packed: the MSD radix sort would then have
+  // to sort a large number of small ranges, which is slower than sorting
+  // column by column. The packed columns must be either all group columns,
+  // or all sort-only.
+  // If the first column is already sorted, it is cheaper to order it first
+  // and then sort the remaining columns within its groups.
+  std::vector<const Column*> packcols;
+  std::vector<bool> packdescs;
+  int packbits = 0;
+  bool sorted0 = col0->get_stats()->sortedness(col0) != 0;
+  for (size_t j = 0; j < n && !sorted0; ++j) {
+    if (spec[j].sort_only != spec[0].sort_only) break;
+    const Column* col = dt->columns[spec[j].col_index];
+    int nbits = SortContext<V>::packed_nbits(col);
+    if (nbits == 0 || packbits + nbits > config::sort_max_radix_bits) break;
+    packbits += nbits;
+    packcols.push_back(col);
+    packdescs.push_back(spec[j].descending);
+  }
+  size_t j0 = packcols.size() >= 2? packcols.size() : 1;
+  bool do_groups = j0 < n || !spec[0].sort_only;
+  SortContext<V> sc(dt->nrows, col0->rowindex(), do_groups);
+  if (j0 > 1) {
+    sc.start_sort_packed(packcols, packdescs);
+  } else {
+    sc.start_sort(col0, spec[0].descending);
+  }
+  for (size_t j = j0; j < n; ++j) {
+    if (spec[j].sort_only && !spec[j - 1].sort_only) {
+      result.second = sc.copy_groups();
+    }
+    if (j == n - 1 && spec[j].sort_only) {
+      do_groups = false;
+    }
+    sc.continue_sort(dt->columns[spec[j].col_index],
+                     spec[j].descending, do_groups);
+  }
+  result.first = sc.get_result_rowindex();
+  if (!spec[0].sort_only && !result.second) {
+    result.second = sc.extract_groups();
+  }
+}
+
+
+//==============================================================================
+// External sort
+//==============================================================================
+
+/**
+ * Temporary file holding one sorted run of an external sort: the ordering of
+ * the rows in the run (`nrows` elements of type `V`), followed by the keys
+ * of the first sort column for these rows (`nrows` elements of `uint64_t`).
+ * The file is written through an `MmapWritableBuffer`, then memory-mapped
+ * for reading, and deleted when the object is destroyed.
+ */
+template <typename V>
+class SortRun {
+  private:
+    std::string filename;
+    MemoryRange mbuf;
+    size_t nrows;
+
+  public:
+    SortRun(const std::string& path, const dt::array<V>& order,
+            const dt::array<uint64_t>& keys)
+      : filename(path), nrows(order.size())
+    {
+      size_t sz1 = nrows * sizeof(V);
+      size_t sz2 = nrows * sizeof(uint64_t);
+      {
+        MmapWritableBuffer wb(filename, sz1 + sz2);
+        wb.write(sz1, order.data());
+        wb.write(sz2, keys.data());
+        wb.finalize();
+      }
+      mbuf = MemoryRange::mmap(filename);
+    }
+
+    SortRun(const SortRun&) = delete;
+    SortRun(SortRun&&) = delete;
+
+    ~SortRun() {
+      mbuf = MemoryRange();
+      File::remove(filename);
+    }
+
+    size_t size() const { return nrows; }
+
+    const V* order() const {
+      return static_cast<const V*>(mbuf.rptr());
+    }
+
+    const uint64_t* keys() const {
+      return static_cast<const uint64_t*>(mbuf.rptr(nrows * sizeof(V)));
+    }
+};
+
+
+/**
+ * Approximate amount of memory needed by the radix sort per row of the frame
+ * being sorted: the ordering arrays `o`, `next_o`, the groups array, and the
+ * prepared keys `x`, `next_x` (up to 8 bytes each).
+ */
+template <typename V>
+static size_t _sort_bytes_per_row() {
+  return 3 * sizeof(V) + 16;
+}
+
+/**
+ * Return true if sorting `nrows` rows in memory would exceed the memory
+ * budget set by the option `sort.memory_budget` (0 means no limit).
+ */
+template <typename V>
+static bool _use_external_sort(size_t nrows) {
+  size_t budget = config::sort_memory_budget;
+  return budget && nrows > budget / _sort_bytes_per_row<V>();
+}
+
+static std::string _external_sort_filename(size_t irun) {
+  static size_t counter = 0;
+  const char* tmpdir = std::getenv("TMPDIR");
+  std::ostringstream out;
+  out << (tmpdir && *tmpdir? tmpdir : "/tmp") << "/datatable-sort-"
+      << getpid() << "-" << (counter++) << "-" << irun << ".tmp";
+  return out.str();
+}
+
+
+/**
+ * Sort the frame when the radix sort's working memory for all rows would
+ * exceed the `sort.memory_budget`. The rows are split into runs that fit
+ * into the budget, each run is sorted with the regular radix sort, and its
+ * ordering together with the keys of the first sort column are spilled into
+ * a temporary memory-mapped file. The runs are then merged using a heap.
+ * Since the runs are in the order of rows, and ties between runs are
+ * resolved in favor of the earlier run, the sort remains stable.
+ *
+ * All sort columns must be materialized.
+ */
+template <typename V>
+static void _group_external(const DataTable* dt,
+                            const std::vector<sort_spec>& spec, RiGb& result)
+{
+  size_t n = dt->nrows;
+  size_t ncols = spec.size();
+  size_t runsize = config::sort_memory_budget / _sort_bytes_per_row<V>();
+  runsize = std::max(runsize, size_t(1024));
+  size_t nruns = (n - 1) / runsize + 1;
+
+  std::vector<SortKey> keys;
+  std::vector<sort_spec> runspec;
+  for (size_t j = 0; j < ncols; ++j) {
+    const Column* col = dt->columns[spec[j].col_index];
+    keys.emplace_back(col, spec[j].descending);
+    runspec.emplace_back(j, spec[j].descending, false, spec[j].sort_only);
+  }
+  // Number of columns that determine the groups
+  size_t ngrpcols = 0;
+  while (ngrpcols < ncols && !spec[ngrpcols].sort_only) ngrpcols++;
+  size_t nth = static_cast<size_t>(config::sort_nthreads);
+
+  // Step 1: sort each run and spill it into a file
+  std::vector<std::unique_ptr<SortRun<V>>> runs;
+  for (size_t r = 0; r < nruns; ++r) {
+    size_t row0 = r * runsize;
+    size_t len = std::min(runsize, n - row0);
+    RowIndex runri(row0, len, size_t(1));
+    colvec cols;
+    for (const sort_spec& s : spec) {
+      Column* col = dt->columns[s.col_index]->shallowcopy(runri);
+      col->reify();
+      cols.push_back(col);
+    }
+    DataTable rundt(std::move(cols));
+    RiGb runres;
+    _group_impl<V>(&rundt, runspec, runres);
+
+    dt::array<V> order(len);
+    runres.first.extract_into(order);
+    dt::array<uint64_t> runkeys(len);
+    const SortKey& key0 = keys[0];
+    #pragma omp parallel for schedule(static) num_threads(nth)
+    for (size_t i = 0; i < len; ++i) {
+      order[i] += static_cast<V>(row0);
+      runkeys[i] = key0.key(static_cast<size_t>(order[i]));
+    }
+    runs.emplace_back(
+        new SortRun<V>(_external_sort_filename(r), order, runkeys));
+  }
+
+  // Step 2: k-way merge of the runs
+  std::vector<size_t> pos(nruns, 0);
+  // Compare the rows at positions `pa` and `pb` within the runs `a` and `b`
+  // in the columns [0, upto)
+  auto cmp = [&](size_t a, size_t pa, size_t b, size_t pb, size_t upto) {
+    size_t ra = static_cast<size_t>(runs[a]->order()[pa]);
+    size_t rb = static_cast<size_t>(runs[b]->order()[pb]);
+    int c = keys[0].compare(ra, runs[a]->keys()[pa], rb, runs[b]->keys()[pb]);
+    for (size_t j = 1; j < upto && c == 0; ++j) {
+      c = keys[j].compare(ra, keys[j].key(ra), rb, keys[j].key(rb));
+    }
+    return c;
+  };
+  // std heap functions build a max-heap, so the comparator is "greater than"
+  auto heapcmp = [&](size_t a, size_t b) -> bool {
+    int c = cmp(a, pos[a], b, pos[b], ncols);
+    return c > 0 || (c == 0 && a > b);
+  };
+  std::vector<size_t> heap(nruns);
+  for (size_t r = 0; r < nruns; ++r) heap[r] = r;
+  std::make_heap(heap.begin(), heap.end(), heapcmp);
+
+  dt::array<V> out(n);
+  std::vector<V> offsets;
+  if (ngrpcols) offsets.push_back(0);
+  size_t prev_run = 0, prev_pos = 0;
+  for (size_t i = 0; i < n; ++i) {
+    std::pop_heap(heap.begin(), heap.end(), heapcmp);
+    size_t r = heap.back();
+    out[i] = runs[r]->order()[pos[r]];
+    // A new group starts when the row differs from the previous one
+    if (ngrpcols && i > 0 &&
+        cmp(prev_run, prev_pos, r, pos[r], ngrpcols) != 0) {
+      offsets.push_back(static_cast<V>(i));
+    }
+    prev_run = r;
+    prev_pos = pos[r];
+    if (++pos[r] < runs[r]->size()) {
+      std::push_heap(heap.begin(), heap.end(), heapcmp);
+    } else {
+      heap.pop_back();
+    }
+  }
+  result.first = RowIndex(std::move(out), false);
+  if (ngrpcols) {
+    offsets.push_back(static_cast<V>(n));
+    size_t ngroups = offsets.size() - 1;
+    MemoryRange offs = MemoryRange::mem(offsets.size() * sizeof(V));
+    std::memcpy(offs.wptr(), offsets.data(), offsets.size() * sizeof(V));
+    result.second = Groupby(ngroups, std::move(offs), sizeof(V) == 8);
+  }
+}
+
+
+//==============================================================================
+// Sort cache
+//==============================================================================
+
+SortCache::SortCache() : total_size(0) {}
+
+
+static bool _same_spec(const std::vector<sort_spec>& a,
+                       const std::vector<sort_spec>& b)
+{
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].col_index != b[i].col_index ||
+        a[i].descending != b[i].descending ||
+        a[i].na_last != b[i].na_last ||
+        a[i].sort_only != b[i].sort_only) return false;
+  }
+  return true;
+}
+
+
+bool SortCache::find(const std::vector<sort_spec>& spec, RiGb* out) {
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (!_same_spec(entries[i].spec, spec)) continue;
+    out->first = entries[i].rowindex;
+    out->second = entries[i].groupby;
+    // Move the entry to the end of the list, as the most recently used
+    std::rotate(entries.begin() + static_cast<long>(i),
+                entries.begin() + static_cast<long>(i) + 1, entries.end());
+    return true;
+  }
+  return false;
+}
+
+
+void SortCache::add(const std::vector<sort_spec>& spec, const RiGb& res) {
+  size_t limit = config::sort_cache_size;
+  size_t size = res.first.memory_footprint();
+  if (res.second) {
+    size_t elemsize = res.second.is64()? sizeof(int64_t) : sizeof(int32_t);
+    size += (res.second.ngroups() + 1) * elemsize;
+  }
+  if (size > limit) return;
+  size_t n = 0;  // number of entries to evict
+  while (total_size + size > limit) {
+    total_size -= entries[n++].size;
+  }
+  entries.erase(entries.begin(), entries.begin() + static_cast<long>(n));
+  entries.push_back({spec, res.first, res.second, size});
+  total_size += size;
+}
+
+
+size_t SortCache::memory_footprint() const {
+  return sizeof(*this) + entries.capacity() * sizeof(entry) + total_size;
+}
+
+
+static void _cache_sort_result(const DataTable* dt,
+                               const std::vector<sort_spec>& spec,
+                               const RiGb& res)
+{
+  if (config::sort_cache_size == 0) return;
+  if (!dt->sort_cache) dt->sort_cache = std::make_shared<SortCache>();
+  dt->sort_cache->add(spec, res);
+}
+
+
+
+//==============================================================================
+// Main entry points
+//==============================================================================
+
 RiGb DataTable::group(const std::vector<sort_spec>& spec, bool as_view) const
 {
   RiGb result;
-  size_t n = spec.size();
-  xassert(n > 0);
+  xassert(!spec.empty());
 
   Column* col0 = columns[spec[0].col_index];
   if (nrows <= 1) {
@@ -1258,6 +2397,9 @@ RiGb DataTable::group(const std::vector<sort_spec>& spec, bool as_view) const
     }
     return result;
   }
+  if (!as_view && sort_cache && sort_cache->find(spec, &result)) {
+    return result;
+  }
 
   #ifndef NDEBUG
     if (as_view) {
@@ -1273,23 +2415,141 @@ RiGb DataTable::group(const std::vector<sort_spec>& spec, bool as_view) const
     }
   }
 
-  bool do_groups = n > 1 || !spec[0].sort_only;
-  SortContext sc(nrows, col0->rowindex(), do_groups);
-  sc.start_sort(col0, spec[0].descending);
-  for (size_t j = 1; j < n; ++j) {
-    if (spec[j].sort_only && !spec[j - 1].sort_only) {
-      result.second = sc.copy_groups();
+  if (_use_int64(nrows, col0->rowindex())) {
+    if (!as_view && _use_external_sort<int64_t>(nrows)) {
+      _group_external<int64_t>(this, spec, result);
+    } else {
+      _group_impl<int64_t>(this, spec, result);
     }
-    if (j == n - 1 && spec[j].sort_only) {
-      do_groups = false;
+  } else {
+    if (!as_view && _use_external_sort<int32_t>(nrows)) {
+      _group_external<int32_t>(this, spec, result);
+    } else {
+      _group_impl<int32_t>(this, spec, result);
     }
-    sc.continue_sort(columns[spec[j].col_index],
-                     spec[j].descending, do_groups);
   }
-  result.first = sc.get_result_rowindex();
-  if (!spec[0].sort_only && !result.second) {
-    result.second = sc.extract_groups();
+  if (!as_view) _cache_sort_result(this, spec, result);
+  return result;
+}
+
+
+template <typename V>
+static RowIndex _sort_topk_impl(const DataTable* dt,
+                                const std::vector<sort_spec>& spec, size_t k)
+{
+  const Column* col0 = dt->columns[spec[0].col_index];
+  SortContext<V> sc(dt->nrows, col0->rowindex(), false);
+  dt::array<V> cand = sc.topk_candidates(col0, spec[0].descending, k);
+  if (cand.size() * 2 > dt->nrows) {
+    // Too many ties among the keys of the first column
+    return RowIndex();
+  }
+  RowIndex cand_ri(std::move(cand), true);
+  std::unique_ptr<DataTable> tmp(dt->copy());
+  tmp->apply_rowindex(cand_ri);
+  RowIndex order = tmp->group(spec).first * cand_ri;
+  return RowIndex(size_t(0), k, size_t(1)) * order;
+}
+
+
+/**
+ * Return the RowIndex of the first `k` rows of the frame sorted according to
+ * `spec`, i.e. the first `k` elements of `group(spec).first`. Instead of
+ * sorting all rows, the candidate rows that may be among the first `k` are
+ * selected using the keys of the first sort column, and only those are
+ * sorted. Since the sort is stable, the result is the same. If there are
+ * too many candidates, all rows are sorted.
+ */
+RowIndex DataTable::sort_topk(const std::vector<sort_spec>& spec,
+                              size_t k) const
+{
+  xassert(!spec.empty());
+  if (k > 0 && k < nrows) {
+    for (auto& s : spec) {
+      columns[s.col_index]->reify();
+    }
+    const Column* col0 = columns[spec[0].col_index];
+    RowIndex res = _use_int64(nrows, col0->rowindex())
+                   ? _sort_topk_impl<int64_t>(this, spec, k)
+                   : _sort_topk_impl<int32_t>(this, spec, k);
+    if (res) return res;
+  }
+  return group(spec).first;
+}
+
+
+/**
+ * Same as `group()`, but the rows are first split into groups via a hash
+ * table, and then only the first row of each group is sorted. The result is
+ * identical to that of `group()` (the rows within each group appear in their
+ * original order), but it is much cheaper to compute when the number of
+ * groups is small compared to the number of rows.
+ */
+RiGb DataTable::group_hashed(const std::vector<sort_spec>& spec) const {
+  // The hash table operates on 32-bit row numbers
+  if (nrows <= 1 || _use_int64(nrows, RowIndex())) return group(spec);
+  RiGb result;
+  if (sort_cache && sort_cache->find(spec, &result)) return result;
+  intvec cols;
+  for (auto& s : spec) {
+    xassert(!s.sort_only);
+    cols.push_back(s.col_index);
+  }
+  arr32_t heads = hash_row_heads(this, cols);
+  const int32_t* heads_data = heads.data();
+
+  // Sort the first rows of each group
+  size_t ngroups = 0;
+  for (size_t i = 0; i < nrows; ++i) {
+    ngroups += (static_cast<size_t>(heads_data[i]) == i);
+  }
+  arr32_t firsts(ngroups);
+  for (size_t i = 0, g = 0; i < nrows; ++i) {
+    if (static_cast<size_t>(heads_data[i]) == i) {
+      firsts[g++] = static_cast<int32_t>(i);
+    }
+  }
+  RowIndex firsts_ri(std::move(firsts), true);
+  RowIndex order;
+  {
+    std::unique_ptr<DataTable> tmp(copy());
+    tmp->apply_rowindex(firsts_ri);
+    order = tmp->group(spec).first * firsts_ri;
   }
+
+  // For each group's first row, `gids` is the index of that group in the
+  // sorted order. Then count the group sizes, and place the rows of each
+  // group at its offset.
+  arr32_t gids(nrows);
+  arr32_t offsets(ngroups + 1);
+  int32_t* gids_data = gids.data();
+  int32_t* offsets_data = offsets.data();
+  for (size_t g = 0; g < ngroups; ++g) {
+    gids_data[order[g]] = static_cast<int32_t>(g);
+    offsets_data[g + 1] = 0;
+  }
+  offsets_data[0] = 0;
+  for (size_t i = 0; i < nrows; ++i) {
+    offsets_data[gids_data[heads_data[i]] + 1]++;
+  }
+  for (size_t g = 0; g < ngroups; ++g) {
+    offsets_data[g + 1] += offsets_data[g];
+  }
+  arr32_t indices(nrows);
+  int32_t* indices_data = indices.data();
+  for (size_t i = 0; i < nrows; ++i) {
+    int32_t g = gids_data[heads_data[i]];
+    indices_data[offsets_data[g]++] = static_cast<int32_t>(i);
+  }
+  // The loop above shifted each offset to the start of the next group
+  for (size_t g = ngroups; g > 0; --g) {
+    offsets_data[g] = offsets_data[g - 1];
+  }
+  offsets_data[0] = 0;
+
+  result.first = RowIndex(std::move(indices), false);
+  result.second = Groupby(ngroups, offsets.to_memoryrange());
+  _cache_sort_result(this, spec, result);
   return result;
 }
 
@@ -1310,12 +2570,10 @@ static RowIndex sort_tiny(const Column* col, Groupby* out_grps) {
 }
 
 
-RowIndex Column::sort(Groupby* out_grps) const {
-  if (nrows <= 1) {
-    return sort_tiny(this, out_grps);
-  }
-  SortContext sc(nrows, rowindex(), (out_grps != nullptr));
-  sc.start_sort(this, false);
+template <typename V>
+static RowIndex _sort_impl(const Column* col, Groupby* out_grps) {
+  SortContext<V> sc(col->nrows, col->rowindex(), (out_grps != nullptr));
+  sc.start_sort(col, false);
   if (out_grps) {
     auto res = sc.get_result_groups();
     *out_grps = std::move(res.second);
@@ -1324,3 +2582,52 @@ RowIndex Column::sort(Groupby* out_grps) const {
     return sc.get_result_rowindex();
   }
 }
+
+
+uint8_t Column::compute_sortedness() const {
+  if (nrows <= 1) return SORTED_NONDECR | SORTED_NONINCR;
+  SortKey key(this, false);
+  size_t nth = static_cast<size_t>(config::sort_nthreads);
+  size_t nchunks = std::min(nth * 4, std::max(size_t(1), nrows / 4096));
+  size_t chunksize = (nrows - 2) / nchunks + 1;
+  int flags = SORTED_NONDECR | SORTED_NONINCR;
+  // Each chunk compares the pairs of adjacent rows `(i, i+1)` that start
+  // within it; the chunks are skipped once the column is known to be
+  // unsorted.
+  #pragma omp parallel for schedule(dynamic) num_threads(nth)
+  for (size_t c = 0; c < nchunks; ++c) {
+    int tflags;
+    #pragma omp atomic read
+    tflags = flags;
+    if (!tflags) continue;
+    size_t i0 = c * chunksize;
+    size_t i1 = std::min(nrows - 1, i0 + chunksize);
+    if (i0 >= i1) continue;
+    size_t jprev = ri? ri[i0] : i0;
+    uint64_t kprev = key.key(jprev);
+    for (size_t i = i0 + 1; i <= i1 && tflags; ++i) {
+      size_t j = ri? ri[i] : i;
+      uint64_t k = key.key(j);
+      int cmp = key.compare(jprev, kprev, j, k);
+      if (cmp > 0) tflags &= ~SORTED_NONDECR;
+      if (cmp < 0) tflags &= ~SORTED_NONINCR;
+      jprev = j;
+      kprev = k;
+    }
+    #pragma omp atomic
+    flags &= tflags;
+  }
+  return static_cast<uint8_t>(flags);
+}
+
+
+RowIndex Column::sort(Groupby* out_grps) const {
+  if (nrows <= 1) {
+    return sort_tiny(this, out_grps);
+  }
+  if (_use_int64(nrows, rowindex())) {
+    return _sort_impl<int64_t>(this, out_grps);
+  } else {
+    return _sort_impl<int32_t>(this, out_grps);
+  }
+}
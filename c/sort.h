@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #ifndef dt_SORT_h
 #define dt_SORT_h
+#include <cstdint>
 #include "utils/array.h"  // arr32_t
 
 
@@ -23,6 +24,8 @@ struct radix_range {
  * The end product of this class is the array of cumulative group sizes. This
  * array will have 1 + ngroups elements, with the first element being 0, and
  * the last the total number of elements in the data being sorted/grouped.
+ * The type `V` of the elements of this array is either `int32_t` or
+ * `int64_t`, same as the type of the ordering array in the `SortContext`.
  *
  * In order to accommodate parallel sorting, the array of group sizes is
  * provided externally, and is not managed by this class (only written to).
@@ -69,28 +72,28 @@ struct radix_range {
  *     `groups[count - 1]`.
  *
  */
-// TODO: Add support for 64-bit groups
+template <typename V>
 class GroupGatherer {
   private:
-    int32_t* groups;  // externally owned pointer
-    int32_t  count;
-    int32_t  cumsize;
+    V*     groups;  // externally owned pointer
+    size_t count;
+    V      cumsize;
 
   public:
     GroupGatherer();
-    void init(int32_t* data, int32_t cumsize0);
+    void init(V* data, V cumsize0);
 
-    int32_t* data() const { return groups; }
-    size_t   size() const { return static_cast<size_t>(count); }
-    int32_t  cumulative_size() const { return cumsize; }
+    V*     data() const { return groups; }
+    size_t size() const { return count; }
+    V      cumulative_size() const { return cumsize; }
     operator bool() const { return !!groups; }
 
     void push(size_t grp);
 
-    template <typename T, typename V>
+    template <typename T>
     void from_data(const T*, V*, size_t);
 
-    template <typename T, typename V>
+    template <typename T>
     void from_data(const uint8_t*, const T*, T, V*, size_t, bool descending);
 
     void from_chunks(radix_range* rrmap, size_t nradixes);
@@ -105,48 +108,73 @@ class GroupGatherer {
 //------------------------------------------------------------------------------
 
 template <typename T, typename V>
-void insert_sort_keys(const T* x, V* o, V* oo, int n, GroupGatherer& gg);
+void insert_sort_keys(const T* x, V* o, V* oo, int n, GroupGatherer<V>& gg);
 
 template <typename T, typename V>
-void insert_sort_values(const T* x, V* o, int n, GroupGatherer& gg);
+void insert_sort_values(const T* x, V* o, int n, GroupGatherer<V>& gg);
 
 template <typename T, typename V>
-void insert_sort_keys_str(const uint8_t*, const T*, T, V*, V*, int, GroupGatherer&, bool);
+void insert_sort_keys_str(const uint8_t*, const T*, T, V*, V*, int, GroupGatherer<V>&, bool);
 
 template <typename T, typename V>
-void insert_sort_values_str(const uint8_t*, const T*, T, V*, int, GroupGatherer&, bool);
+void insert_sort_values_str(const uint8_t*, const T*, T, V*, int, GroupGatherer<V>&, bool);
 
 template <int R, typename T>
 int compare_offstrings(const uint8_t*, T, T, T, T);
 
 
 
-extern template void insert_sort_keys(const uint8_t*,  int32_t*, int32_t*, int, GroupGatherer&);
-extern template void insert_sort_keys(const uint16_t*, int32_t*, int32_t*, int, GroupGatherer&);
-extern template void insert_sort_keys(const uint32_t*, int32_t*, int32_t*, int, GroupGatherer&);
-extern template void insert_sort_keys(const uint64_t*, int32_t*, int32_t*, int, GroupGatherer&);
+extern template void insert_sort_keys(const uint8_t*,  int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+extern template void insert_sort_keys(const uint16_t*, int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+extern template void insert_sort_keys(const uint32_t*, int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+extern template void insert_sort_keys(const uint64_t*, int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
 
-extern template void insert_sort_values(const uint8_t*,  int32_t*, int, GroupGatherer&);
-extern template void insert_sort_values(const uint16_t*, int32_t*, int, GroupGatherer&);
-extern template void insert_sort_values(const uint32_t*, int32_t*, int, GroupGatherer&);
-extern template void insert_sort_values(const uint64_t*, int32_t*, int, GroupGatherer&);
+extern template void insert_sort_values(const uint8_t*,  int32_t*, int, GroupGatherer<int32_t>&);
+extern template void insert_sort_values(const uint16_t*, int32_t*, int, GroupGatherer<int32_t>&);
+extern template void insert_sort_values(const uint32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+extern template void insert_sort_values(const uint64_t*, int32_t*, int, GroupGatherer<int32_t>&);
 
-extern template void insert_sort_keys_str(  const uint8_t*, const uint32_t*, uint32_t, int32_t*, int32_t*, int, GroupGatherer&, bool);
-extern template void insert_sort_values_str(const uint8_t*, const uint32_t*, uint32_t, int32_t*, int, GroupGatherer&, bool);
-extern template void insert_sort_keys_str(  const uint8_t*, const uint64_t*, uint64_t, int32_t*, int32_t*, int, GroupGatherer&, bool);
-extern template void insert_sort_values_str(const uint8_t*, const uint64_t*, uint64_t, int32_t*, int, GroupGatherer&, bool);
+extern template void insert_sort_keys_str(  const uint8_t*, const uint32_t*, uint32_t, int32_t*, int32_t*, int, GroupGatherer<int32_t>&, bool);
+extern template void insert_sort_values_str(const uint8_t*, const uint32_t*, uint32_t, int32_t*, int, GroupGatherer<int32_t>&, bool);
+extern template void insert_sort_keys_str(  const uint8_t*, const uint64_t*, uint64_t, int32_t*, int32_t*, int, GroupGatherer<int32_t>&, bool);
+extern template void insert_sort_values_str(const uint8_t*, const uint64_t*, uint64_t, int32_t*, int, GroupGatherer<int32_t>&, bool);
+
+extern template void insert_sort_keys(const uint8_t*,  int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+extern template void insert_sort_keys(const uint16_t*, int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+extern template void insert_sort_keys(const uint32_t*, int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+extern template void insert_sort_keys(const uint64_t*, int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+
+extern template void insert_sort_values(const uint8_t*,  int64_t*, int, GroupGatherer<int64_t>&);
+extern template void insert_sort_values(const uint16_t*, int64_t*, int, GroupGatherer<int64_t>&);
+extern template void insert_sort_values(const uint32_t*, int64_t*, int, GroupGatherer<int64_t>&);
+extern template void insert_sort_values(const uint64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+
+extern template void insert_sort_keys_str(  const uint8_t*, const uint32_t*, uint32_t, int64_t*, int64_t*, int, GroupGatherer<int64_t>&, bool);
+extern template void insert_sort_values_str(const uint8_t*, const uint32_t*, uint32_t, int64_t*, int, GroupGatherer<int64_t>&, bool);
+extern template void insert_sort_keys_str(  const uint8_t*, const uint64_t*, uint64_t, int64_t*, int64_t*, int, GroupGatherer<int64_t>&, bool);
+extern template void insert_sort_values_str(const uint8_t*, const uint64_t*, uint64_t, int64_t*, int, GroupGatherer<int64_t>&, bool);
 
 extern template int compare_offstrings<1>(const uint8_t*, uint32_t, uint32_t, uint32_t, uint32_t);
 extern template int compare_offstrings<1>(const uint8_t*, uint64_t, uint64_t, uint64_t, uint64_t);
 extern template int compare_offstrings<-1>(const uint8_t*, uint32_t, uint32_t, uint32_t, uint32_t);
 extern template int compare_offstrings<-1>(const uint8_t*, uint64_t, uint64_t, uint64_t, uint64_t);
 
-extern template void GroupGatherer::from_data(const uint8_t*,  int32_t*, size_t);
-extern template void GroupGatherer::from_data(const uint16_t*, int32_t*, size_t);
-extern template void GroupGatherer::from_data(const uint32_t*, int32_t*, size_t);
-extern template void GroupGatherer::from_data(const uint64_t*, int32_t*, size_t);
-extern template void GroupGatherer::from_data(const uint8_t*, const uint32_t*, uint32_t, int32_t*, size_t, bool);
-extern template void GroupGatherer::from_data(const uint8_t*, const uint64_t*, uint64_t, int32_t*, size_t, bool);
+extern template class GroupGatherer<int32_t>;
+extern template class GroupGatherer<int64_t>;
+
+extern template void GroupGatherer<int32_t>::from_data(const uint8_t*,  int32_t*, size_t);
+extern template void GroupGatherer<int32_t>::from_data(const uint16_t*, int32_t*, size_t);
+extern template void GroupGatherer<int32_t>::from_data(const uint32_t*, int32_t*, size_t);
+extern template void GroupGatherer<int32_t>::from_data(const uint64_t*, int32_t*, size_t);
+extern template void GroupGatherer<int32_t>::from_data(const uint8_t*, const uint32_t*, uint32_t, int32_t*, size_t, bool);
+extern template void GroupGatherer<int32_t>::from_data(const uint8_t*, const uint64_t*, uint64_t, int32_t*, size_t, bool);
+
+extern template void GroupGatherer<int64_t>::from_data(const uint8_t*,  int64_t*, size_t);
+extern template void GroupGatherer<int64_t>::from_data(const uint16_t*, int64_t*, size_t);
+extern template void GroupGatherer<int64_t>::from_data(const uint32_t*, int64_t*, size_t);
+extern template void GroupGatherer<int64_t>::from_data(const uint64_t*, int64_t*, size_t);
+extern template void GroupGatherer<int64_t>::from_data(const uint8_t*, const uint32_t*, uint32_t, int64_t*, size_t, bool);
+extern template void GroupGatherer<int64_t>::from_data(const uint8_t*, const uint64_t*, uint64_t, int64_t*, size_t, bool);
 
 
 #endif
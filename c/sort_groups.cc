@@ -11,25 +11,29 @@
 
 
 
-GroupGatherer::GroupGatherer()
-  : groups(nullptr) {}
+template <typename V>
+GroupGatherer<V>::GroupGatherer()
+  : groups(nullptr), count(0), cumsize(0) {}
 
 
-void GroupGatherer::init(int32_t* data, int32_t cumsize0) {
+template <typename V>
+void GroupGatherer<V>::init(V* data, V cumsize0) {
   groups = data;
   count = 0;
   cumsize = cumsize0;
 }
 
 
-void GroupGatherer::push(size_t grp) {
-  cumsize += static_cast<int32_t>(grp);
+template <typename V>
+void GroupGatherer<V>::push(size_t grp) {
+  cumsize += static_cast<V>(grp);
   groups[count++] = cumsize;
 }
 
 
-template <typename T, typename V>
-void GroupGatherer::from_data(const T* data, V* o, size_t n) {
+template <typename V>
+template <typename T>
+void GroupGatherer<V>::from_data(const T* data, V* o, size_t n) {
   if (n == 0) return;
   T curr_value = data[o[0]];
   size_t lasti = 0;
@@ -45,8 +49,9 @@ void GroupGatherer::from_data(const T* data, V* o, size_t n) {
 }
 
 
-template <typename T, typename V>
-void GroupGatherer::from_data(
+template <typename V>
+template <typename T>
+void GroupGatherer<V>::from_data(
   const uint8_t* strdata, const T* stroffs, T start, V* o, size_t n,
   bool descending
 ) {
@@ -70,7 +75,8 @@ void GroupGatherer::from_data(
 }
 
 
-void GroupGatherer::from_chunks(radix_range* rrmap, size_t nradixes) {
+template <typename V>
+void GroupGatherer<V>::from_chunks(radix_range* rrmap, size_t nradixes) {
   xassert(count == 0);
   size_t dest_off = 0;
   for (size_t i = 0; i < nradixes; ++i) {
@@ -79,24 +85,25 @@ void GroupGatherer::from_chunks(radix_range* rrmap, size_t nradixes) {
     size_t grp_off = rrmap[i].offset;
     if (grp_off != dest_off) {
       std::memmove(groups + dest_off, groups + grp_off,
-                   grp_size * sizeof(int32_t));
+                   grp_size * sizeof(V));
     }
     dest_off += grp_size;
   }
-  count = static_cast<int32_t>(dest_off);
+  count = dest_off;
   xassert(count > 0);
   cumsize = groups[count - 1];
 }
 
 
-void GroupGatherer::from_histogram(
+template <typename V>
+void GroupGatherer<V>::from_histogram(
   size_t* histogram, size_t nchunks, size_t nradixes)
 {
   xassert(count == 0);
   size_t* rrendoffsets = histogram + (nchunks - 1) * nradixes;
-  int32_t off0 = 0;
+  V off0 = 0;
   for (size_t i = 0; i < nradixes; ++i) {
-    int32_t off1 = static_cast<int32_t>(rrendoffsets[i]);
+    V off1 = static_cast<V>(rrendoffsets[i]);
     if (off1 > off0) {
       groups[count++] = cumsize + off1;
       off0 = off1;
@@ -106,9 +113,19 @@ void GroupGatherer::from_histogram(
 }
 
 
-template void GroupGatherer::from_data(const uint8_t*,  int32_t*, size_t);
-template void GroupGatherer::from_data(const uint16_t*, int32_t*, size_t);
-template void GroupGatherer::from_data(const uint32_t*, int32_t*, size_t);
-template void GroupGatherer::from_data(const uint64_t*, int32_t*, size_t);
-template void GroupGatherer::from_data(const uint8_t*, const uint32_t*, uint32_t, int32_t*, size_t, bool);
-template void GroupGatherer::from_data(const uint8_t*, const uint64_t*, uint64_t, int32_t*, size_t, bool);
+template class GroupGatherer<int32_t>;
+template class GroupGatherer<int64_t>;
+
+template void GroupGatherer<int32_t>::from_data(const uint8_t*,  int32_t*, size_t);
+template void GroupGatherer<int32_t>::from_data(const uint16_t*, int32_t*, size_t);
+template void GroupGatherer<int32_t>::from_data(const uint32_t*, int32_t*, size_t);
+template void GroupGatherer<int32_t>::from_data(const uint64_t*, int32_t*, size_t);
+template void GroupGatherer<int32_t>::from_data(const uint8_t*, const uint32_t*, uint32_t, int32_t*, size_t, bool);
+template void GroupGatherer<int32_t>::from_data(const uint8_t*, const uint64_t*, uint64_t, int32_t*, size_t, bool);
+
+template void GroupGatherer<int64_t>::from_data(const uint8_t*,  int64_t*, size_t);
+template void GroupGatherer<int64_t>::from_data(const uint16_t*, int64_t*, size_t);
+template void GroupGatherer<int64_t>::from_data(const uint32_t*, int64_t*, size_t);
+template void GroupGatherer<int64_t>::from_data(const uint64_t*, int64_t*, size_t);
+template void GroupGatherer<int64_t>::from_data(const uint8_t*, const uint32_t*, uint32_t, int64_t*, size_t, bool);
+template void GroupGatherer<int64_t>::from_data(const uint8_t*, const uint64_t*, uint64_t, int64_t*, size_t, bool);
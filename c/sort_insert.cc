@@ -93,7 +93,7 @@ int compare_offstrings(
  *      usually an ordering, this type is either `int32_t` or `int64_t`.
  */
 template <typename T, typename V>
-void insert_sort_values(const T* x, V* o, int n, GroupGatherer& gg)
+void insert_sort_values(const T* x, V* o, int n, GroupGatherer<V>& gg)
 {
   o[0] = 0;
   for (int i = 1; i < n; ++i) {
@@ -129,7 +129,7 @@ void insert_sort_values(const T* x, V* o, int n, GroupGatherer& gg)
  *      usually an ordering, this type is either `int32_t` or `int64_t`.
  */
 template <typename T, typename V>
-void insert_sort_keys(const T* x, V* o, V* tmp, int n, GroupGatherer& gg)
+void insert_sort_keys(const T* x, V* o, V* tmp, int n, GroupGatherer<V>& gg)
 {
   insert_sort_values(x, tmp, n, gg);
   for (int i = 0; i < n; ++i) {
@@ -155,7 +155,7 @@ void insert_sort_keys(const T* x, V* o, V* tmp, int n, GroupGatherer& gg)
 template <typename T, typename V>
 void insert_sort_keys_str(
     const uint8_t* strdata, const T* stroffs, T strstart, V* o, V* tmp, int n,
-    GroupGatherer& gg, bool descending)
+    GroupGatherer<V>& gg, bool descending)
 {
   auto compfn = descending? compare_offstrings<-1, T>
                           : compare_offstrings<1, T>;
@@ -188,7 +188,7 @@ void insert_sort_keys_str(
 template <typename T, typename V>
 void insert_sort_values_str(
     const uint8_t* strdata, const T* stroffs, T strstart, V* o, int n,
-    GroupGatherer& gg, bool descending)
+    GroupGatherer<V>& gg, bool descending)
 {
   auto compfn = descending? compare_offstrings<-1, T>
                           : compare_offstrings<1, T>;
@@ -219,20 +219,35 @@ void insert_sort_values_str(
 // Explicitly instantiate template functions
 //==============================================================================
 
-template void insert_sort_keys(const uint8_t*,  int32_t*, int32_t*, int, GroupGatherer&);
-template void insert_sort_keys(const uint16_t*, int32_t*, int32_t*, int, GroupGatherer&);
-template void insert_sort_keys(const uint32_t*, int32_t*, int32_t*, int, GroupGatherer&);
-template void insert_sort_keys(const uint64_t*, int32_t*, int32_t*, int, GroupGatherer&);
-
-template void insert_sort_values(const uint8_t*,  int32_t*, int, GroupGatherer&);
-template void insert_sort_values(const uint16_t*, int32_t*, int, GroupGatherer&);
-template void insert_sort_values(const uint32_t*, int32_t*, int, GroupGatherer&);
-template void insert_sort_values(const uint64_t*, int32_t*, int, GroupGatherer&);
-
-template void insert_sort_keys_str(  const uint8_t*, const uint32_t*, uint32_t, int32_t*, int32_t*, int, GroupGatherer&, bool);
-template void insert_sort_values_str(const uint8_t*, const uint32_t*, uint32_t, int32_t*, int, GroupGatherer&, bool);
-template void insert_sort_keys_str(  const uint8_t*, const uint64_t*, uint64_t, int32_t*, int32_t*, int, GroupGatherer&, bool);
-template void insert_sort_values_str(const uint8_t*, const uint64_t*, uint64_t, int32_t*, int, GroupGatherer&, bool);
+template void insert_sort_keys(const uint8_t*,  int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+template void insert_sort_keys(const uint16_t*, int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+template void insert_sort_keys(const uint32_t*, int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+template void insert_sort_keys(const uint64_t*, int32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+
+template void insert_sort_values(const uint8_t*,  int32_t*, int, GroupGatherer<int32_t>&);
+template void insert_sort_values(const uint16_t*, int32_t*, int, GroupGatherer<int32_t>&);
+template void insert_sort_values(const uint32_t*, int32_t*, int, GroupGatherer<int32_t>&);
+template void insert_sort_values(const uint64_t*, int32_t*, int, GroupGatherer<int32_t>&);
+
+template void insert_sort_keys_str(  const uint8_t*, const uint32_t*, uint32_t, int32_t*, int32_t*, int, GroupGatherer<int32_t>&, bool);
+template void insert_sort_values_str(const uint8_t*, const uint32_t*, uint32_t, int32_t*, int, GroupGatherer<int32_t>&, bool);
+template void insert_sort_keys_str(  const uint8_t*, const uint64_t*, uint64_t, int32_t*, int32_t*, int, GroupGatherer<int32_t>&, bool);
+template void insert_sort_values_str(const uint8_t*, const uint64_t*, uint64_t, int32_t*, int, GroupGatherer<int32_t>&, bool);
+
+template void insert_sort_keys(const uint8_t*,  int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+template void insert_sort_keys(const uint16_t*, int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+template void insert_sort_keys(const uint32_t*, int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+template void insert_sort_keys(const uint64_t*, int64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+
+template void insert_sort_values(const uint8_t*,  int64_t*, int, GroupGatherer<int64_t>&);
+template void insert_sort_values(const uint16_t*, int64_t*, int, GroupGatherer<int64_t>&);
+template void insert_sort_values(const uint32_t*, int64_t*, int, GroupGatherer<int64_t>&);
+template void insert_sort_values(const uint64_t*, int64_t*, int, GroupGatherer<int64_t>&);
+
+template void insert_sort_keys_str(  const uint8_t*, const uint32_t*, uint32_t, int64_t*, int64_t*, int, GroupGatherer<int64_t>&, bool);
+template void insert_sort_values_str(const uint8_t*, const uint32_t*, uint32_t, int64_t*, int, GroupGatherer<int64_t>&, bool);
+template void insert_sort_keys_str(  const uint8_t*, const uint64_t*, uint64_t, int64_t*, int64_t*, int, GroupGatherer<int64_t>&, bool);
+template void insert_sort_values_str(const uint8_t*, const uint64_t*, uint64_t, int64_t*, int, GroupGatherer<int64_t>&, bool);
 
 template int compare_offstrings<1>(const uint8_t*, uint32_t, uint32_t, uint32_t, uint32_t);
 template int compare_offstrings<1>(const uint8_t*, uint64_t, uint64_t, uint64_t, uint64_t);
@@ -39,6 +39,7 @@ static const char* stat_name(Stat s) {
     case Stat::Mode:    return "Mode";
     case Stat::NModal:  return "NModal";
     case Stat::NUnique: return "NUnique";
+    case Stat::Sorted:  return "Sorted";
   }
   throw RuntimeError() << "Unknown stat " << int(s);
 }
@@ -49,7 +50,7 @@ static const char* stat_name(Stat s) {
 // Base Stats
 //==============================================================================
 
-Stats::Stats() {
+Stats::Stats() : _sorted(0), _sorted_hint(false) {
   TRACK(this, sizeof(*this), "Stats");
 }
 
@@ -60,6 +61,7 @@ Stats::~Stats() {
 
 void Stats::reset() {
   _computed.reset();
+  _sorted_hint = false;
 }
 
 bool Stats::is_computed(Stat s) const {
@@ -90,11 +92,44 @@ size_t Stats::nmodal(const Column* col) {
   return _nmodal;
 }
 
+/**
+ * Sortedness flags of the column (see `SORTED_NONDECR` and `SORTED_NONINCR`).
+ * The check itself is implemented in "sort.cc".
+ */
+uint8_t Stats::sortedness(const Column* col) {
+  if (!is_computed(Stat::Sorted)) {
+    bool unsorted_hint = _sorted_hint && _sorted == 0;
+    _sorted = unsorted_hint? 0 : col->compute_sortedness();
+    _sorted_hint = false;
+    set_computed(Stat::Sorted);
+  }
+  return _sorted;
+}
+
 void Stats::set_countna(size_t n) {
   set_computed(Stat::NaCount, true);
   _countna = n;
 }
 
+void Stats::set_sortedness(uint8_t flags) {
+  set_computed(Stat::Sorted, true);
+  _sorted = flags;
+  _sorted_hint = false;
+}
+
+/**
+ * Sortedness flags that come from an untrusted source, such as a Jay file.
+ * The hint that the column is unsorted is accepted as is, since at worst the
+ * column will be sorted the regular way. A hint that the column is sorted is
+ * verified on the first call to `sortedness()`, so that a stale file cannot
+ * produce a wrong sort order.
+ */
+void Stats::set_sortedness_hint(uint8_t flags) {
+  if (is_computed(Stat::Sorted)) return;
+  _sorted = flags;
+  _sorted_hint = true;
+}
+
 size_t Stats::memory_footprint() const {
   return sizeof(*this);
 }
@@ -113,12 +148,56 @@ void Stats::verify_integrity(const Column* col) const {
   verify_stat(Stat::NaCount, _countna, [&](){ return test->countna(col); });
   verify_stat(Stat::NUnique, _nunique, [&](){ return test->nunique(col); });
   verify_stat(Stat::NModal,  _nmodal,  [&](){ return test->nmodal(col); });
+  verify_stat(Stat::Sorted,  int(_sorted),
+              [&](){ return int(test->sortedness(col)); });
   verify_more(test.get(), col);
 }
 
 void Stats::verify_more(Stats*, const Column*) const {}
 
 
+/**
+ * Find the largest among the groups `i0 .. ngroups - 1` of the groupby, and
+ * return its index. The size of that group is stored into `*max_grpsize`.
+ */
+template <typename V>
+static size_t _largest_group(const V* groups, size_t i0, size_t n,
+                             size_t* max_grpsize)
+{
+  size_t best_igrp = 0;
+  for (size_t i = i0; i < n; ++i) {
+    size_t grpsize = static_cast<size_t>(groups[i + 1] - groups[i]);
+    if (grpsize > *max_grpsize) {
+      *max_grpsize = grpsize;
+      best_igrp = i;
+    }
+  }
+  return best_igrp;
+}
+
+static size_t largest_group(const Groupby& grpby, size_t i0,
+                            size_t* max_grpsize)
+{
+  size_t n = grpby.ngroups();
+  return grpby.is64()
+    ? _largest_group(grpby.offsets64_r(), i0, n, max_grpsize)
+    : _largest_group(grpby.offsets_r(), i0, n, max_grpsize);
+}
+
+static size_t group_size(const Groupby& grpby, size_t i) {
+  size_t i0, i1;
+  grpby.get_group(i, &i0, &i1);
+  return i1 - i0;
+}
+
+static size_t group_start(const Groupby& grpby, size_t i) {
+  size_t i0, i1;
+  grpby.get_group(i, &i0, &i1);
+  return i0;
+}
+
+
+
 template <typename T, typename F>
 void Stats::verify_stat(Stat s, T value, F getter) const {
   if (!is_computed(s)) return;
@@ -266,7 +345,6 @@ void NumericalStats_<T, A>::compute_sorted_stats(const Column* col) {
   const T* coldata = static_cast<const T*>(col->data());
   Groupby grpby;
   RowIndex ri = col->sort(&grpby);
-  const int32_t* groups = grpby.offsets_r();
   size_t n_groups = grpby.ngroups();
 
   // Sorting gathers all NA elements at the top (in the first group). Thus if
@@ -274,7 +352,7 @@ void NumericalStats_<T, A>::compute_sorted_stats(const Column* col) {
   // checking whether the elements in the first group are NA or not.
   if (!is_computed(Stat::NaCount)) {
     T x0 = coldata[ri[0]];
-    _countna = ISNA<T>(x0)? static_cast<size_t>(groups[1]) : 0;
+    _countna = ISNA<T>(x0)? group_size(grpby, 0) : 0;
     set_computed(Stat::NaCount);
   }
 
@@ -283,17 +361,10 @@ void NumericalStats_<T, A>::compute_sorted_stats(const Column* col) {
   set_computed(Stat::NUnique);
 
   size_t max_grpsize = 0;
-  size_t best_igrp = 0;
-  for (size_t i = has_nas; i < n_groups; ++i) {
-    size_t grpsize = static_cast<size_t>(groups[i + 1] - groups[i]);
-    if (grpsize > max_grpsize) {
-      max_grpsize = grpsize;
-      best_igrp = i;
-    }
-  }
+  size_t best_igrp = largest_group(grpby, has_nas, &max_grpsize);
 
   _nmodal = max_grpsize;
-  size_t ig = static_cast<size_t>(groups[best_igrp]);
+  size_t ig = group_start(grpby, best_igrp);
   _mode = max_grpsize ? coldata[ri[ig]] : GETNA<T>();
   set_computed(Stat::NModal);
   set_computed(Stat::Mode);
@@ -552,12 +623,11 @@ void StringStats<T>::compute_sorted_stats(const Column* col) {
   const T* offsets = scol->offsets();
   Groupby grpby;
   RowIndex ri = col->sort(&grpby);
-  const int32_t* groups = grpby.offsets_r();
   size_t n_groups = grpby.ngroups();
 
   if (!is_computed(Stat::NaCount)) {
     T off0 = offsets[ri[0]];
-    _countna = ISNA<T>(off0)? static_cast<size_t>(groups[1]) : 0;
+    _countna = ISNA<T>(off0)? group_size(grpby, 0) : 0;
     set_computed(Stat::NaCount);
   }
 
@@ -566,17 +636,10 @@ void StringStats<T>::compute_sorted_stats(const Column* col) {
   set_computed(Stat::NUnique);
 
   size_t max_grpsize = 0;
-  size_t best_igrp = 0;
-  for (size_t i = has_nas; i < n_groups; ++i) {
-    size_t grpsize = static_cast<size_t>(groups[i + 1] - groups[i]);
-    if (grpsize > max_grpsize) {
-      max_grpsize = grpsize;
-      best_igrp = i;
-    }
-  }
+  size_t best_igrp = largest_group(grpby, has_nas, &max_grpsize);
 
   if (max_grpsize) {
-    size_t ig = static_cast<size_t>(groups[best_igrp]);
+    size_t ig = group_start(grpby, best_igrp);
     size_t i = ri[ig];
     T o0 = offsets[i - 1] & ~GETNA<T>();
     _nmodal = max_grpsize;
@@ -28,9 +28,20 @@ enum class Stat : uint8_t {
   Max     = 10,
   Mode    = 11,
   NModal  = 12,
-  NUnique = 13
+  NUnique = 13,
+  Sorted  = 14
 };
-constexpr uint8_t NSTATS = 14;
+constexpr uint8_t NSTATS = 15;
+
+/**
+ * Flags of the `Stat::Sorted` statistic. A column is "non-decreasing" if its
+ * values are already in the order produced by an ascending sort (NAs first,
+ * then non-decreasing values); and "non-increasing" if they are in exactly
+ * the opposite order (non-increasing values, NAs last). A column where all
+ * values are equal has both flags, and an unsorted column has neither.
+ */
+constexpr uint8_t SORTED_NONDECR = 1;
+constexpr uint8_t SORTED_NONINCR = 2;
 
 
 
@@ -75,6 +86,9 @@ class Stats {
     size_t _countna;
     size_t _nunique;
     size_t _nmodal;
+    uint8_t _sorted;
+    bool _sorted_hint;  // `_sorted` is a hint that was not computed
+    size_t : 48;
 
   public:
     Stats();
@@ -85,10 +99,13 @@ class Stats {
     size_t countna(const Column*);
     size_t nunique(const Column*);
     size_t nmodal(const Column*);
+    uint8_t sortedness(const Column*);
 
     bool is_computed(Stat s) const;
     void reset();
     void set_countna(size_t n);
+    void set_sortedness(uint8_t flags);
+    void set_sortedness_hint(uint8_t flags);
     virtual void merge_stats(const Stats*);
 
     virtual size_t memory_footprint() const = 0;
@@ -0,0 +1,35 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#ifndef dt_UTILS_SIMD_h
+#define dt_UTILS_SIMD_h
+
+// Support for kernels compiled for several instruction sets.
+//
+// A kernel is written as a simple loop, marked `DT_KERNEL`, and avoiding
+// branches in its body (NA checks should be written as selects), so that
+// the compiler can vectorize it. The kernel is then wrapped into a function
+// marked `DT_TARGET_AVX2`, which compiles the same loop for the AVX2
+// instruction set. At runtime the AVX2 version is used only if the CPU
+// supports it, see `cpu_has_avx2()`. The baseline version is compiled for the
+// default target (SSE2 on x86-64).
+//
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define DT_KERNEL inline __attribute__((always_inline))
+  #define DT_TARGET_AVX2 __attribute__((target("avx2")))
+  inline bool cpu_has_avx2() {
+    static const bool res = __builtin_cpu_supports("avx2");
+    return res;
+  }
+#else
+  #define DT_KERNEL inline
+  #define DT_TARGET_AVX2
+  inline bool cpu_has_avx2() { return false; }
+#endif
+
+
+#endif
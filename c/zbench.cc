@@ -0,0 +1,306 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+// Internal benchmarks of the sorting, grouping and joining algorithms. These
+// run directly on the C++ structures, so that the timings do not include the
+// overhead of the python layer (such as evaluation of the `DT[i, j, ...]`
+// expression, or materializing the result). The synthetic data is generated
+// outside of the timed region.
+//
+// The benchmarks are invoked via `core.benchmark_internal()` from the python
+// driver "benchmarks/bench.py", which also collects the results into JSON.
+// They are compiled only when DTBENCH is defined (in debug builds, or when
+// building with the environment variable DTBENCH=1).
+//------------------------------------------------------------------------------
+#ifdef DTBENCH
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include "datatablemodule.h"
+#include "datatable.h"
+#include "python/args.h"
+#include "python/float.h"
+#include "python/list.h"
+#include "python/string.h"
+#include "utils/exceptions.h"
+namespace dtbench {
+
+
+//------------------------------------------------------------------------------
+// Synthetic data
+//------------------------------------------------------------------------------
+
+template <typename T>
+static Column* _make_fw_column(SType stype, size_t nrows, size_t ncard,
+                               std::mt19937_64& rng) {
+  Column* col = Column::new_data_column(stype, nrows);
+  T* data = static_cast<T*>(col->data_w());
+  std::uniform_int_distribution<size_t> value(0, ncard - 1);
+  std::uniform_int_distribution<int> na(0, 99);
+  for (size_t i = 0; i < nrows; ++i) {
+    data[i] = na(rng)? static_cast<T>(value(rng)) : GETNA<T>();
+  }
+  return col;
+}
+
+template <typename T>
+static Column* _make_real_column(SType stype, size_t nrows, size_t ncard,
+                                 std::mt19937_64& rng) {
+  Column* col = Column::new_data_column(stype, nrows);
+  T* data = static_cast<T*>(col->data_w());
+  std::uniform_int_distribution<size_t> value(0, ncard - 1);
+  std::uniform_int_distribution<int> na(0, 99);
+  T scale = static_cast<T>(1.0 / static_cast<double>(ncard));
+  for (size_t i = 0; i < nrows; ++i) {
+    data[i] = na(rng)? static_cast<T>(value(rng)) * scale : GETNA<T>();
+  }
+  return col;
+}
+
+static Column* _make_str_column(size_t nrows, size_t ncard,
+                                std::mt19937_64& rng) {
+  std::uniform_int_distribution<size_t> value(0, ncard - 1);
+  std::uniform_int_distribution<int> na(0, 99);
+  MemoryRange offbuf = MemoryRange::mem((nrows + 1) * sizeof(uint32_t));
+  uint32_t* offs = static_cast<uint32_t*>(offbuf.wptr());
+  std::string strs;
+  char tmp[32];
+  offs[0] = 0;
+  for (size_t i = 0; i < nrows; ++i) {
+    uint32_t off = static_cast<uint32_t>(strs.size());
+    if (na(rng)) {
+      int len = std::snprintf(tmp, sizeof(tmp), "id-%zu", value(rng));
+      strs.append(tmp, static_cast<size_t>(len));
+      offs[i + 1] = off + static_cast<uint32_t>(len);
+    } else {
+      offs[i + 1] = off | GETNA<uint32_t>();
+    }
+  }
+  MemoryRange strbuf = MemoryRange::mem(strs.size());
+  if (!strs.empty()) std::memcpy(strbuf.wptr(), strs.data(), strs.size());
+  return new_string_column(nrows, std::move(offbuf), std::move(strbuf));
+}
+
+/**
+ * Create a column of type `stype` with `nrows` random values, drawn
+ * uniformly from `ncard` distinct values (fewer if the type cannot hold that
+ * many), with approximately 1% of NAs. String values have the form
+ * "id-<number>". The data depends only on the state of `rng`.
+ */
+static Column* make_column(SType stype, size_t nrows, size_t ncard,
+                           std::mt19937_64& rng) {
+  using std::min;
+  switch (stype) {
+    case SType::BOOL:
+      return _make_fw_column<int8_t>(stype, nrows, min(ncard, size_t(2)), rng);
+    case SType::INT8:
+      return _make_fw_column<int8_t>(stype, nrows, min(ncard, size_t(127)), rng);
+    case SType::INT16:
+      return _make_fw_column<int16_t>(stype, nrows, min(ncard, size_t(32767)),
+                                      rng);
+    case SType::INT32:
+      return _make_fw_column<int32_t>(stype, nrows, ncard, rng);
+    case SType::INT64:
+      return _make_fw_column<int64_t>(stype, nrows, ncard, rng);
+    case SType::FLOAT32:
+      return _make_real_column<float>(stype, nrows, ncard, rng);
+    case SType::FLOAT64:
+      return _make_real_column<double>(stype, nrows, ncard, rng);
+    case SType::STR32:
+    case SType::STR64:
+      return _make_str_column(nrows, ncard, rng);
+    default:
+      throw ValueError() << "Benchmarks do not support stype " << stype;
+  }
+}
+
+
+/**
+ * Frame with a single column "A" of synthetic data.
+ */
+static dtptr make_frame(SType stype, size_t nrows, size_t ncard,
+                        std::mt19937_64& rng) {
+  colvec cols = {make_column(stype, nrows, ncard, rng)};
+  return dtptr(new DataTable(std::move(cols), strvec {"A"}));
+}
+
+
+/**
+ * Frame with a single column "A" holding each of the values `0..ncard-1`
+ * exactly once, in random order: the right-hand side of a join.
+ */
+static dtptr make_join_frame(SType stype, size_t ncard,
+                             std::mt19937_64& rng) {
+  Column* col = Column::new_data_column(stype, ncard);
+  void* data = col->data_w();
+  std::vector<size_t> values(ncard);
+  for (size_t i = 0; i < ncard; ++i) values[i] = i;
+  std::shuffle(values.begin(), values.end(), rng);
+  for (size_t i = 0; i < ncard; ++i) {
+    if (stype == SType::INT32) {
+      static_cast<int32_t*>(data)[i] = static_cast<int32_t>(values[i]);
+    } else {
+      static_cast<int64_t*>(data)[i] = static_cast<int64_t>(values[i]);
+    }
+  }
+  colvec cols = {col};
+  return dtptr(new DataTable(std::move(cols), strvec {"A"}));
+}
+
+
+
+//------------------------------------------------------------------------------
+// Benchmarks
+//------------------------------------------------------------------------------
+
+struct Benchmark {
+  const char* name;
+  const char* description;
+  // Prepare the data (not timed), and return the function to be timed
+  std::function<std::function<void()>(SType, size_t, size_t,
+                                      std::mt19937_64&)> prepare;
+};
+
+static std::vector<Benchmark> benchmarks() {
+  // The frames are kept alive by the returned closures. The caches within
+  // the frames are discarded before each run, so that every run does the
+  // full work.
+  using sdtptr = std::shared_ptr<DataTable>;
+  return {
+    {"sort", "Order the rows of column A (`DataTable::group`, sort only)",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       sdtptr dt(make_frame(st, nrows, ncard, rng).release());
+       return [=]{
+         dt->reset_indices();
+         dt->group({sort_spec(0, false, false, true)});
+       };
+     }},
+    {"sort_desc", "Order the rows of column A in descending order",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       sdtptr dt(make_frame(st, nrows, ncard, rng).release());
+       return [=]{
+         dt->reset_indices();
+         dt->group({sort_spec(0, true, false, true)});
+       };
+     }},
+    {"group", "Sort column A and find the groups of equal values",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       sdtptr dt(make_frame(st, nrows, ncard, rng).release());
+       return [=]{
+         dt->reset_indices();
+         dt->group({sort_spec(0)});
+       };
+     }},
+    {"group_hashed", "Find the groups of column A with a hash table",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       sdtptr dt(make_frame(st, nrows, ncard, rng).release());
+       return [=]{
+         dt->reset_indices();
+         dt->group_hashed({sort_spec(0)});
+       };
+     }},
+    {"sort_topk", "Find the first 10 rows of the frame sorted by column A",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       sdtptr dt(make_frame(st, nrows, ncard, rng).release());
+       return [=]{
+         dt->sort_topk({sort_spec(0)}, 10);
+       };
+     }},
+    {"hash_rows", "Find the first row of each distinct value in column A "
+                  "(used by the set functions)",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       sdtptr dt(make_frame(st, nrows, ncard, rng).release());
+       return [=]{
+         hash_row_heads(dt.get(), {0});
+       };
+     }},
+    {"join", "Left join of column A to a frame of `ncard` unique values "
+             "(`natural_join`)",
+     [](SType st, size_t nrows, size_t ncard, std::mt19937_64& rng) {
+       if (st != SType::INT32 && st != SType::INT64) {
+         throw ValueError() << "Benchmark `join` supports int32 and int64 "
+             "columns only";
+       }
+       sdtptr xdt(make_frame(st, nrows, ncard, rng).release());
+       sdtptr jdt(make_join_frame(st, ncard, rng).release());
+       return [=]{
+         jdt->reset_indices();
+         jdt->join_nlookups = 0;
+         natural_join(xdt.get(), jdt.get());
+       };
+     }},
+  };
+}
+
+
+
+//------------------------------------------------------------------------------
+// Python interface
+//------------------------------------------------------------------------------
+
+static py::PKArgs arg_benchmark(
+  0, 6, 0, false, false,
+  {"name", "stype", "nrows", "ncard", "nreps", "seed"},
+  "benchmark_internal",
+R"(benchmark_internal(name=None, stype=None, nrows=None, ncard=None,
+                   nreps=3, seed=0)
+--
+
+Run the internal benchmark `name` on a column of type `stype` with `nrows`
+random values drawn from `ncard` distinct values (default `nrows`), and
+return the list of `nreps` timings (in seconds) of the benchmarked
+operation. If `name` is not given, return the list of tuples
+`(name, description)` for all available benchmarks.
+)");
+
+static py::oobj benchmark(const py::PKArgs& args) {
+  auto bms = benchmarks();
+  if (args[0].is_none_or_undefined()) {
+    py::olist res(bms.size());
+    for (size_t i = 0; i < bms.size(); ++i) {
+      res.set(i, py::otuple(py::ostring(bms[i].name),
+                            py::ostring(bms[i].description)));
+    }
+    return std::move(res);
+  }
+  std::string name = args[0].to_string();
+  SType stype = args[1].to_stype();
+  size_t nrows = args[2].to_size_t();
+  size_t ncard = args[3].is_none_or_undefined()? nrows : args[3].to_size_t();
+  size_t nreps = args[4].is_none_or_undefined()? 3 : args[4].to_size_t();
+  int64_t seed = args[5].to<int64_t>(0);
+  if (ncard == 0) ncard = 1;
+
+  for (const Benchmark& bm : bms) {
+    if (name != bm.name) continue;
+    std::mt19937_64 rng(static_cast<uint64_t>(seed));
+    std::function<void()> fn = bm.prepare(stype, nrows, ncard, rng);
+    py::olist res(nreps);
+    for (size_t i = 0; i < nreps; ++i) {
+      auto t0 = std::chrono::steady_clock::now();
+      fn();
+      auto t1 = std::chrono::steady_clock::now();
+      res.set(i, py::ofloat(std::chrono::duration<double>(t1 - t0).count()));
+    }
+    return std::move(res);
+  }
+  throw ValueError() << "Unknown benchmark `" << name << "`";
+}
+
+
+}  // namespace dtbench
+
+
+
+void py::DatatableModule::init_benchmarks() {
+  ADD_FN(&dtbench::benchmark, dtbench::arg_benchmark);
+}
+
+#endif
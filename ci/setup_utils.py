@@ -446,6 +446,11 @@ def get_extra_compile_flags():
         else:
             flags += ["-O3", "-g0"]
 
+        # The internal benchmarks (c/zbench.cc) are compiled into debug
+        # builds, so that they are tested, or on request via DTBENCH.
+        if "DTBENCH" in os.environ or "-DDTTEST" in flags:
+            flags += ["-DDTBENCH"]
+
         if "CI_EXTRA_COMPILE_ARGS" in os.environ:
             flags += [os.environ["CI_EXTRA_COMPILE_ARGS"]]
 
@@ -186,6 +186,68 @@ options.register_option(
 options.register_option(
     "sort.nthreads", xtype=int, default=4)
 
+options.register_option(
+    "sort.max_int32_rows", xtype=int, default=2**31 - 1,
+    doc="Frames with more rows than this are sorted and grouped using 64-bit "
+        "row indices and group offsets; smaller frames use the more compact "
+        "32-bit ones. Lowering this value is mostly useful for testing.")
+
+options.register_option(
+    "sort.memory_budget", xtype=int, default=0,
+    doc="Maximum amount of memory (in bytes) that sorting a frame may use for "
+        "its working buffers. Larger frames are sorted in runs that are "
+        "spilled into temporary memory-mapped files, and then merged. The "
+        "files are created in the $TMPDIR directory. The value 0 means there "
+        "is no limit.")
+
+options.register_option(
+    "sort.cache_size", xtype=int, default=2**28,
+    doc="Maximum amount of memory (in bytes) used by each frame for caching "
+        "the results of its recent sorts and groupbys, so that sorting or "
+        "grouping a frame again by the same columns is instant. The cache is "
+        "discarded when the frame is modified. The value 0 disables the "
+        "cache.")
+
+options.register_option(
+    "sort.packed_strings", xtype=bool, default=True,
+    doc="Sort string columns by their prefixes packed into 64-bit keys, "
+        "7 characters at a time, instead of one character at a time. Only "
+        "the strings that are tied on all the characters compared so far "
+        "are sorted further.")
+
+options.register_option(
+    "groupby.method", xtype=str, default="auto",
+    doc="Algorithm used for grouping rows in a `by()` clause: 'sort' sorts "
+        "all rows by the group columns; 'hash' finds the groups using a "
+        "hash table, and then sorts only the first row of each group; "
+        "'auto' chooses between the two based on the estimated number of "
+        "groups.")
+
+options.register_option(
+    "join.max_int32_rows", xtype=int, default=2**31 - 1,
+    doc="Largest number of rows in either of the joined frames, and in the "
+        "result of a join, for which the join is computed with 32-bit row "
+        "indices. Bigger joins match the rows and build the result's "
+        "rowindices using 64-bit indices, which take twice as much memory.")
+
+options.register_option(
+    "expr.chunk_size", xtype=int, default=4096,
+    doc="Arithmetic, relational and logical expressions over numeric columns "
+        "are evaluated in chunks of this many rows, so that the intermediate "
+        "results of a compound expression such as `(f.A * 2 + f.B) / f.C` "
+        "are kept in small buffers instead of full columns. The value 0 "
+        "turns this off, and every subexpression is evaluated into a "
+        "column.")
+
+options.register_option(
+    "expr.cache_size", xtype=int, default=0,
+    doc="Number of results of reducers applied to a column, such as "
+        "`mean(f.A)`, that are kept for reuse by subsequent queries. A "
+        "cached result is discarded when the column is modified. The cache "
+        "keeps the data of such columns alive, and the first modification "
+        "of a column in the cache copies its data. The value 0 turns the "
+        "cache off.")
+
 options.register_option(
     "frame.names_auto_index", xtype=int, default=0,
     doc="When Frame needs to auto-name columns, they will be assigned "
@@ -804,6 +804,63 @@ def test_filter_on_view3():
     assert df2.to_list() == [[0, 5, 10]]
 
 
+def test_filter_on_view_bool_column():
+    df0 = dt.Frame(A=range(6), B=[True, None, False, True, None, True])
+    df1 = df0[1:, :]
+    df2 = df1[f.B, :]
+    df2.internal.check()
+    assert df2.to_list() == [[3, 5], [True, True]]
+
+
+
+#-------------------------------------------------------------------------------
+# Filters with logical operators
+#
+# Filter expressions are evaluated straight into a RowIndex: `&` checks its
+# right operand only on rows where the left one is true, and `|` skips the
+# rows where the left operand is NA. The results must be the same as with
+# the boolean column computed first (`expr.chunk_size = 0`).
+#-------------------------------------------------------------------------------
+
+def test_filter_logical_ops():
+    DT = dt.Frame(A=[1, 2, None, 4, 5, 6], B=[5, None, 3, 2, 1, 0])
+    assert DT[(f.A > 1) & (f.B > 0), :].to_list() == [[4, 5], [2, 1]]
+    assert DT[(f.A > 4) | (f.B > 2), :].to_list() == [[1, None, 5, 6],
+                                                     [5, 3, 1, 0]]
+    assert DT[(f.A < 0) & (f.B < 0), :].to_list() == [[], []]
+    assert DT[(f.A > 0) & ((f.B == 1) | (f.B == 2)), :].to_list() == \
+        [[4, 5], [2, 1]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_filter_logical_ops_random(seed):
+    random.seed(seed)
+    n = random.randint(1, 5000)
+    def randcol():
+        return [None if random.random() < 0.1 else random.randint(-5, 5)
+                for _ in range(n)]
+    DT = dt.Frame(A=randcol(), B=randcol(), C=randcol(),
+                  D=[random.choice([True, False, None]) for _ in range(n)])
+    if random.random() < 0.5:
+        DT = DT[::random.randint(1, 3), :]
+    exprs = [(f.A > 0) & (f.B < 2),
+             (f.A > 0) | (f.B < 2),
+             ((f.A > 0) & (f.C != 1)) | f.D,
+             (f.A + f.B > 0) & ((f.B < 2) | (f.C > 3)) & f.D,
+             (dt.mean(f.A) > -10) & (f.C > 0)]
+    try:
+        for expr in exprs:
+            dt.options.expr.chunk_size = 0
+            ref = DT[expr, :].to_list()
+            for chunk_size in [1, 7, 4096]:
+                dt.options.expr.chunk_size = chunk_size
+                RES = DT[expr, :]
+                RES.internal.check()
+                assert RES.to_list() == ref
+    finally:
+        del dt.options.expr.chunk_size
+
+
 def test_chained_slice0(dt0):
     dt1 = dt0[::2, :]
     dt1.internal.check()
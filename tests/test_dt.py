@@ -23,6 +23,7 @@
 #-------------------------------------------------------------------------------
 import datatable as dt
 import math
+import os
 import pytest
 import random
 import re
@@ -176,6 +177,58 @@ def test_internal():
         core.test_internal()
 
 
+def test_benchmark_internal():
+    from datatable.lib import core
+    if not hasattr(core, "benchmark_internal"):
+        pytest.skip("Internal benchmarks are not compiled in")
+    names = [name for name, _ in core.benchmark_internal()]
+    assert "sort" in names and "join" in names
+    for name in names:
+        stypes = ["int32", "int64"] if name == "join" else \
+                 ["bool", "int8", "float32", "str32", "str64"]
+        for st in stypes:
+            times = core.benchmark_internal(name, st, nrows=100, ncard=10,
+                                            nreps=2)
+            assert len(times) == 2
+            assert all(isinstance(t, float) and t >= 0 for t in times)
+    with pytest.raises(ValueError):
+        core.benchmark_internal("nonexistent", "int32", 10)
+    with pytest.raises(ValueError):
+        core.benchmark_internal("join", "str32", 10)
+
+
+def test_benchmark_driver(tempfile):
+    import json
+    sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..",
+                                    "benchmarks"))
+    try:
+        import bench
+    finally:
+        sys.path.pop(0)
+    try:
+        ret = bench.main(["--nrows", "50", "--nreps", "1", "--quiet",
+                          "--filter", r"\[int32\]", "--output", tempfile])
+        assert ret == 0
+    finally:
+        dt.options.sort.reset("cache_size")
+    with open(tempfile) as inp:
+        res = json.load(inp)
+    assert res["options"]["sort.cache_size"] == 0
+    names = {(r["suite"], r["name"]) for r in res["benchmarks"]}
+    if hasattr(bench.core, "benchmark_internal"):
+        assert ("core", "join") in names
+    assert ("io", "fread") in names
+    assert all(r["stype"] == "int32" and r["nrows"] == 50
+               for r in res["benchmarks"])
+    try:
+        ret = bench.main(["--nrows", "50", "--nreps", "1", "--quiet",
+                          "--suite", "sort", "--filter", r"\[int32\]",
+                          "--compare", tempfile, "--threshold", "1e6"])
+        assert ret == 0
+    finally:
+        dt.options.sort.reset("cache_size")
+
+
 def test_dt_view(dt0, patched_terminal, capsys):
     dt0.view(interactive=False)
     out, err = capsys.readouterr()
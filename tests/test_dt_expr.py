@@ -480,6 +480,60 @@ def test_equal_strings(st1, st2):
 
 
 
+#-------------------------------------------------------------------------------
+# Arithmetic and relational operators
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("seed", [random.getrandbits(63)])
+def test_binary_ops_all_stypes(seed):
+    # Columns and scalars of all numeric stype combinations, with NAs; both
+    # the column-at-a-time and the chunked evaluation are checked.
+    random.seed(seed)
+    n = random.randint(1, 1000)
+    stypes = ["int16", "int32", "int64", "float64"]
+    def value():
+        return None if random.random() < 0.1 else random.randint(-40, 40)
+    def div(x, y):
+        return None if x is None or y is None or y == 0 else x / y
+    def cmp(op):
+        # NA is equal to NA, and not equal to any other value
+        return lambda x, y: op(x, y) if x is not None and y is not None \
+                            else (x is None and y is None)
+    ops = [(lambda a, b: a + b,
+            lambda x, y: None if x is None or y is None else x + y),
+           (lambda a, b: a - b,
+            lambda x, y: None if x is None or y is None else x - y),
+           (lambda a, b: a * b,
+            lambda x, y: None if x is None or y is None else x * y),
+           (lambda a, b: a / b, div),
+           (lambda a, b: a == b, cmp(lambda x, y: x == y)),
+           (lambda a, b: a != b,
+            lambda x, y: (x is None) != (y is None) or
+                         (x is not None and y is not None and x != y)),
+           (lambda a, b: a < b,
+            lambda x, y: x is not None and y is not None and x < y),
+           (lambda a, b: a >= b, cmp(lambda x, y: x >= y))]
+    cols = {st: [value() for _ in range(n)] for st in stypes}
+    DT = dt.Frame([cols[st] for st in stypes], names=stypes, stypes=stypes)
+    scalar = random.randint(-5, 5) or 1
+    try:
+        for chunk_size in [0, 4096]:
+            dt.options.expr.chunk_size = chunk_size
+            for st1 in stypes:
+                for st2 in stypes:
+                    x, y = cols[st1], cols[st2]
+                    for op, ref in ops:
+                        RES = DT[:, [op(f[st1], f[st2]), op(f[st1], scalar),
+                                     op(scalar, f[st2])]]
+                        assert RES.to_list() == [
+                            [ref(x[i], y[i]) for i in range(n)],
+                            [ref(x[i], scalar) for i in range(n)],
+                            [ref(scalar, y[i]) for i in range(n)]]
+    finally:
+        del dt.options.expr.chunk_size
+
+
+
 #-------------------------------------------------------------------------------
 # Division
 #-------------------------------------------------------------------------------
@@ -506,6 +560,182 @@ def test_issue1562():
 
 
 
+#-------------------------------------------------------------------------------
+# Chunked (fused) evaluation
+#-------------------------------------------------------------------------------
+
+def eval_unfused(DT, expr):
+    # Evaluate `expr` with every subexpression materialized into a column
+    chunk_size = dt.options.expr.chunk_size
+    try:
+        dt.options.expr.chunk_size = 0
+        return DT[:, expr]
+    finally:
+        dt.options.expr.chunk_size = chunk_size
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(63)])
+def test_fused_expressions(seed):
+    random.seed(seed)
+    n = random.randint(1, 3000)
+    stypes = ["bool", "int8", "int16", "int32", "int64", "float32", "float64"]
+    def value(st):
+        if random.random() < 0.1:
+            return None
+        if st == "bool":
+            return random.random() < 0.5
+        if st.startswith("int"):
+            return random.randint(-100, 100)
+        return random.random() * 100 - 50
+
+    DT = dt.Frame([[value(st) for _ in range(n)] for st in stypes],
+                  names=stypes, stypes=stypes)
+    exprs = [(f.int32 * 2 + f.float64) / f.int8 > 0.5,
+             -f.int16 + dt.abs(f.int64) * f.float32,
+             (f.bool & (f.int8 > 3)) | ~f.bool,
+             f.int64 // f.int16 % 7 - f.int8,
+             dt.exp(f.float32 / 10) + dt.log(f.int32) * 2,
+             f.float64 - dt.mean(f.float64) * 2 + 1,
+             dt.isna(f.int16 + f.float32) == (f.int32 != f.int64)]
+    views = [DT, DT[::-3, :], DT[[random.randint(0, n - 1) for _ in range(n)], :]]
+    try:
+        for chunk_size in [1, 7, 1000, 4096]:
+            dt.options.expr.chunk_size = chunk_size
+            for DTv in views:
+                for expr in exprs:
+                    RES = DTv[:, expr]
+                    RES.internal.check()
+                    assert_equals(RES, eval_unfused(DTv, expr))
+    finally:
+        del dt.options.expr.chunk_size
+
+
+def test_fused_scalars():
+    DT = dt.Frame(A=[3, 5, 1, None, 2])
+    RES = DT[:, dt.mean(f.A) * 2 + 1]
+    RES.internal.check()
+    assert RES.to_list() == [[6.5]]
+    RES = DT[:, [f.A * (dt.max(f.A) - 1), +f.A]]
+    RES.internal.check()
+    assert RES.to_list() == [[12, 20, 4, None, 8], [3, 5, 1, None, 2]]
+    RES = DT[:, [dt.sum(f.A) + 1, dt.sum(f.A) - dt.count()], dt.by(f.A)]
+    assert RES.to_list() == [[None, 1, 2, 3, 5], [1, 2, 3, 4, 6],
+                             [-1, 0, 1, 2, 4]]
+
+
+def test_fused_join():
+    # Rows of X that have no match in J produce NAs
+    X = dt.Frame(A=[1, 2, 3, 4, None, 6], B=[1.5, 2, 3, 4, 5, 6])
+    J = dt.Frame(A=[1, 3, 6], C=[10, 30, 60])
+    J.key = "A"
+    expr = f.B * dt.g.C + 1
+    RES = X[:, expr, dt.join(J)]
+    assert RES.to_list() == [[16.0, None, 91.0, None, None, 361.0]]
+    dt.options.expr.chunk_size = 2
+    try:
+        assert X[:, expr, dt.join(J)].to_list() == RES.to_list()
+    finally:
+        del dt.options.expr.chunk_size
+
+
+def test_fused_mixed_with_strings():
+    DT = dt.Frame(A=range(10), S=list("abcabcabca"))
+    RES = DT[:, ((f.S == "a") | (f.A > 6)) & (f.A % 2 == 0)]
+    assert RES.stypes == (stype.bool8, )
+    assert RES.to_list() == [[True, False, False, False, False,
+                              False, True, False, True, False]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(63)])
+def test_fused_many_columns(seed):
+    # Independent expressions in a `j` list are evaluated concurrently
+    random.seed(seed)
+    n = random.randint(1, 20000)
+    DT = dt.Frame(A=[random.choice([None, 1, 2, -3, 7]) for _ in range(n)],
+                  B=[None if random.random() < 0.1 else random.random() * 10
+                     for _ in range(n)],
+                  C=[random.choice([True, False, None]) for _ in range(n)])
+    exprs = [f.A + f.B, dt.float64(f.A), dt.int32(f.B), dt.bool8(f.A),
+             dt.int8(f.C), f.A * 2 - f.B, f.A, -f.A, dt.float32(f.A + 1),
+             f.A > f.B, dt.int64(f.C), dt.sum(f.B) - f.A]
+    try:
+        for nthreads in [1, 4]:
+            dt.options.nthreads = nthreads
+            for chunk_size in [1, 100, 4096]:
+                dt.options.expr.chunk_size = chunk_size
+                for DTv in [DT, DT[::-3, :]]:
+                    RES = DTv[:, exprs]
+                    RES.internal.check()
+                    assert_equals(RES, eval_unfused(DTv, exprs))
+    finally:
+        del dt.options.nthreads
+        del dt.options.expr.chunk_size
+
+
+
+#-------------------------------------------------------------------------------
+# Common subexpressions
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("chunk_size", [0, 3, 4096])
+def test_cse_repeated_items(chunk_size):
+    DT = dt.Frame(A=[1, 2, 3, 4, None], S=list("abcab"))
+    e = f.A - dt.mean(f.A)
+    try:
+        dt.options.expr.chunk_size = chunk_size
+        RES = DT[:, [e, e * 2, e, dt.abs(e) + e, f.S.re_match("a|b"),
+                     f.S.re_match("a|b"), f.S.re_match("a")]]
+        RES.internal.check()
+        assert RES.to_list() == [[-1.5, -0.5, 0.5, 1.5, None],
+                                 [-3.0, -1.0, 1.0, 3.0, None],
+                                 [-1.5, -0.5, 0.5, 1.5, None],
+                                 [0.0, 0.0, 1.0, 3.0, None],
+                                 [True, True, False, True, True],
+                                 [True, True, False, True, True],
+                                 [True, False, False, True, False]]
+        RES = DT[f.A > 1, [e, e]]
+        assert RES.to_list() == [[-1.0, 0.0, 1.0]] * 2
+    finally:
+        del dt.options.expr.chunk_size
+
+
+def test_cse_similar_items():
+    # Expressions that differ only in a literal or a column are not merged
+    DT = dt.Frame(A=[1, 2, 3], B=[4, 5, 6])
+    RES = DT[:, [f.A + 1, f.A + 1.0, f.A + 2, f.A + True, f.B + 1, f[0] + 1,
+                 dt.float32(f.A), dt.float64(f.A), -f.A, ~f.A]]
+    assert RES.stypes == (stype.int8, stype.float64, stype.int8, stype.int8,
+                          stype.int8, stype.int8, stype.float32, stype.float64,
+                          stype.int8, stype.int8)
+    assert RES.to_list() == [[2, 3, 4], [2.0, 3.0, 4.0], [3, 4, 5], [2, 3, 4],
+                             [5, 6, 7], [2, 3, 4], [1.0, 2.0, 3.0],
+                             [1.0, 2.0, 3.0], [-1, -2, -3], [-2, -3, -4]]
+
+
+def test_reduce_cache():
+    DT = dt.Frame(A=[1, 2, 3, 4, None], B=[5.0, 1, 2, -1, 3])
+    try:
+        dt.options.expr.cache_size = 2
+        assert DT[:, [dt.mean(f.A), dt.sum(f.B)]].to_list() == [[2.5], [10.0]]
+        assert DT[:, dt.mean(f.A)].to_list() == [[2.5]]
+        DT[0, "A"] = 101
+        assert DT[:, dt.mean(f.A)].to_list() == [[27.5]]
+        DT[:, "A"] = 7
+        assert DT[:, dt.mean(f.A)].to_list() == [[7.0]]
+        DT.rbind(dt.Frame(A=[2], B=[0.0]))
+        assert DT[:, [dt.sum(f.A), dt.sum(f.B)]].to_list() == [[37], [10.0]]
+        assert DT[::2, dt.sum(f.A)].to_list() == [[21]]
+        assert DT[:, dt.sum(f.A), dt.by(f.B)].to_list() == \
+            [[-1.0, 0.0, 1.0, 2.0, 3.0, 5.0], [7, 2, 7, 7, 7, 7]]
+        DT2 = DT.copy()
+        DT2[f.A == 2, "A"] = 5
+        assert DT2[:, dt.sum(f.A)].to_list() == [[40]]
+        assert DT[:, dt.sum(f.A)].to_list() == [[37]]
+    finally:
+        del dt.options.expr.cache_size
+
+
+
 #-------------------------------------------------------------------------------
 # Misc
 #-------------------------------------------------------------------------------
@@ -13,15 +13,19 @@ def test_options_all():
     # Update this test every time a new option is added
     assert repr(dt.options).startswith("<datatable.options.DtConfig:")
     assert set(dir(dt.options)) == {
-        "nthreads", "core_logger", "sort", "display", "frame", "fread"}
+        "nthreads", "core_logger", "sort", "display", "frame", "fread",
+        "groupby", "join", "expr"}
     assert set(dir(dt.options.sort)) == {
         "insert_method_threshold", "thread_multiplier", "max_chunk_length",
-        "max_radix_bits", "over_radix_bits", "nthreads"}
+        "max_radix_bits", "over_radix_bits", "nthreads", "max_int32_rows",
+        "memory_budget", "cache_size", "packed_strings"}
     assert set(dir(dt.options.display)) == {
         "interactive", "interactive_hint"}
     assert set(dir(dt.options.frame)) == {
         "names_auto_index", "names_auto_prefix"}
     assert set(dir(dt.options.fread)) == {"anonymize"}
+    assert set(dir(dt.options.join)) == {"max_int32_rows"}
+    assert set(dir(dt.options.expr)) == {"chunk_size", "cache_size"}
 
 
 @pytest.mark.skip()
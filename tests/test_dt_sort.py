@@ -24,8 +24,9 @@ import math
 import os
 import pytest
 import random
+import sys
 import datatable as dt
-from datatable import stype, ltype, sort, by, f
+from datatable import stype, ltype, sort, by, f, count
 from math import inf, nan
 from tests import list_equals, random_string, assert_equals
 
@@ -806,6 +807,36 @@ def test_sort_random_multi(seed):
     assert d1.to_list() == sorted_data
 
 
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_packed_keys(seed):
+    # Sorting by several integer columns uses a single packed key
+    random.seed(seed)
+    n = random.randint(1, 5000)
+    data = [[random.choice([None, True, False]) for _ in range(n)],
+            [random.choice([None, -100, 0, 5, 127]) for _ in range(n)],
+            [random.choice([None, -3000, 7, 8, 32000]) for _ in range(n)],
+            [random.choice([None, -10**9, 0, 1, 10**9]) for _ in range(n)],
+            list(range(n))]
+    DT = dt.Frame(data, names=list("ABCDE"),
+                  stypes=[dt.bool8, dt.int8, dt.int16, dt.int32, dt.int32])
+    def key(i):
+        return tuple((x is not None, x) for x in (data[1][i], data[0][i],
+                                                  data[2][i], data[3][i]))
+    order = sorted(range(n), key=lambda i: (key(i), i))
+    RES = DT.sort("B", "A", "C", "D")
+    RES.internal.check()
+    assert RES.to_list() == [[col[i] for i in order] for col in data]
+    counts = {}
+    for i in range(n):
+        counts[key(i)] = counts.get(key(i), 0) + 1
+    RES = DT[:, count(), by(f.B, f.A, f.C, f.D)]
+    RES.internal.check()
+    assert RES[:, -1].to_list()[0] == [counts[k] for k in sorted(counts)]
+    order2 = sorted(range(n), key=lambda i: (key(i)[:2], i))
+    RES = DT.sort("B", "A")
+    assert RES.to_list() == [[col[i] for i in order2] for col in data]
+
+
 
 #-------------------------------------------------------------------------------
 # Sort in reverse order
@@ -865,6 +896,278 @@ def test_sort_strings_reverse_large():
 
 
 
+#-------------------------------------------------------------------------------
+# Sort already sorted data
+#-------------------------------------------------------------------------------
+
+def sorted_order(values, reverse=False):
+    """Row order produced by a stable sort, with NAs first."""
+    nas = [i for i, v in enumerate(values) if v is None]
+    rest = sorted((i for i, v in enumerate(values) if v is not None),
+                  key=lambda i: values[i], reverse=reverse)
+    return nas + rest
+
+
+def check_sort_and_group(values, stype=None):
+    DT = dt.Frame(A=values, B=range(len(values)))
+    if stype:
+        DT[:, "A"] = dt.Frame(values, stype=stype)
+    for reverse in [False, True]:
+        sortby = -f.A if reverse else f.A
+        RES = DT[:, :, sort(sortby)]
+        RES.internal.check()
+        assert RES.to_list()[1] == sorted_order(values, reverse)
+    groups = DT[:, count(), by(f.A)]
+    groups.internal.check()
+    uniques = sorted(set(v for v in values if v is not None))
+    if None in values:
+        uniques = [None] + uniques
+    assert groups.to_list() == [uniques, [values.count(v) for v in uniques]]
+    DT.internal.check()
+
+
+@pytest.mark.parametrize("st", [dt.int8, dt.int32, dt.int64, dt.float64])
+def test_sort_presorted_numeric(st):
+    n = 2000
+    values = [i // 17 - 50 for i in range(n)]
+    check_sort_and_group(values, st)
+    check_sort_and_group(values[::-1], st)
+    check_sort_and_group([None] * 5 + values, st)
+    check_sort_and_group(values + [None] * 5, st)
+    check_sort_and_group([None] * 5 + values[::-1], st)
+    check_sort_and_group(values[::-1] + [None] * 5, st)
+    check_sort_and_group([3] * n, st)
+    check_sort_and_group([None] * n, st)
+
+
+@pytest.mark.parametrize("st", [dt.str32, dt.str64])
+def test_sort_presorted_strings(st):
+    words = sorted(["", "a", "aa", "abcdefgh", "abcdefgz", "abcdefghij", "b",
+                    "ba", "zzz", "zzzz"])
+    values = [w for w in words for _ in range(150)]
+    check_sort_and_group(values, st)
+    check_sort_and_group(values[::-1], st)
+    check_sort_and_group([None] * 3 + values, st)
+    check_sort_and_group(values[::-1] + [None] * 3, st)
+
+
+def test_sort_presorted_bools():
+    check_sort_and_group([None] * 10 + [False] * 500 + [True] * 700)
+    check_sort_and_group([True] * 500 + [False] * 700 + [None] * 3)
+    check_sort_and_group([True] * 500 + [False] * 700 + [True] * 3)
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_nearly_sorted(seed):
+    random.seed(seed)
+    nruns = random.randint(2, 12)
+    values = []
+    for _ in range(nruns):
+        run = [random.choice([None, 1, 5, 17, 100, 1000, -33])
+               for _ in range(random.randint(1, 800))]
+        values += sorted(run, key=lambda v: (v is not None, v))
+    check_sort_and_group(values)
+    check_sort_and_group([v / 4 if v is not None else None for v in values])
+    check_sort_and_group([str(v) if v is not None else None
+                          for v in values])
+    # The first column is sorted, the rest are sorted within its groups
+    DT = dt.Frame(A=sorted(values, key=lambda v: (v is not None, v)),
+                  B=[random.randint(0, 5) for _ in values])
+    RES = DT[:, :, sort(f.A, f.B)]
+    RES.internal.check()
+    assert RES.to_list() == [list(x) for x in zip(*sorted(
+        zip(*DT.to_list()), key=lambda r: (r[0] is not None, r[0], r[1])))]
+
+
+def test_sort_sortedness_jay(tempfile):
+    n = 1000
+    DT = dt.Frame(A=range(n), B=range(n, 0, -1), C=[5] * n,
+                  D=[random.random() for _ in range(n)],
+                  E=[None, "a", "b", "b", "c"] * (n // 5))
+    DT.to_jay(tempfile)
+    DT1 = dt.open(tempfile)
+    DT1.internal.check()
+    for name in DT.names:
+        RES = DT1[:, name, sort(name)]
+        RES.internal.check()
+        assert_equals(RES, DT[:, name, sort(name)])
+    DT[:, :, sort(f.A)]
+    DT[:, :, sort(f.E)]
+    DT.to_jay(tempfile)
+    DT2 = dt.open(tempfile)
+    DT2.internal.check()
+    assert_equals(DT2[:, :, sort(f.E)], DT[:, :, sort(f.E)])
+
+
+def test_sort_sortedness_jay_stale(tempfile):
+    # The file claims that the column is sorted, but its data was modified
+    # afterwards: the claim must be verified instead of trusted
+    import struct
+    n = 1000
+    DT = dt.Frame(A=range(n), stype=dt.int32)
+    DT[:, :, sort(f.A)]
+    DT.to_jay(tempfile)
+    with open(tempfile, "r+b") as out:
+        out.seek(8 + 4 * 10)  # the data of column A follows the header
+        out.write(struct.pack("<i", -5))
+    DT1 = dt.open(tempfile)
+    values = DT1.to_list()[0]
+    assert values[10] == -5
+    RES = DT1[:, :, sort(f.A)]
+    RES.internal.check()
+    assert RES.to_list() == [sorted(values)]
+    assert DT1[:, :, sort(-f.A)].to_list() == [sorted(values, reverse=True)]
+
+
+
+
+#-------------------------------------------------------------------------------
+# Sort followed by a small row slice
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_topk_random(seed):
+    random.seed(seed)
+    n = random.randint(1000, 20000)
+    DT = dt.Frame(A=[random.choice([None, 1, 2, 3, 5, 8]) for _ in range(n)],
+                  B=[random.random() * 100 for _ in range(n)],
+                  C=[random.choice(["a", "bb", "bz", None, "ba", "c"])
+                     for _ in range(n)],
+                  D=list(range(n)))
+    DT.internal.check()
+    for sortby in [(f.B,), (-f.B,), (-f.A,), (f.A, f.B), (f.A, f.C, f.D),
+                   (f.C,), (-f.C,)]:
+        full = DT[:, :, sort(*sortby)]
+        for rows in [slice(10), slice(5, 40), slice(0, 1), slice(30, None, -1),
+                     slice(7, 50, 3)]:
+            RES = DT[rows, :, sort(*sortby)]
+            RES.internal.check()
+            assert_equals(RES, full[rows, :])
+
+
+def test_sort_topk_threads():
+    n = 100000
+    DT = dt.Frame(A=[(i * 7919) % 1000 for i in range(n)], B=list(range(n)))
+    nthreads = dt.options.nthreads
+    try:
+        dt.options.nthreads = 4
+        RES = DT[:20, :, sort(f.A)]
+    finally:
+        dt.options.nthreads = nthreads
+    assert RES.to_list() == [[0] * 20, list(range(0, 20000, 1000))]
+
+
+def test_sort_topk_ties():
+    DT = dt.Frame(A=[1] * 500 + [0] * 3, B=list(range(503)))
+    assert_equals(DT[:5, :, sort(f.A)],
+                  dt.Frame(A=[0, 0, 0, 1, 1], B=[500, 501, 502, 0, 1]))
+
+
+
+
+#-------------------------------------------------------------------------------
+# External sort
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_sort_external(seed):
+    random.seed(seed)
+    n = random.randint(3000, 10000)
+    DT = dt.Frame(A=[random.choice([None, True, False]) for _ in range(n)],
+                  B=[random.choice([None, -7, 0, 3, 12, 1000]) for _ in range(n)],
+                  C=[random.choice([None, nan, -0.0, 0.0, 1.5, -inf, 2e10])
+                     for _ in range(n)],
+                  D=[random.choice([None, "", "a", "abcdefgh", "abcdefgz",
+                                    "abcdefg", "abcdefg\0", "z"])
+                     for _ in range(n)],
+                  E=list(range(n)))
+    sortbys = [(f.A,), (-f.B,), (f.C,), (-f.C,), (f.D,), (-f.D,),
+               (f.A, f.D, f.B), (f.D, f.C)]
+    expected = [DT[:, :, sort(*sortby)] for sortby in sortbys]
+    grouped = DT[:, count(), by(f.D, f.B)]
+    budget = dt.options.sort.memory_budget
+    cache_size = dt.options.sort.cache_size
+    try:
+        dt.options.sort.memory_budget = 20000
+        dt.options.sort.cache_size = 0
+        for sortby, RES0 in zip(sortbys, expected):
+            RES = DT[:, :, sort(*sortby)]
+            RES.internal.check()
+            assert_equals(RES, RES0)
+        assert_equals(DT[:, count(), by(f.D, f.B)], grouped)
+    finally:
+        dt.options.sort.memory_budget = budget
+        dt.options.sort.cache_size = cache_size
+
+
+
+#-------------------------------------------------------------------------------
+# Sort cache
+#-------------------------------------------------------------------------------
+
+def test_sort_cache_reused():
+    DT = dt.Frame(A=[5, 3, 9, 3, None, 0] * 100, B=list(range(600)))
+    size0 = sys.getsizeof(DT)
+    RES1 = DT[:, :, sort(f.A)]
+    size1 = sys.getsizeof(DT)
+    assert size1 > size0
+    RES2 = DT[:, :, sort(f.A)]
+    assert sys.getsizeof(DT) == size1
+    assert_equals(RES1, RES2)
+    RES3 = DT[:, count(), by(f.A)]
+    RES3.internal.check()
+    assert RES3.to_list() == [[None, 0, 3, 5, 9], [100, 100, 200, 100, 100]]
+    assert sys.getsizeof(DT) > size1
+
+
+def test_sort_cache_invalidated():
+    DT = dt.Frame(A=[5, 3, 9, 3, None, 0], B=list(range(6)))
+    assert DT[:, :, sort(f.A)].to_list()[1] == [4, 5, 1, 3, 0, 2]
+    DT[0, "A"] = -1
+    assert DT[:, :, sort(f.A)].to_list()[1] == [4, 0, 5, 1, 3, 2]
+    DT.rbind(dt.Frame(A=[1], B=[6]))
+    assert DT[:, :, sort(f.A)].to_list()[1] == [4, 0, 5, 6, 1, 3, 2]
+    DT[f.A == 3, "A"] = 10
+    assert DT[:, :, sort(f.A)].to_list()[1] == [4, 0, 5, 6, 2, 1, 3]
+    assert DT[:, count(), by(f.A)].to_list() == [[None, -1, 0, 1, 9, 10],
+                                                 [1, 1, 1, 1, 1, 2]]
+    del DT[f.A == 10, :]
+    assert DT[:, :, sort(f.A)].to_list()[1] == [4, 0, 5, 6, 2]
+    assert dt.unique(DT[:, "A"]).to_list() == [[None, -1, 0, 1, 9]]
+    DT[:, "A"] = DT[:, -f.A]
+    assert DT[:, :, sort(f.A)].to_list()[1] == [4, 2, 6, 5, 0]
+    assert dt.unique(DT[:, "A"]).to_list() == [[None, -9, -1, 0, 1]]
+
+
+def test_sort_cache_disabled():
+    cache_size = dt.options.sort.cache_size
+    try:
+        dt.options.sort.cache_size = 0
+        DT = dt.Frame(A=[5, 3, 9, 3, None, 0] * 100)
+        RES = DT[:, :, sort(f.A)]
+        size0 = sys.getsizeof(DT)
+        assert RES.to_list() == [sorted(DT.to_list()[0],
+                                        key=lambda x: -inf if x is None else x)]
+        assert_equals(DT[:, :, sort(f.A)], RES)
+        assert sys.getsizeof(DT) == size0
+    finally:
+        dt.options.sort.cache_size = cache_size
+    assert_equals(DT[:, :, sort(f.A)], RES)
+    assert sys.getsizeof(DT) > size0
+
+
+def test_sort_cache_unique():
+    DT = dt.Frame(A=[5, 3, 9, 3, None, 0] * 10)
+    size0 = sys.getsizeof(DT)
+    assert dt.unique(DT).to_list() == [[None, 0, 3, 5, 9]]
+    assert sys.getsizeof(DT) > size0
+    assert dt.unique(DT).to_list() == [[None, 0, 3, 5, 9]]
+    assert DT[:, count(), by(f.A)].to_list() == [[None, 0, 3, 5, 9],
+                                                 [10, 10, 20, 10, 10]]
+
+
+
+
 #-------------------------------------------------------------------------------
 # Misc issues
 #-------------------------------------------------------------------------------
@@ -913,3 +1216,80 @@ def test_h2oai7014(tempfile):
     counts = counts[:, :, sort("count")]
     counts.materialize()
     assert counts.to_list() == [['t'], [1047]]
+
+
+
+
+#-------------------------------------------------------------------------------
+# Sort strings by packed prefixes
+#-------------------------------------------------------------------------------
+
+def long_prefix_strings(n):
+    # Strings with long common prefixes, that differ at various positions
+    # relative to the 7-character boundaries of the packed prefixes
+    prefixes = ["http://www.example.com/", "http://www.example.co",
+                "http://www.exam", "http://www", "http:/", ""]
+    res = []
+    for _ in range(n):
+        r = random.random()
+        if r < 0.05:
+            res.append(None)
+        else:
+            res.append(random.choice(prefixes) +
+                       random.choice(["", "a", "ab", "abcdefg", "abcdefgh",
+                                      "\x7F", "été", "z" * 15]) +
+                       random.choice(["", str(random.randint(0, 50))]))
+    return res
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(3)])
+@pytest.mark.parametrize("st", [dt.str32, dt.str64])
+def test_sort_strings_packed(seed, st):
+    random.seed(seed)
+    n = random.choice([10, 50, 1000, 20000])
+    src = long_prefix_strings(n)
+    DT = dt.Frame(A=src, B=list(range(n)), stypes={"A": st, "B": dt.int32})
+    cache_size = dt.options.sort.cache_size
+    try:
+        dt.options.sort.cache_size = 0
+        for sortby in [(f.A,), (-f.A,), (f.A, f.B), (-f.A, -f.B)]:
+            RES1 = DT[:, :, sort(*sortby)]
+            dt.options.sort.packed_strings = False
+            RES2 = DT[:, :, sort(*sortby)]
+            dt.options.sort.packed_strings = True
+            RES1.internal.check()
+            assert_equals(RES1, RES2)
+        nonas = sorted(s for s in src if s is not None)
+        nnas = n - len(nonas)
+        assert DT[:, "A", sort(f.A)].to_list()[0] == [None] * nnas + nonas
+        assert (DT[:, "A", sort(-f.A)].to_list()[0] ==
+                [None] * nnas + nonas[::-1])
+    finally:
+        dt.options.sort.cache_size = cache_size
+        dt.options.sort.packed_strings = True
+
+
+def test_sort_strings_packed_groupby():
+    random.seed(7)
+    src = long_prefix_strings(5000)
+    DT = dt.Frame(A=src)
+    RES = DT[:, count(), by(f.A)]
+    RES.internal.check()
+    counts = {}
+    for s in src:
+        counts[s] = counts.get(s, 0) + 1
+    keys = sorted(s for s in counts if s is not None)
+    if None in counts:
+        keys = [None] + keys
+    assert RES.to_list() == [keys, [counts[s] for s in keys]]
+    assert dt.unique(DT).to_list() == [keys]
+
+
+def test_sort_strings_packed_after_int():
+    # Packed string prefixes as the second sort column
+    DT = dt.Frame(A=[i % 3 for i in range(300)],
+                  B=["prefix-prefix-%d" % (i * 7 % 300) for i in range(300)])
+    RES = DT[:, :, sort(f.A, f.B)]
+    RES.internal.check()
+    expected = sorted(zip(DT.to_list()[0], DT.to_list()[1]))
+    assert RES.to_list() == [[a for a, _ in expected], [b for _, b in expected]]
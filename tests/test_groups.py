@@ -306,3 +306,118 @@ def test_groupby_with_sort():
                   C0=[2] * 6, stypes={"C0": dt.int32})
     assert_equals(R1, R0)
     assert_equals(R2, R0)
+
+
+
+#-------------------------------------------------------------------------------
+# Hash grouping
+#-------------------------------------------------------------------------------
+
+def test_groupby_method_option():
+    assert dt.options.groupby.method == "auto"
+    with pytest.raises(ValueError) as e:
+        dt.options.groupby.method = "random"
+    assert ("Invalid groupby.method parameter: `random`; should be one of "
+            "'auto', 'sort' or 'hash'" in str(e.value))
+    assert dt.options.groupby.method == "auto"
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_groupby_hash_vs_sort(seed):
+    random.seed(seed)
+    n = 10 + int(random.expovariate(0.0001))
+    DT = dt.Frame(A=[random.choice([None, -1, 3, 7]) for _ in range(n)],
+                  B=[random.choice([None, "x", "", "yy"]) for _ in range(n)],
+                  C=[random.choice([None, 0.5, -2.5, 1e10]) for _ in range(n)],
+                  D=[random.random() for _ in range(n)])
+    res = {}
+    try:
+        for method in ["sort", "hash"]:
+            dt.options.groupby.method = method
+            r1 = DT[:, [count(), sum(f.D), min(f.D)], by(f.A, f.B, f.C)]
+            r2 = DT[:, :, by(f.B)]
+            r3 = DT[:, max(f.D), by(-f.A)]
+            for r in [r1, r2, r3]:
+                r.internal.check()
+            res[method] = (r1.to_list(), r2.to_list(), r3.to_list())
+    finally:
+        del dt.options.groupby.method
+    assert res["hash"] == res["sort"]
+
+
+def test_groupby_hash_auto():
+    # Low-cardinality group column in a large frame: grouped via the hash
+    # table, which must produce the same result as sorting
+    n = 100000
+    src = [(i * 7) % 13 for i in range(n)]
+    DT = dt.Frame(A=src, B=range(n))
+    res = DT[:, [count(), min(f.B), max(f.B)], by(f.A)]
+    res.internal.check()
+    rows = [[i for i in range(n) if src[i] == a] for a in range(13)]
+    assert res.to_list() == [list(range(13)),
+                             [len(r) for r in rows],
+                             [r[0] for r in rows],
+                             [r[-1] for r in rows]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(3)])
+def test_groupby_hash_multithreaded(seed):
+    # Each thread groups its chunk of rows separately, and the partial
+    # results are merged afterwards
+    random.seed(seed)
+    n = 50000
+    src = [random.choice("abc") + str(random.randint(0, 30))
+           if random.random() > 0.01 else None for _ in range(n)]
+    DT = dt.Frame(A=src, B=range(n))
+    nthreads = dt.options.nthreads
+    try:
+        dt.options.nthreads = 4
+        dt.options.groupby.method = "hash"
+        res = DT[:, [count(), min(f.B)], by(f.A)]
+    finally:
+        dt.options.nthreads = nthreads
+        del dt.options.groupby.method
+    res.internal.check()
+    keys = sorted(set(src) - {None})
+    if None in src:
+        keys = [None] + keys
+    assert res.to_list() == [keys,
+                             [src.count(k) for k in keys],
+                             [src.index(k) for k in keys]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(3)])
+def test_groupby_64bit_offsets(seed):
+    # Lowering `sort.max_int32_rows` forces the use of 64-bit row indices and
+    # group offsets, which are otherwise only used for very large frames. The
+    # results must be the same as with the 32-bit ones.
+    random.seed(seed)
+    n = 5000
+    DT = dt.Frame(A=[random.randint(0, 20) for _ in range(n)],
+                  B=[random.choice(["a", "bc", "def", None]) for _ in range(n)],
+                  C=[random.random() * 100 for _ in range(n)])
+
+    def run():
+        return [
+            DT[:, [count(), sum(f.C), mean(f.C), min(f.A), max(f.C),
+                   dt.sd(f.C), dt.first(f.C)], by(f.A, f.B)],
+            DT[:2, :, by(f.B)],
+            DT[-1::-2, :, by(f.A)],
+            DT[:, :, sort(f.B, f.C)],
+            dt.unique(DT[:, ["A", "B"]]),
+            dt.Frame([DT[:, "A"].nunique1(), DT[:, "B"].nmodal1()]),
+        ]
+
+    expected = run()
+    max_int32_rows = dt.options.sort.max_int32_rows
+    method = dt.options.groupby.method
+    try:
+        dt.options.sort.max_int32_rows = 10
+        dt.options.groupby.method = "sort"
+        results = run()
+    finally:
+        dt.options.sort.max_int32_rows = max_int32_rows
+        dt.options.groupby.method = method
+    for res, exp in zip(results, expected):
+        res.internal.check()
+        assert res.to_list() == exp.to_list()
@@ -67,12 +67,333 @@ def test_join_missing_levels():
     assert res.to_list() == [[1, 2, 3], [True, False, None]]
 
 
-def test_join_error_nokey():
+def test_join_unkeyed():
+    d0 = dt.Frame(A=[1, 3, 2, 1, 1, 2, 0], B=list("abcdefg"))
+    d1 = dt.Frame(V=["three", "zero", "two", "one"], A=[3, 0, 2, 1])
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.names == ("A", "B", "V")
+    assert res.to_list() == [
+        [1, 3, 2, 1, 1, 2, 0],
+        ["a", "b", "c", "d", "e", "f", "g"],
+        ["one", "three", "two", "one", "one", "two", "zero"]]
+
+
+def test_join_unkeyed_duplicates():
+    # When the join frame has duplicate keys, the first match is used
+    d0 = dt.Frame(A=[5, 1, 2, None, 7])
+    d1 = dt.Frame(A=[2, 1, 2, 5, 1, None], V=range(6))
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.to_list() == [[5, 1, 2, None, 7], [3, 1, 0, 5, None]]
+
+
+def test_join_unkeyed_multi():
+    d0 = dt.Frame(A=[1, 2, 1, 2], B=["x", "x", "y", "z"], C=[0.5, 1, 2, 3])
+    d1 = dt.Frame(B=["y", "x", "x"], D=[True, False, None], A=[1, 1, 2])
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.names == ("A", "B", "C", "D")
+    assert res.to_list() == [[1, 2, 1, 2], ["x", "x", "y", "z"],
+                             [0.5, 1, 2, 3], [False, None, True, None]]
+
+
+def test_join_unkeyed_view():
+    d0 = dt.Frame(A=range(10))
+    d1 = dt.Frame(A=range(20), V=[i * 10 for i in range(20)])[::-2, :]
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.to_list() == [list(range(10)),
+                             [None, 10, None, 30, None, 50, None, 70, None, 90]]
+
+
+def test_join_error_no_common_columns():
     d0 = dt.Frame(A=[1, 2, 3])
-    d1 = dt.Frame(A=range(10))
+    d1 = dt.Frame(B=range(10))
     with pytest.raises(ValueError) as e:
         noop(d0[:, :, join(d1)])
-    assert "The join frame is not keyed" in str(e.value)
+    assert ("The join frame is not keyed, and has no columns in common with "
+            "the left Frame" in str(e.value))
+
+
+def test_join_empty_frames():
+    d0 = dt.Frame(A=[1, 2, 3])
+    d1 = dt.Frame(A=[], V=[], stypes=[dt.int32, dt.str32])
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.to_list() == [[1, 2, 3], [None, None, None]]
+    d1.key = "A"
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.to_list() == [[1, 2, 3], [None, None, None]]
+
+
+def test_join_inner():
+    d0 = dt.Frame(A=[1, 2, 3, 4, 5], B=list("abcde"))
+    d1 = dt.Frame(A=[2, 4, 6], V=[20, 40, 60])
+    d1.key = "A"
+    res = d0[:, :, join(d1, how="inner")]
+    res.internal.check()
+    assert res.names == ("A", "B", "V")
+    assert res.to_list() == [[2, 4], ["b", "d"], [20, 40]]
+
+
+def test_join_right():
+    d0 = dt.Frame(A=[1, 2, 3, 4, 5], B=list("abcde"))
+    d1 = dt.Frame(A=[2, 4, 6], V=[20, 40, 60])
+    d1.key = "A"
+    res = d0[:, :, join(d1, how="right")]
+    res.internal.check()
+    assert res.names == ("A", "B", "V")
+    assert res.to_list() == [[2, 4, 6], ["b", "d", None], [20, 40, 60]]
+
+
+def test_join_outer():
+    d0 = dt.Frame(A=[1, 2, 3, 4, 5], B=list("abcde"))
+    d1 = dt.Frame(A=[7, 4, 6, 2], V=[70, 40, 60, 20])
+    res = d0[:, :, join(d1, how="outer")]
+    res.internal.check()
+    assert res.names == ("A", "B", "V")
+    assert res.to_list() == [[1, 2, 3, 4, 5, 7, 6],
+                             ["a", "b", "c", "d", "e", None, None],
+                             [None, 20, None, 40, None, 70, 60]]
+
+
+def test_join_outer_coalesce_stypes():
+    d0 = dt.Frame(A=[1, 2], B=[True, False], stypes=[dt.int8, dt.bool8])
+    d1 = dt.Frame(A=[2, 1000], V=[0.5, 1.5], stypes=[dt.int32, dt.float64])
+    res = d0[:, :, join(d1, how="outer")]
+    res.internal.check()
+    assert res.stypes == (dt.int32, dt.bool8, dt.float64)
+    assert res.to_list() == [[1, 2, 1000], [True, False, None],
+                             [None, 0.5, 1.5]]
+
+
+def test_join_outer_coalesce_explicit_columns():
+    # The join column is coalesced no matter how it is selected in `j`
+    d0 = dt.Frame(A=[1, 2, 3, 4, 5], B=list("abcde"))
+    d1 = dt.Frame(A=[7, 4, 6, 2], V=[70, 40, 60, 20])
+    keys = [1, 2, 3, 4, 5, 7, 6]
+    vals = [None, 20, None, 40, None, 70, 60]
+    res = d0[:, ["A", "B"], join(d1, how="outer")]
+    res.internal.check()
+    assert res.to_list() == [keys, ["a", "b", "c", "d", "e", None, None]]
+    res = d0[:, [f.A, g.V], join(d1, how="outer")]
+    res.internal.check()
+    assert res.to_list() == [keys, vals]
+    res = d0[:, [f.A * 10, f.B], join(d1, how="outer")]
+    res.internal.check()
+    assert res.to_list() == [[k * 10 for k in keys],
+                             ["a", "b", "c", "d", "e", None, None]]
+    res = d0[:, dt.sum(f.A), join(d1, how="outer")]
+    assert res.to_list() == [[sum(keys)]]
+    res = d0[:, [f.A, g.V], join(d1, how="right")]
+    res.internal.check()
+    assert res.to_list() == [[2, 4, 7, 6], [20, 40, 70, 60]]
+
+
+def test_join_mult_all():
+    d0 = dt.Frame(A=[1, 2, 3, 2], B=[10, 20, 30, 40])
+    d1 = dt.Frame(A=[2, 5, 2, 1, 2], V=list("pqrst"))
+    res = d0[:, :, join(d1, mult="all")]
+    res.internal.check()
+    assert res.to_list() == [[1, 2, 2, 2, 3, 2, 2, 2],
+                             [10, 20, 20, 20, 30, 40, 40, 40],
+                             ["s", "p", "r", "t", None, "p", "r", "t"]]
+    res = d0[:, :, join(d1, how="inner", mult="all")]
+    res.internal.check()
+    assert res.to_list() == [[1, 2, 2, 2, 2, 2, 2],
+                             [10, 20, 20, 20, 40, 40, 40],
+                             ["s", "p", "r", "t", "p", "r", "t"]]
+    res = d0[:, :, join(d1, how="outer", mult="all")]
+    res.internal.check()
+    assert res.to_list()[0] == [1, 2, 2, 2, 3, 2, 2, 2, 5]
+    assert res.to_list()[2] == ["s", "p", "r", "t", None, "p", "r", "t", "q"]
+
+
+def test_join_mult_all_random():
+    n = 2000
+    keys = [random.randint(0, 300) for _ in range(n)]
+    jkeys = [random.randint(0, 300) for _ in range(n)]
+    d0 = dt.Frame(A=keys, X=range(n))
+    d1 = dt.Frame(A=jkeys, Y=range(n))
+    res = d0[:, :, join(d1, how="inner", mult="all")]
+    res.internal.check()
+    jmap = {}
+    for j, k in enumerate(jkeys):
+        jmap.setdefault(k, []).append(j)
+    expected = [(k, i, j) for i, k in enumerate(keys) for j in jmap.get(k, [])]
+    assert list(zip(*res.to_list())) == expected
+
+
+def test_join_multiple_inner():
+    d0 = dt.Frame(A=[1, 2, 3, 4], B=[1, 1, 2, 2])
+    d1 = dt.Frame(A=[1, 3, 4], V=["x", "y", "z"])
+    d2 = dt.Frame(B=[2, 3], W=[0.5, 0.7])
+    d1.key = "A"
+    d2.key = "B"
+    res = d0[:, :, join(d1, how="inner"), join(d2, how="inner")]
+    res.internal.check()
+    assert res.to_list() == [[3, 4], [2, 2], ["y", "z"], [0.5, 0.5]]
+
+
+def test_join_inner_with_filter():
+    d0 = dt.Frame(A=range(10))
+    d1 = dt.Frame(A=[1, 4, 7, 8], V=[10, 40, 70, 80])
+    d1.key = "A"
+    res = d0[f.A > 5, [f.A, g.V], join(d1, how="inner")]
+    res.internal.check()
+    assert res.to_list() == [[7, 8], [70, 80]]
+
+
+def test_join_params():
+    d1 = dt.Frame(A=[1])
+    jn = join(d1, how="outer", mult="all")
+    assert jn.how == "outer"
+    assert jn.mult == "all"
+    jn = join(d1)
+    assert jn.how == "left"
+    assert jn.mult == "first"
+    with pytest.raises(ValueError) as e:
+        join(d1, how="full")
+    assert "Parameter `how` in join() should be one of" in str(e.value)
+    with pytest.raises(ValueError) as e:
+        join(d1, mult="last")
+    assert "Parameter `mult` in join() should be either" in str(e.value)
+
+
+def test_join_update_error():
+    d0 = dt.Frame(A=[1, 2, 3])
+    d1 = dt.Frame(A=[1, 2], V=[3, 4])
+    with pytest.raises(ValueError) as e:
+        d0[:, "A", join(d1, how="inner")] = 0
+    assert ("Only a left join with mult='first' can be used when updating"
+            in str(e.value))
+
+
+def test_join_view_not_materialized():
+    n = 1000
+    src = dt.Frame(A=[i % 37 for i in range(n)],
+                   S=["s%d" % (i % 37) for i in range(n)], X=range(n))
+    jsrc = dt.Frame(A=range(50), S=["s%d" % i for i in range(50)],
+                    V=range(0, 100, 2))
+    x = src[::3, :]
+    jn = jsrc[[5, 1, 20, 3, 36, 40], :]
+    assert x.internal.isview and jn.internal.isview
+    res = x[:, :, join(jn)]
+    res.internal.check()
+    assert x.internal.isview and jn.internal.isview
+    vals = {a: 2 * a for a in [5, 1, 20, 3, 36, 40]}
+    assert res.to_list() == [x.to_list()[0], x.to_list()[1],
+                             x.to_list()[2],
+                             [vals.get(a) for a in x.to_list()[0]]]
+    xf = src[f.A < 10, :]
+    res = xf[:, :, join(jn, how="inner", mult="all")]
+    res.internal.check()
+    assert xf.internal.isview
+    assert res.to_list()[3] == [vals[a] for a in xf.to_list()[0]
+                                if a in vals]
+
+
+def test_join_asof_backward():
+    quotes = dt.Frame(T=[1, 5, 10, 20], Q=[100, 105, 110, 120])
+    quotes.key = "T"
+    trades = dt.Frame(T=[0, 1, 3, 10, 12, 25, None])
+    res = trades[:, :, join(quotes, asof="backward")]
+    res.internal.check()
+    assert res.to_list() == [[0, 1, 3, 10, 12, 25, None],
+                             [None, 100, 100, 110, 110, 120, None]]
+    res = trades[:, :, join(quotes, asof="backward", tolerance=2)]
+    assert res.to_list()[1] == [None, 100, 100, 110, 110, None, None]
+
+
+def test_join_asof_forward_nearest():
+    quotes = dt.Frame(T=[1, 5, 10, 20], Q=[100, 105, 110, 120])
+    quotes.key = "T"
+    trades = dt.Frame(T=[0, 3, 7, 8, 15, 25])
+    res = trades[:, :, join(quotes, asof="forward")]
+    assert res.to_list()[1] == [100, 105, 110, 110, 120, None]
+    res = trades[:, :, join(quotes, asof="nearest")]
+    assert res.to_list()[1] == [100, 100, 105, 110, 110, 120]
+    res = trades[:, :, join(quotes, asof="nearest", tolerance=1)]
+    assert res.to_list()[1] == [100, None, None, None, None, None]
+    res = trades[:, :, join(quotes, asof="forward", how="inner")]
+    res.internal.check()
+    assert res.to_list() == [[0, 3, 7, 8, 15], [100, 105, 110, 110, 120]]
+
+
+def test_join_asof_by_prefix():
+    quotes = dt.Frame(S=["a", "a", "b", "b", "b"], T=[1, 10, 2, 4, 8],
+                      Q=[1.0, 1.5, 2.0, 2.5, 3.0])
+    quotes.key = ["S", "T"]
+    trades = dt.Frame(S=["a", "b", "a", "c", "b", "b"],
+                      T=[5, 5, 0, 5, 100, 3.5])
+    res = trades[:, :, join(quotes, asof="backward")]
+    res.internal.check()
+    assert res.to_list()[2] == [1.0, 2.5, None, None, 3.0, 2.0]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_join_asof_random(seed):
+    random.seed(seed)
+    n = 3000
+    jkeys = sorted(random.sample(range(100000), 500))
+    xkeys = [random.randint(-100, 100100) for _ in range(n)]
+    if seed % 2:
+        xkeys.sort()
+    tol = random.choice([None, 50, 500])
+    quotes = dt.Frame(T=jkeys, J=range(len(jkeys)))
+    quotes.key = "T"
+    trades = dt.Frame(T=xkeys)
+    for asof in ["backward", "forward", "nearest"]:
+        res = trades[:, :, join(quotes, asof=asof, tolerance=tol)]
+        expected = []
+        for x in xkeys:
+            back = [i for i, k in enumerate(jkeys) if k <= x]
+            fwd = [i for i, k in enumerate(jkeys) if k >= x]
+            b = back[-1] if back else None
+            f_ = fwd[0] if fwd else None
+            if asof == "backward":
+                m = b
+            elif asof == "forward":
+                m = f_
+            elif b is None or f_ is None:
+                m = f_ if b is None else b
+            else:
+                m = b if x - jkeys[b] <= jkeys[f_] - x else f_
+            if m is not None and tol is not None and abs(jkeys[m] - x) > tol:
+                m = None
+            expected.append(m)
+        assert res.to_list()[1] == expected
+
+
+def test_join_asof_errors():
+    d0 = dt.Frame(A=[1, 2, 3])
+    d1 = dt.Frame(A=[1, 2], V=[3, 4])
+    with pytest.raises(ValueError) as e:
+        noop(d0[:, :, join(d1, asof="backward")])
+    assert "Asof join requires the join frame to be keyed" in str(e.value)
+    d1.key = "A"
+    with pytest.raises(ValueError) as e:
+        join(d1, asof="backwards")
+    assert "Parameter `asof` in join() should be one of" in str(e.value)
+    with pytest.raises(ValueError) as e:
+        join(d1, asof="forward", how="outer")
+    assert "Asof join can only be used with" in str(e.value)
+    with pytest.raises(ValueError) as e:
+        join(d1, tolerance=3)
+    assert "can only be used together with parameter `asof`" in str(e.value)
+    with pytest.raises(ValueError) as e:
+        join(d1, asof="nearest", tolerance=-1)
+    assert "cannot be negative" in str(e.value)
+    d2 = dt.Frame(A=["x", "y"])
+    d2.key = "A"
+    with pytest.raises(TypeError) as e:
+        noop(dt.Frame(A=["z"])[:, :, join(d2, asof="backward")])
+    assert "The last key column in an asof join must be numeric" in str(e.value)
+    jn = join(d1, asof="nearest", tolerance=3)
+    assert jn.asof == "nearest"
+    assert jn.tolerance == 3
 
 
 def test_join_error_no_left_column():
@@ -137,6 +458,147 @@ def test_join_random(seed, lt):
 
 
 
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_join_large_keyed(seed):
+    # Large keyed frame joined to an even larger frame: uses hash join
+    random.seed(seed)
+    nkeys = random.randint(2000, 10000)
+    ndata = nkeys * random.randint(5, 20)
+    st = random.choice([dt.int32, dt.int64, dt.float64, dt.str32])
+    keys = random.sample(range(-nkeys, 2 * nkeys), nkeys)
+    if st == dt.str32:
+        keys = [str(k) for k in keys]
+    dkey = dt.Frame(KEY=keys, VAL=range(nkeys), stypes={"KEY": st})
+    dkey.key = "KEY"
+    keys, vals = dkey.to_list()
+    lookup = dict(zip(keys, vals))
+    main = [random.choice(keys) for i in range(ndata)]
+    main[random.randint(0, ndata - 1)] = None
+    dmain = dt.Frame(KEY=main, stype=st)
+    djoined = dmain[:, :, join(dkey)]
+    djoined.internal.check()
+    assert djoined.to_list() == [main, [lookup.get(k) for k in main]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_join_unkeyed_random(seed):
+    random.seed(seed)
+    nkeys = int(random.expovariate(0.001)) + 1
+    ndata = int(random.expovariate(0.0005)) + 1
+    st = random.choice([dt.int8, dt.int16, dt.int32, dt.int64, dt.float32,
+                        dt.float64, dt.str32, dt.str64])
+    src = [random.randint(-100, 100) for _ in range(nkeys)] + [None]
+    if st in (dt.str32, dt.str64):
+        src = [None if x is None else str(x) for x in src]
+    dkey = dt.Frame(A=src, V=range(nkeys + 1), stypes={"A": st})
+    keys = dkey[:, "A"].to_list()[0]
+    first = {}
+    for i, k in enumerate(keys):
+        first.setdefault(k, i)
+    main = [random.choice(keys) for _ in range(ndata)]
+    dmain = dt.Frame(A=main, stype=st)
+    djoined = dmain[:, :, join(dkey)]
+    djoined.internal.check()
+    assert djoined.to_list() == [main, [first.get(k) for k in main]]
+
+
+
+def test_join_keyed_both():
+    # Both frames are keyed: merge join
+    d0 = dt.Frame(A=range(-5, 3000, 3), B=range(1002))
+    d0.key = "A"
+    d1 = dt.Frame(A=range(0, 3000, 2), V=range(1500))
+    d1.key = "A"
+    res = d0[:, :, join(d1)]
+    res.internal.check()
+    assert res.names == ("A", "B", "V")
+    assert res.to_list()[2] == [a // 2 if a % 2 == 0 and 0 <= a < 3000
+                                else None for a in range(-5, 3000, 3)]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_join_sorted(seed):
+    # The left frame is sorted (but not keyed): merge join
+    random.seed(seed)
+    nkeys = random.randint(1000, 5000)
+    ndata = random.randint(nkeys, 10 * nkeys)
+    xst, jst = random.choice([(dt.int32, dt.int32), (dt.int8, dt.int64),
+                              (dt.int64, dt.int16), (dt.float64, dt.int32),
+                              (dt.int32, dt.float64), (dt.str32, dt.str64)])
+    isstr = (xst == dt.str32)
+    if xst == dt.int8:
+        keys = list(range(-100, 100))
+        shifts = [0, 0, 0, 1, 20]
+    else:
+        keys = sorted(random.sample(range(-nkeys, 2 * nkeys), nkeys))
+        shifts = [0, 0, 0, 1, 50000]
+    main = sorted(random.choice(keys) + random.choice(shifts)
+                  for _ in range(ndata))
+    if xst == dt.float64:
+        main = [x + random.choice([0, 0, 0.5]) for x in main]
+    main = [None] * random.randint(0, 5) + main
+    if isstr:
+        keys = sorted(str(k) for k in keys)
+        main = [None if x is None else str(x) for x in main]
+        main = [None] * main.count(None) + sorted(x for x in main if x)
+    dkey = dt.Frame(KEY=keys, VAL=range(len(keys)), stypes={"KEY": jst})
+    dkey.key = "KEY"
+    lookup = dict(zip(*dkey.to_list()))
+    dmain = dt.Frame(KEY=main, stype=xst)
+    djoined = dmain[:, :, join(dkey)]
+    djoined.internal.check()
+    assert djoined.to_list()[1] == [lookup.get(k) for k in main]
+
+
+@pytest.mark.parametrize("how, max_int32_rows, ritype", [
+    ("inner", 10, "arr32"), ("inner", 9, "arr64"), ("inner", 3, "arr64"),
+    ("outer", 13, "arr32"), ("outer", 12, "arr64"), ("outer", 3, "arr64")])
+def test_join_many_to_many_64bit(how, max_int32_rows, ritype):
+    # Both frames have 6 rows, and the join produces 10 (inner) or 13 (outer)
+    # rows. With `join.max_int32_rows` between these numbers, the rows are
+    # matched with 32-bit indices but the result uses 64-bit rowindices;
+    # below 6 both steps use 64-bit indices.
+    from datatable.internal import frame_column_rowindex
+    X = dt.Frame(A=[1, 1, 2, 2, 3, 9], B=range(6))
+    J = dt.Frame(A=[1, 1, 1, 2, 2, 7], V=[10, 11, 12, 20, 21, 70])
+    A = [1, 1, 1, 1, 1, 1, 2, 2, 2, 2]
+    B = [0, 0, 0, 1, 1, 1, 2, 2, 3, 3]
+    V = [10, 11, 12, 10, 11, 12, 20, 21, 20, 21]
+    if how == "outer":
+        A += [3, 9, 7]
+        B += [4, 5, None]
+        V += [None, None, 70]
+    default = dt.options.join.max_int32_rows
+    try:
+        dt.options.join.max_int32_rows = max_int32_rows
+        res = X[:, :, join(J, how=how, mult="all")]
+    finally:
+        dt.options.join.max_int32_rows = default
+    res.internal.check()
+    assert res.names == ("A", "B", "V")
+    assert res.to_list() == [A, B, V]
+    assert frame_column_rowindex(res, 1).type == ritype
+    assert frame_column_rowindex(res, 2).type == ritype
+
+
+def test_join_no_matches_64bit():
+    # A left join without matches produces a 64-bit rowindex of NAs, which
+    # must still be compacted into a 32-bit one when applied to a view
+    from datatable.internal import frame_column_rowindex
+    X = dt.Frame(A=range(5))
+    J = dt.Frame(A=range(100, 120), V=range(20))[::2, :]
+    max_int32_rows = dt.options.join.max_int32_rows
+    try:
+        dt.options.join.max_int32_rows = 1
+        res = X[:, :, join(J)]
+    finally:
+        dt.options.join.max_int32_rows = max_int32_rows
+    res.internal.check()
+    assert frame_column_rowindex(res, 0) is None
+    assert frame_column_rowindex(res, 1).type == "arr32"
+    assert res.to_list() == [list(range(5)), [None] * 5]
+
+
 def test_join_update():
     d0 = dt.Frame([[1, 2, 3, 2, 3, 1, 3, 2, 2, 1], range(10)], names=("A", "B"))
     d1 = d0[:, mean(f.B), f.A]
@@ -22,6 +22,7 @@
 # IN THE SOFTWARE.
 #-------------------------------------------------------------------------------
 import datatable as dt
+from datatable import f
 import pytest
 import random
 
@@ -161,3 +162,69 @@ def test_key_after_group():
     tmp.key = "A"
     assert tmp.to_list()[0] == ["a", "b", "c", "d"]
     assert sum(tmp.to_list()[1]) == n
+
+
+def test_lookup():
+    d0 = dt.Frame(A=[5, 3, 9, 1], B=list("abcd"))
+    d0.key = "A"
+    assert d0.lookup(3) == 1
+    assert d0.lookup(9) == 3
+    assert d0.lookup(2) is None
+    assert d0.lookup(None) is None
+    assert d0.lookup(3.0) == 1
+    assert d0.lookup(3.5) is None
+
+
+def test_lookup_multi():
+    d0 = dt.Frame(A=[1, 1, 2, 2], B=["x", "y", "x", "y"], C=range(4))
+    d0.key = ["A", "B"]
+    assert d0.lookup((2, "x")) == 2
+    assert d0.lookup((1, "y")) == 1
+    assert d0.lookup((1, "z")) is None
+    with pytest.raises(TypeError) as e:
+        d0.lookup(1)
+    assert "should be a tuple of 2 values" in str(e.value)
+    with pytest.raises(ValueError) as e:
+        d0.lookup((1, "x", 3))
+    assert "should have 2 values, instead got 3" in str(e.value)
+
+
+def test_lookup_unkeyed():
+    d0 = dt.Frame(A=range(5))
+    with pytest.raises(ValueError) as e:
+        d0.lookup(1)
+    assert "Frame.lookup() can only be used on a keyed Frame" in str(e.value)
+
+
+def test_lookup_after_modification():
+    n = 5000
+    d0 = dt.Frame(A=range(n), B=range(n))
+    d0.key = "A"
+    assert d0.lookup(4000) == 4000
+    # Frame is modified: the cached index must not be used any more
+    d0[4000, "B"] = -1
+    d0.nrows = 3000
+    assert d0.lookup(4000) is None
+    assert d0.lookup(2999) == 2999
+    d0.rbind(dt.Frame(A=[10000], B=[0]))
+    assert d0.lookup(10000) == 3000
+    del d0[:10, :]
+    assert d0.lookup(10000) == 2990
+    assert d0.lookup(5) is None
+    assert d0.lookup(10) == 0
+
+
+def test_join_uses_cached_index():
+    n = 5000
+    d1 = dt.Frame(A=range(n), V=range(0, 2 * n, 2))
+    d1.key = "A"
+    d0 = dt.Frame(A=[random.randint(-10, n + 10) for _ in range(n)])
+    for _ in range(3):
+        res = d0[:, :, dt.join(d1)]
+        res.internal.check()
+        assert res.to_list()[1] == [2 * a if 0 <= a < n else None
+                                    for a in d0.to_list()[0]]
+    d1[:, "V"] = d1[:, f.V + 1]
+    res = d0[:, :, dt.join(d1)]
+    assert res.to_list()[1] == [2 * a + 1 if 0 <= a < n else None
+                                for a in d0.to_list()[0]]
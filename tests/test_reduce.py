@@ -24,6 +24,7 @@
 import datatable as dt
 import math
 import pytest
+import random
 from datatable import f, ltype, first, count
 
 
@@ -245,3 +246,154 @@ def test_minmax_empty(mm, st):
 def test_minmax_nas(mm, st):
     DT2 = dt.Frame(B=[None]*3, stype=st)
     assert DT2[:, mm(f.B)].to_list() == [[None]]
+
+
+
+
+#-------------------------------------------------------------------------------
+# Multiple reducers over the same column
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("st", [dt.bool8, dt.int8, dt.int16, dt.int32,
+                                dt.int64, dt.float32, dt.float64])
+@pytest.mark.parametrize("grouped", [False, True])
+def test_multiple_reducers_same_column(st, grouped):
+    # All reducers of the same column are computed in a single pass; the
+    # results must be the same as when each of them is computed separately
+    src = [1, 0, None, 1, 1, 0, None, 0, 1, 1, 1]
+    grp = [1, 2, 2, 3, 1, 2, 5, 4, 1, 1, 3]
+    DT = dt.Frame(A=src, G=grp, stypes={"A": st})
+    reducers = [dt.sum, dt.mean, dt.count, dt.sd, dt.min, dt.max]
+
+    def select(j):
+        return DT[:, j, dt.by(f.G)] if grouped else DT[:, j]
+
+    RES = select([r(f.A) for r in reducers] + [first(f.A)])
+    RES.internal.check()
+    k0 = int(grouped)
+    for i, r in enumerate(reducers):
+        R1 = select(r(f.A))
+        assert RES.stypes[i + k0] == R1.stypes[-1]
+        assert RES[:, i + k0].to_list() == R1[:, -1].to_list()
+
+
+def test_multiple_reducers_several_columns():
+    DT = dt.Frame(A=[3, 7, 1, None, 2], B=[0.5, 1.5, None, 2.5, -3.0],
+                  G=[1, 2, 1, 2, 2])
+    RES = DT[:, [dt.sum(f.A), dt.min(f.B), dt.max(f.A), dt.mean(f.B)],
+             dt.by(f.G)]
+    RES.internal.check()
+    assert RES.to_list() == [[1, 2], [4, 9], [0.5, -3.0], [3, 7],
+                             [0.5, 1 / 3]]
+
+
+@pytest.mark.parametrize("nth", [1, 4])
+def test_reducers_skewed_groups(nth):
+    # Group 0 is large enough to be split into several parts that are
+    # reduced in parallel, while the other groups are small
+    n = 300000
+    src = [(i * 7919) % 1000 - 500 for i in range(n)]
+    for i in range(0, n, 97):
+        src[i] = None
+    grp = [0 if i % 50 else i % 7 + 1 for i in range(n)]
+    DT = dt.Frame(A=src, G=grp)
+    reducers = [dt.sum, dt.mean, dt.count, dt.sd, dt.min, dt.max]
+    nthreads = dt.options.nthreads
+    try:
+        dt.options.nthreads = nth
+        for frame in [DT, DT[::-1, :]]:
+            # the reducers are computed both fused and individually
+            R1 = frame[:, [r(f.A) for r in reducers], dt.by(f.G)]
+            R1.internal.check()
+            for i, r in enumerate(reducers):
+                R2 = frame[:, r(f.A), dt.by(f.G)]
+                assert R2[:, 1].to_list() == R1[:, i + 1].to_list()
+            res = R1.to_list()
+            for g in range(8):
+                vals = [x for x, y in zip(DT[:, "A"].to_list()[0],
+                                          DT[:, "G"].to_list()[0])
+                        if y == g and x is not None]
+                m = sum(vals) / len(vals)
+                s = math.sqrt(sum((x - m)**2 for x in vals) / (len(vals) - 1))
+                assert res[1][g] == sum(vals)
+                assert res[2][g] == pytest.approx(m, rel=1e-12, abs=1e-12)
+                assert res[3][g] == len(vals)
+                assert res[4][g] == pytest.approx(s, rel=1e-12)
+                assert res[5][g] == min(vals)
+                assert res[6][g] == max(vals)
+    finally:
+        dt.options.nthreads = nthreads
+
+
+
+#-------------------------------------------------------------------------------
+# Vectorized reducers over contiguous data
+#-------------------------------------------------------------------------------
+
+def reducer_views(DT):
+    # The rows of the first two views are contiguous in memory, the others
+    # are not
+    n = DT.nrows
+    return [DT, DT[3:n - 2, :], DT[1::3, :], DT[::-1, :],
+            DT[[(i * 37) % n for i in range(n)], :]]
+
+
+@pytest.mark.parametrize("st", [dt.bool8, dt.int8, dt.int16, dt.int32,
+                                dt.int64, dt.float32, dt.float64])
+def test_reducers_contiguous(st):
+    # The length is not a multiple of the 8-element blocks, and NAs are
+    # placed at the block boundaries
+    n = 8 * 40 + 5
+    src = [(i * 13) % 7 - 3 for i in range(n)]
+    if st == dt.bool8:
+        src = [x % 2 for x in src]
+    for i in [0, 7, 8, 15, 16, 63, 64, n - 1]:
+        src[i] = None
+    DT = dt.Frame(A=src, stypes=[st])
+    for view in reducer_views(DT):
+        vals = [x for x in view.to_list()[0] if x is not None]
+        RES = view[:, [dt.sum(f.A), dt.count(f.A), dt.min(f.A),
+                       dt.max(f.A), dt.mean(f.A)]]
+        RES.internal.check()
+        assert RES.to_list()[:4] == [[sum(vals)], [len(vals)], [min(vals)],
+                                     [max(vals)]]
+        assert RES[0, 4] == pytest.approx(sum(vals) / len(vals), rel=1e-6)
+        for i, r in enumerate([dt.sum, dt.count, dt.min, dt.max, dt.mean]):
+            assert view[:, r(f.A)].to_list() == RES[:, i].to_list()
+
+
+@pytest.mark.parametrize("st", [dt.int32, dt.float32, dt.float64])
+def test_reducers_contiguous_all_na(st):
+    DT = dt.Frame(A=[None] * 21, stypes=[st])
+    for view in reducer_views(DT):
+        RES = view[:, [dt.sum(f.A), dt.count(f.A), dt.min(f.A),
+                       dt.max(f.A), dt.mean(f.A)]]
+        RES.internal.check()
+        assert RES.to_list() == [[0], [0], [None], [None], [None]]
+
+
+def test_count_contiguous_strings():
+    # For string columns the NA flags are stored in the offsets, which
+    # begin one element after the column's data pointer
+    src = [None, "a", "", "bcd", None, None, "e", "fg", "h", None, "ij"]
+    for st in [dt.str32, dt.str64]:
+        DT = dt.Frame(A=src * 3, stypes=[st])
+        for view in reducer_views(DT):
+            vals = [x for x in view.to_list()[0] if x is not None]
+            assert view[:, dt.count(f.A)].to_list() == [[len(vals)]]
+
+
+def test_float_sum_independent_of_other_reducers():
+    # A float sum is accumulated in several lanes, and must be computed in
+    # the same way whether or not other reducers of the column are present
+    random.seed(12345)
+    n = 100000
+    DT = dt.Frame(X=[random.random() * 1e7 for _ in range(n)])
+    DT[::97, "X"] = None
+    combos = [[dt.sum, dt.mean], [dt.mean, dt.sd], [dt.sum, dt.max],
+              [dt.sum, dt.mean, dt.sd, dt.min, dt.max, dt.count]]
+    for view in [DT, DT[5:, :]]:
+        for reducers in combos:
+            RES = view[:, [r(f.X) for r in reducers]]
+            for i, r in enumerate(reducers):
+                assert view[:, r(f.X)][0, 0] == RES[0, i]
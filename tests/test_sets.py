@@ -219,3 +219,74 @@ def test_setfns_random(seed):
     dtres = dtfun(dts)
     pyres = pyfun(srcs)
     assert dtres.to_list()[0] == pyres
+
+
+
+#-------------------------------------------------------------------------------
+# Multi-column frames
+#-------------------------------------------------------------------------------
+
+def test_unique_multicolumn():
+    DT = dt.Frame(A=[1, 2, 1, 2, 1, None], B=["a", "b", "a", "c", "b", None])
+    res = dt.unique(DT)
+    res.internal.check()
+    assert res.names == ("A", "B")
+    assert res.to_list() == [[None, 1, 1, 2, 2], [None, "a", "b", "b", "c"]]
+
+
+def test_union_multicolumn():
+    dt1 = dt.Frame(A=[1, 2, 3], B=[0.5, 1.5, 2.5])
+    dt2 = dt.Frame(C=[3, 1, 1], D=[2.5, 0.5, 7.0])
+    res = dt.union(dt1, dt2)
+    res.internal.check()
+    assert res.names == ("A", "B")
+    assert res.to_list() == [[1, 1, 2, 3], [0.5, 7.0, 1.5, 2.5]]
+    assert dt.intersect(dt1, dt2).to_list() == [[1, 3], [0.5, 2.5]]
+    assert dt.setdiff(dt1, dt2).to_list() == [[2], [1.5]]
+    assert dt.symdiff(dt1, dt2).to_list() == [[1, 2], [7.0, 1.5]]
+
+
+def test_setfns_different_ncols():
+    dt1 = dt.Frame(A=[1, 2, 3], B=[0, 0, 0])
+    dt2 = dt.Frame([5, 7])
+    with pytest.raises(ValueError) as e:
+        dt.union(dt1, dt2)
+    assert ("Frames passed to union() must have the same number of columns, "
+            "however the first frame has 2 columns, while another has 1"
+            in str(e.value))
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(10)])
+def test_setfns_multicolumn_random(seed):
+    random.seed(seed)
+    nsets = 2 + int(random.expovariate(0.5))
+    span = random.randint(2, 10)
+    srcs = []
+    for _ in range(nsets):
+        nrows = int(random.expovariate(0.01))
+        src = [(random.randint(1, span), random.choice("abc"))
+               for _ in range(nrows)]
+        srcs.append(src)
+    dtfun, pyfun = random.choice([(dt.union, union),
+                                  (dt.intersect, intersect),
+                                  (dt.setdiff, setdiff),
+                                  (dt.symdiff, symdiff)])
+    dts = [dt.Frame([[r[0] for r in src], [r[1] for r in src]],
+                    names=["A", "B"]) for src in srcs]
+    dtres = dtfun(dts)
+    dtres.internal.check()
+    pyres = pyfun(srcs)
+    assert dtres.to_list() == [[r[0] for r in pyres], [r[1] for r in pyres]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32) for _ in range(5)])
+def test_unique_low_cardinality(seed):
+    # With `nunique` stats computed, the hash-based algorithm is used for
+    # single-column frames too
+    random.seed(seed)
+    src = [random.randint(0, 20) for _ in range(1000)]
+    DT = dt.Frame(src)
+    assert DT.nunique1() == len(set(src))
+    res = dt.unique(DT)
+    res.internal.check()
+    assert res.to_list() == [sorted(set(src))]